@@ -0,0 +1,81 @@
+#include "AsyncReadback.hpp"
+
+AsyncReadback::AsyncReadback(int depth) : m_first(0), m_count(0), m_mapped(false) {
+    m_slots.resize(depth < 1 ? 1 : depth);
+    for (Slot& slot : m_slots) {
+        glGenBuffers(1, &slot.buffer);
+        slot.fence = 0;
+        slot.width = 0;
+        slot.height = 0;
+        slot.capacity = 0;
+    }
+}
+
+AsyncReadback::~AsyncReadback() {
+    if (m_mapped)
+        unmap();
+    for (Slot& slot : m_slots) {
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+        glDeleteBuffers(1, &slot.buffer);
+    }
+}
+
+bool AsyncReadback::request(int width, int height) {
+    if (m_count == (int)m_slots.size() || m_mapped || width <= 0 || height <= 0)
+        return false;
+    Slot& slot = m_slots[(m_first + m_count) % m_slots.size()];
+    size_t bytes = (size_t)width * height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (bytes > slot.capacity) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+        slot.capacity = bytes;
+    }
+    // With a pack buffer bound the last argument is an offset, the call returns immediately
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.width = width;
+    slot.height = height;
+    m_count++;
+    return true;
+}
+
+bool AsyncReadback::map(const unsigned char*& data, int& width, int& height) {
+    if (m_count == 0 || m_mapped)
+        return false;
+    Slot& slot = m_slots[m_first];
+    // Poll only, never wait on the render thread
+    GLenum status = glClientWaitSync(slot.fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        return false;
+    glDeleteSync(slot.fence);
+    slot.fence = 0;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    data = (const unsigned char*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)slot.width * slot.height * 4,
+                                                  GL_MAP_READ_BIT);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (data == nullptr) {
+        // Nothing to hand out, the slot is free again
+        m_first = (m_first + 1) % m_slots.size();
+        m_count--;
+        return false;
+    }
+    width = slot.width;
+    height = slot.height;
+    m_mapped = true;
+    return true;
+}
+
+void AsyncReadback::unmap() {
+    if (!m_mapped)
+        return;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_slots[m_first].buffer);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_first = (m_first + 1) % m_slots.size();
+    m_count--;
+    m_mapped = false;
+}
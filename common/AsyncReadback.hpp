@@ -0,0 +1,61 @@
+/*
+ * AsyncReadback.hpp
+ *
+ *  Reads the framebuffer back through pixel pack buffers. The copy runs on the GPU after the
+ *  frame's draw calls and is picked up a frame or two later, so reading never stalls the pipeline.
+ *
+ */
+#ifndef ASYNCREADBACK_HPP
+#define ASYNCREADBACK_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <glad/gl.h>
+
+//!  AsyncReadback.
+/*!
+ Ring of pixel pack buffers with a fence each. request() starts a glReadPixels into the next free
+ buffer, map() returns the oldest one whose fence has signalled. Pixels are BGRA, bottom row first.
+ */
+class AsyncReadback {
+public:
+    //! Constructor
+    /*! depth is the number of readbacks that can be in flight. Needs a current GL context. */
+    AsyncReadback(int depth = 3);
+    //! Destructor
+    /*! Deletes the buffers and any pending fences. */
+    ~AsyncReadback();
+
+    //! request
+    /*! Reads width x height pixels of the bound read framebuffer. Returns false if all buffers are still in flight. */
+    bool request(int width, int height);
+
+    //! map
+    /*! Maps the oldest finished readback without waiting for the GPU, unmap() must follow before the next request(). */
+    bool map(const unsigned char*& data, int& width, int& height);
+
+    //! unmap
+    /*! Releases the buffer returned by map() for reuse. */
+    void unmap();
+
+    //! getPending
+    /*! Number of readbacks in flight. */
+    int getPending() const { return m_count; }
+
+private:
+    struct Slot {
+        GLuint buffer;
+        GLsync fence;
+        int width;
+        int height;
+        size_t capacity;    //!< allocated bytes
+    };
+
+    std::vector<Slot> m_slots;
+    int m_first;        //!< oldest readback in flight
+    int m_count;        //!< readbacks in flight
+    bool m_mapped;
+};
+
+#endif
@@ -0,0 +1,173 @@
+#include "BC1Encoder.hpp"
+#include <algorithm>
+#include <string.h>
+
+// Pack an 8-bit RGB colour to 5:6:5 with rounding
+static inline unsigned short packRGB565(int r, int g, int b) {
+    return (unsigned short)(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+// Expand 5:6:5 back to 8 bits per channel the way the hardware does
+static inline void unpackRGB565(unsigned short c, int rgb[3]) {
+    int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+/*
+ * Encode one 4x4 block given as 16 RGB texels (planar, one array per channel).
+ * Endpoints come from the inset bounding box of the block, with the box diagonal
+ * flipped per channel to follow the sign of its covariance with the luma-dominant
+ * green channel. Indices are found by projecting each texel on the endpoint axis.
+ * All loops run over a fixed 16 texels without branches so the compiler can
+ * vectorise them.
+ */
+static void encodeBlock(const int r[16], const int g[16], const int b[16], unsigned char* out) {
+    int minC[3] = { 255, 255, 255 }, maxC[3] = { 0, 0, 0 };
+    int meanC[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++) {
+        minC[0] = std::min(minC[0], r[i]); maxC[0] = std::max(maxC[0], r[i]); meanC[0] += r[i];
+        minC[1] = std::min(minC[1], g[i]); maxC[1] = std::max(maxC[1], g[i]); meanC[1] += g[i];
+        minC[2] = std::min(minC[2], b[i]); maxC[2] = std::max(maxC[2], b[i]); meanC[2] += b[i];
+    }
+    meanC[0] >>= 4; meanC[1] >>= 4; meanC[2] >>= 4;
+
+    // Covariance of red and blue against green decides the diagonal of the box
+    int covRG = 0, covBG = 0;
+    for (int i = 0; i < 16; i++) {
+        int dg = g[i] - meanC[1];
+        covRG += (r[i] - meanC[0]) * dg;
+        covBG += (b[i] - meanC[2]) * dg;
+    }
+    if (covRG < 0) std::swap(minC[0], maxC[0]);
+    if (covBG < 0) std::swap(minC[2], maxC[2]);
+
+    // Inset the box by 1/16 of its extent to reduce the error of the interpolated colours
+    for (int c = 0; c < 3; c++) {
+        int inset = (maxC[c] - minC[c]) / 16;
+        maxC[c] -= inset;
+        minC[c] += inset;
+    }
+
+    unsigned short c0 = packRGB565(maxC[0], maxC[1], maxC[2]);
+    unsigned short c1 = packRGB565(minC[0], minC[1], minC[2]);
+    unsigned int indices = 0;
+
+    if (c0 != c1) {
+        // c0 > c1 selects the four colour mode
+        if (c0 < c1) std::swap(c0, c1);
+
+        int e0[3], e1[3];
+        unpackRGB565(c0, e0);
+        unpackRGB565(c1, e1);
+        int axis[3] = { e0[0] - e1[0], e0[1] - e1[1], e0[2] - e1[2] };
+        int lengthSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+        // Position along c1 -> c0 in thirds, 0..3, mapped to palette order {c0, c1, 2/3 c0, 1/3 c0}
+        static const unsigned int remap[4] = { 1, 3, 2, 0 };
+        for (int i = 0; i < 16; i++) {
+            int dot = (r[i] - e1[0]) * axis[0] + (g[i] - e1[1]) * axis[1] + (b[i] - e1[2]) * axis[2];
+            int t = lengthSq > 0 ? (dot * 6 + lengthSq) / (2 * lengthSq) : 0;
+            t = std::max(0, std::min(3, t));
+            indices |= remap[t] << (2 * i);
+        }
+    }
+
+    out[0] = (unsigned char)(c0 & 0xFF);
+    out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xFF);
+    out[3] = (unsigned char)(c1 >> 8);
+    out[4] = (unsigned char)(indices & 0xFF);
+    out[5] = (unsigned char)((indices >> 8) & 0xFF);
+    out[6] = (unsigned char)((indices >> 16) & 0xFF);
+    out[7] = (unsigned char)(indices >> 24);
+}
+
+/**
+ * Encodes a range of block rows. Each block row is independent, so the rows are
+ * split across threads by cv::parallel_for_.
+ */
+class BC1RowEncoder : public cv::ParallelLoopBody {
+public:
+    BC1RowEncoder(const cv::Mat& input, unsigned char* output)
+        : m_input(input), m_output(output) {}
+
+    void operator()(const cv::Range& range) const override {
+        const int channels = m_input.channels();
+        const int blocksX = (m_input.cols + 3) / 4;
+        int r[16], g[16], b[16];
+
+        for (int by = range.start; by < range.end; by++) {
+            unsigned char* out = m_output + (size_t)by * blocksX * 8;
+            for (int bx = 0; bx < blocksX; bx++, out += 8) {
+                // Gather the block, clamping at the right and bottom edges
+                for (int y = 0; y < 4; y++) {
+                    const uchar* row = m_input.ptr<uchar>(std::min(by * 4 + y, m_input.rows - 1));
+                    for (int x = 0; x < 4; x++) {
+                        const uchar* px = row + std::min(bx * 4 + x, m_input.cols - 1) * channels;
+                        b[y * 4 + x] = px[0];
+                        g[y * 4 + x] = px[1];
+                        r[y * 4 + x] = px[2];
+                    }
+                }
+                encodeBlock(r, g, b, out);
+            }
+        }
+    }
+
+private:
+    const cv::Mat& m_input;
+    unsigned char* m_output;
+};
+
+size_t BC1Encoder::compressedSize(int width, int height) {
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * 8;
+}
+
+void BC1Encoder::encode(const cv::Mat& input, std::vector<unsigned char>& output) {
+    if (input.empty() || input.depth() != CV_8U || input.channels() < 3) {
+        output.clear();
+        return;
+    }
+    output.resize(compressedSize(input.cols, input.rows));
+    cv::parallel_for_(cv::Range(0, (input.rows + 3) / 4), BC1RowEncoder(input, output.data()));
+}
+
+void BC1Encoder::decode(const std::vector<unsigned char>& input, int width, int height, cv::Mat& output) {
+    output.create(height, width, CV_8UC3);
+    if (input.size() < compressedSize(width, height))
+        return;
+
+    const int blocksX = (width + 3) / 4;
+    const int blocksY = (height + 3) / 4;
+    for (int by = 0; by < blocksY; by++) {
+        for (int bx = 0; bx < blocksX; bx++) {
+            const unsigned char* block = input.data() + ((size_t)by * blocksX + bx) * 8;
+            unsigned short c0 = (unsigned short)(block[0] | block[1] << 8);
+            unsigned short c1 = (unsigned short)(block[2] | block[3] << 8);
+            unsigned int indices = block[4] | block[5] << 8 | block[6] << 16 | (unsigned int)block[7] << 24;
+
+            int palette[4][3];
+            unpackRGB565(c0, palette[0]);
+            unpackRGB565(c1, palette[1]);
+            for (int c = 0; c < 3; c++) {
+                if (c0 > c1) {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                } else {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+
+            for (int y = 0; y < 4 && by * 4 + y < height; y++) {
+                for (int x = 0; x < 4 && bx * 4 + x < width; x++) {
+                    const int* rgb = palette[(indices >> (2 * (y * 4 + x))) & 3];
+                    output.at<cv::Vec3b>(by * 4 + y, bx * 4 + x) = cv::Vec3b(
+                        (uchar)rgb[2], (uchar)rgb[1], (uchar)rgb[0]);
+                }
+            }
+        }
+    }
+}
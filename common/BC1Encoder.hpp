@@ -0,0 +1,40 @@
+#ifndef BC1ENCODER_HPP
+#define BC1ENCODER_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * BC1Encoder class - Real-time BC1 (DXT1) compression of video frames on the CPU.
+ * Each 4x4 block is encoded to 8 bytes (6:1 against 24-bit BGR), so frames can be
+ * uploaded with glCompressedTexSubImage2D as GL_COMPRESSED_RGBA_S3TC_DXT1_EXT.
+ */
+class BC1Encoder {
+public:
+    /**
+     * Size in bytes of the BC1 data for an image
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @return Number of bytes (8 per 4x4 block)
+     */
+    static size_t compressedSize(int width, int height);
+
+    /**
+     * Compress an image to BC1. Block rows are encoded in parallel.
+     * Rows are written in image order, i.e. the first block row covers image row 0.
+     * @param input Input image (CV_8UC3 BGR or CV_8UC4 BGRA), any size
+     * @param output Compressed blocks, resized to compressedSize()
+     */
+    static void encode(const cv::Mat& input, std::vector<unsigned char>& output);
+
+    /**
+     * Decompress BC1 blocks, used to measure encode quality (PSNR)
+     * @param input Compressed blocks as produced by encode()
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param output Decoded CV_8UC3 BGR image
+     */
+    static void decode(const std::vector<unsigned char>& input, int width, int height, cv::Mat& output);
+};
+
+#endif // BC1ENCODER_HPP
@@ -0,0 +1,153 @@
+#include "BackendSelector.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <sstream>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+BackendSelector::BackendSelector(double smoothing, double hysteresis, int probeInterval, int probeLength)
+    : m_smoothing(smoothing), m_hysteresis(hysteresis),
+      m_probeInterval(probeInterval), m_probeLength(probeLength < 2 ? 2 : probeLength) {
+}
+
+BackendSelector::Workload& BackendSelector::get(const std::string& workload) {
+    std::map<std::string, Workload>::iterator it = m_workloads.find(workload);
+    if (it != m_workloads.end())
+        return it->second;
+    Workload& entry = m_workloads[workload];
+    entry.estimate[GPU] = entry.estimate[CPU] = -1.0;
+    entry.samples[GPU] = entry.samples[CPU] = 0;
+    entry.active = GPU;
+    entry.framesSinceProbe = 0;
+    entry.probeFrames = 0;
+    entry.lastReported = GPU;
+    return entry;
+}
+
+BackendSelector::Backend BackendSelector::choose(const std::string& workload) {
+    Workload& entry = get(workload);
+    Backend other = entry.active == GPU ? CPU : GPU;
+
+    // Measure both backends before trusting either estimate
+    if (entry.samples[entry.active] < m_probeLength)
+        return entry.active;
+    if (entry.samples[other] < m_probeLength)
+        return other;
+
+    if (entry.probeFrames > 0) {
+        entry.probeFrames--;
+        return other;
+    }
+    if (++entry.framesSinceProbe >= m_probeInterval) {
+        entry.framesSinceProbe = 0;
+        entry.probeFrames = m_probeLength - 1;
+        return other;
+    }
+    return entry.active;
+}
+
+void BackendSelector::report(const std::string& workload, Backend backend, double milliseconds) {
+    Workload& entry = get(workload);
+    // Reports arrive in frame order, so a change of backend here is the frame that paid for the switch
+    if (backend != entry.lastReported) {
+        entry.lastReported = backend;
+        return;
+    }
+
+    if (entry.samples[backend] == 0)
+        entry.estimate[backend] = milliseconds;
+    else
+        entry.estimate[backend] += m_smoothing * (milliseconds - entry.estimate[backend]);
+    entry.samples[backend]++;
+
+    Backend other = entry.active == GPU ? CPU : GPU;
+    if (entry.samples[GPU] < m_probeLength || entry.samples[CPU] < m_probeLength)
+        return;
+    if (entry.estimate[other] < entry.estimate[entry.active] * (1.0 - m_hysteresis)) {
+        printf("BackendSelector: %s switches to %s (%.2f ms vs %.2f ms)\n", workload.c_str(),
+               other == GPU ? "GPU" : "CPU", entry.estimate[other], entry.estimate[entry.active]);
+        entry.active = other;
+        entry.framesSinceProbe = 0;
+        entry.probeFrames = 0;
+    }
+}
+
+BackendSelector::Backend BackendSelector::getActive(const std::string& workload) const {
+    std::map<std::string, Workload>::const_iterator it = m_workloads.find(workload);
+    return it != m_workloads.end() ? it->second.active : GPU;
+}
+
+double BackendSelector::getEstimate(const std::string& workload, Backend backend) const {
+    std::map<std::string, Workload>::const_iterator it = m_workloads.find(workload);
+    return it != m_workloads.end() ? it->second.estimate[backend] : -1.0;
+}
+
+bool BackendSelector::load(const std::string& filename) {
+    std::ifstream file(filename.c_str());
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+    int loaded = 0;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        std::string workload, active;
+        double gpuMs, cpuMs;
+        int gpuSamples, cpuSamples;
+        if (!(fields >> workload >> gpuMs >> cpuMs >> gpuSamples >> cpuSamples >> active)) {
+            fprintf(stderr, "BackendSelector: skipping malformed line in %s\n", filename.c_str());
+            continue;
+        }
+        if (m_workloads.find(workload) != m_workloads.end())
+            continue;
+        Workload& entry = get(workload);
+        entry.estimate[GPU] = gpuMs;
+        entry.estimate[CPU] = cpuMs;
+        entry.samples[GPU] = gpuSamples;
+        entry.samples[CPU] = cpuSamples;
+        entry.active = active == "CPU" ? CPU : GPU;
+        entry.lastReported = entry.active;
+        loaded++;
+    }
+    printf("BackendSelector: %d workloads loaded from %s\n", loaded, filename.c_str());
+    return true;
+}
+
+bool BackendSelector::save(const std::string& filename) const {
+    if (m_workloads.empty())
+        return true;    // nothing measured, leave any existing profile alone
+    std::ofstream file(filename.c_str());
+    if (!file.is_open()) {
+        fprintf(stderr, "BackendSelector: cannot write %s\n", filename.c_str());
+        return false;
+    }
+    file << "# workload gpu_ms cpu_ms gpu_samples cpu_samples active\n";
+    for (std::map<std::string, Workload>::const_iterator it = m_workloads.begin(); it != m_workloads.end(); ++it) {
+        const Workload& entry = it->second;
+        file << it->first << " " << entry.estimate[GPU] << " " << entry.estimate[CPU] << " "
+             << entry.samples[GPU] << " " << entry.samples[CPU] << " "
+             << (entry.active == GPU ? "GPU" : "CPU") << "\n";
+    }
+    return file.good();
+}
+
+std::string BackendSelector::hostProfilePath() {
+    std::string host;
+#ifdef _WIN32
+    const char* name = getenv("COMPUTERNAME");
+    if (name != NULL)
+        host = name;
+#else
+    char name[256] = {0};
+    if (gethostname(name, sizeof(name) - 1) == 0)
+        host = name;
+#endif
+    if (host.empty())
+        host = "default";
+    return "backend_profile_" + host + ".txt";
+}
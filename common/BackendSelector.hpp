@@ -0,0 +1,92 @@
+#ifndef BACKENDSELECTOR_HPP
+#define BACKENDSELECTOR_HPP
+
+#include <string>
+#include <map>
+
+/**
+ * BackendSelector - Picks CPU or GPU processing per workload from live frame timings.
+ *
+ * Every workload (e.g. filter chain, resolution and renderer) keeps an exponentially
+ * weighted moving average of the frame cost on each backend. Both backends are measured
+ * first, after that a few probe frames run on the other backend at a fixed interval so the
+ * estimate follows load changes. The active backend only changes when the other one is
+ * faster by more than the hysteresis margin, which stops flapping between two close
+ * estimates. Estimates can be saved and loaded so the next start begins on the right path.
+ */
+class BackendSelector {
+public:
+    enum Backend { GPU = 0, CPU = 1 };
+
+    /**
+     * Create a selector
+     * @param smoothing EWMA weight of a new sample (0-1)
+     * @param hysteresis Relative margin the other backend has to win by before switching
+     * @param probeInterval Frames between probes of the inactive backend
+     * @param probeLength Consecutive frames per probe (the first one after a switch is discarded)
+     */
+    BackendSelector(double smoothing = 0.1, double hysteresis = 0.15,
+                    int probeInterval = 240, int probeLength = 6);
+
+    /**
+     * Backend to run this frame for a workload
+     * @param workload Workload key without whitespace
+     * @return The active backend, or the other one while probing
+     */
+    Backend choose(const std::string& workload);
+
+    /**
+     * Report the measured cost of a frame
+     * @param workload Workload key passed to choose()
+     * @param backend Backend that processed the frame
+     * @param milliseconds Frame cost, e.g. CPU submit time plus GPU time
+     */
+    void report(const std::string& workload, Backend backend, double milliseconds);
+
+    /**
+     * Active backend of a workload (GPU for unknown workloads)
+     */
+    Backend getActive(const std::string& workload) const;
+
+    /**
+     * Current estimate of a backend, negative if not measured yet
+     */
+    double getEstimate(const std::string& workload, Backend backend) const;
+
+    /**
+     * Load estimates saved by save(); workloads already measured in this run are kept
+     * @return False if the file could not be read
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * Save all estimates and active backends
+     * @return False if the file could not be written
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * Profile file for this machine in the working directory, named after the host
+     */
+    static std::string hostProfilePath();
+
+private:
+    struct Workload {
+        double estimate[2];     //!< EWMA in ms, negative until measured
+        int samples[2];
+        Backend active;
+        int framesSinceProbe;
+        int probeFrames;        //!< remaining probe frames, 0 if not probing
+        Backend lastReported;   //!< the first frame after a backend change carries switching costs
+    };
+
+    Workload& get(const std::string& workload);
+
+    double m_smoothing;
+    double m_hysteresis;
+    int m_probeInterval;
+    int m_probeLength;
+    std::map<std::string, Workload> m_workloads;
+};
+
+#endif // BACKENDSELECTOR_HPP
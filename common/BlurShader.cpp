@@ -0,0 +1,61 @@
+#include "BlurShader.hpp"
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+BlurShader::BlurShader(std::string vertexShaderName, std::string fragmentShaderName)
+    : TextureShader(vertexShaderName, fragmentShaderName), tapCount(1) {
+    texelStepLocation = glGetUniformLocation(programID, "texelStep");
+    tapCountLocation = glGetUniformLocation(programID, "tapCount");
+    tapOffsetsLocation = glGetUniformLocation(programID, "tapOffsets");
+    tapWeightsLocation = glGetUniformLocation(programID, "tapWeights");
+
+    if (tapWeightsLocation == -1) {
+        printf("Warning: Could not find 'tapWeights' uniform in blur shader\n");
+    }
+    texelStep[0] = texelStep[1] = 0.0f;
+    for (int i = 0; i < MAX_TAPS; i++)
+        tapOffsets[i] = tapWeights[i] = 0.0f;
+    tapWeights[0] = 1.0f;
+}
+
+void BlurShader::setSigma(float sigma) {
+    // Discrete kernel out to 3 sigma, pairs of texels (2i-1, 2i) become one linear fetch
+    int radius = (int)ceilf(3.0f * sigma);
+    if (radius > 2 * (MAX_TAPS - 1))
+        radius = 2 * (MAX_TAPS - 1);
+    if (sigma <= 0.0f || radius < 1) {
+        tapCount = 1;
+        tapOffsets[0] = 0.0f;
+        tapWeights[0] = 1.0f;
+        return;
+    }
+    std::vector<float> weights(radius + 2, 0.0f);
+    float total = 0.0f;
+    for (int i = 0; i <= radius; i++) {
+        weights[i] = expf(-(float)(i * i) / (2.0f * sigma * sigma));
+        total += i == 0 ? weights[i] : 2.0f * weights[i];
+    }
+    tapOffsets[0] = 0.0f;
+    tapWeights[0] = weights[0] / total;
+    tapCount = 1;
+    for (int i = 1; i <= radius; i += 2) {
+        float w = weights[i] + weights[i + 1];
+        tapOffsets[tapCount] = (i * weights[i] + (i + 1) * weights[i + 1]) / w;
+        tapWeights[tapCount] = w / total;
+        tapCount++;
+    }
+}
+
+void BlurShader::setDirection(float du, float dv) {
+    texelStep[0] = du;
+    texelStep[1] = dv;
+}
+
+void BlurShader::bind() {
+    TextureShader::bind();
+    glUniform2f(texelStepLocation, texelStep[0], texelStep[1]);
+    glUniform1i(tapCountLocation, tapCount);
+    glUniform1fv(tapOffsetsLocation, MAX_TAPS, tapOffsets);
+    glUniform1fv(tapWeightsLocation, MAX_TAPS, tapWeights);
+}
@@ -0,0 +1,39 @@
+#ifndef BLUR_SHADER_HPP
+#define BLUR_SHADER_HPP
+
+#include "TextureShader.hpp"
+#include <string>
+
+//!  BlurShader.
+/*!
+ One direction of a separable Gaussian (gaussianBlur.frag). Neighbouring kernel taps are merged
+ into one bilinear fetch between the two texels, so a kernel of radius R costs about R / 2 + 1
+ fetches per side. With sigma 0 it is a plain copy, used for downsampling.
+ */
+class BlurShader : public TextureShader {
+private:
+    static const int MAX_TAPS = 16;    //!< must match gaussianBlur.frag
+
+    GLint texelStepLocation;
+    GLint tapCountLocation;
+    GLint tapOffsetsLocation;
+    GLint tapWeightsLocation;
+    float texelStep[2];
+    int tapCount;
+    float tapOffsets[MAX_TAPS];
+    float tapWeights[MAX_TAPS];
+
+public:
+    BlurShader(std::string vertexShaderName, std::string fragmentShaderName);
+
+    //! setSigma
+    /*! Kernel in texels of the sampled texture, the kernel is cut at 30 texels (sigma 10). */
+    void setSigma(float sigma);
+    //! setDirection
+    /*! Step between taps in UV units, e.g. (1 / width, 0) for the horizontal pass. */
+    void setDirection(float du, float dv);
+
+    void bind() override;
+};
+
+#endif // BLUR_SHADER_HPP
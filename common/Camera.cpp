@@ -10,6 +10,8 @@
 
 
 Camera::Camera(){
+    m_viewProjectionDirty = true;
+    m_version = 1;
     
     m_position = glm::vec3( 0, 0, -1 );
     m_horizontalAngle = 3.14f;
@@ -30,12 +32,23 @@ Camera::Camera(){
 Camera::Camera(glm::mat4 projectionMat, glm::mat4 viewMat){
     m_projectionMatrix = projectionMat;
     m_viewMatrix=viewMat;
+    m_viewProjectionDirty = true;
+    m_version = 1;
 }
 //! Access viewprojection matrix
 /*!  Access viewprojection matrix. */
-glm::mat4 Camera::getViewProjectionMatrix(){
+const glm::mat4& Camera::getViewProjectionMatrix(){
     
-    return m_projectionMatrix * m_viewMatrix;
+    if (m_viewProjectionDirty) {
+        m_viewProjectionMatrix = m_projectionMatrix * m_viewMatrix;
+        m_viewProjectionDirty = false;
+    }
+    return m_viewProjectionMatrix;
+}
+
+void Camera::viewChanged(){
+    m_viewProjectionDirty = true;
+    m_version++;
 }
 //! Access view matrix
 /*!  Access view matrix. */
@@ -74,6 +87,7 @@ void Camera::setLookAt(glm::vec3 lookAt){
                                      m_lookat, // and looks here : at the same position, plus "direction"
                                      m_up                  // Head is up (set to 0,-1,0 to look upside-down)
                                      );
+    viewChanged();
 }
 //! Set lookat vector
 /*!  Set lookat configuration by setting position, lookat vector and up vector. */
@@ -86,6 +100,7 @@ void Camera::setLookAt(glm::vec3 pos,glm::vec3 lookAt, glm::vec3 up){
                                      m_lookat, // and looks here : at the same position, plus "direction"
                                      m_up                  // Head is up (set to 0,-1,0 to look upside-down)
                                      );
+    viewChanged();
 }
 //! Set position
 /*!  Set position. */
@@ -96,6 +111,7 @@ void Camera::setPosition(glm::vec3 pos){
                                      m_lookat, // and looks here : at the same position, plus "direction"
                                      m_up                  // Head is up (set to 0,-1,0 to look upside-down)
                                      );
+    viewChanged();
 }
 
 //! Update angles.
@@ -125,6 +141,7 @@ void Camera::updateAngles(){
                                      m_lookat, // and looks here : at the same position, plus "direction"
                                      m_up                  // Head is up (set to 0,-1,0 to look upside-down)
                                      );
+    viewChanged();
     
     
 }
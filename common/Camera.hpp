@@ -29,8 +29,8 @@ public:
     /*! Setting up camera with certain parameters. */
     Camera(glm::mat4 projectionMat, glm::mat4 viewMat);
     //! Access viewprojection matrix
-    /*!  Access viewprojection matrix. */
-    glm::mat4 getViewProjectionMatrix();
+    /*!  Access viewprojection matrix. Only recomputed after the view or projection changed. */
+    const glm::mat4& getViewProjectionMatrix();
     //! getViewMatrix
     /*!  Access view matrix. */
     glm::mat4 getViewMatrix();
@@ -59,8 +59,20 @@ public:
     /*!  Set after setting the angles the camera settings neeed to be updated. */
     void updateAngles();
     
+    //! getVersion
+    /*!  Incremented whenever view or projection change, lets users cache matrices derived from the camera. */
+    unsigned int getVersion() const { return m_version; }
+    
     
 private:
+    //! viewChanged
+    /*!  Invalidates the cached viewprojection matrix. */
+    void viewChanged();
+    
+    glm::mat4 m_viewProjectionMatrix;   //!< projection * view, valid unless m_viewProjectionDirty
+    bool m_viewProjectionDirty;
+    unsigned int m_version;
+
     glm::mat4 m_projectionMatrix;   //!< Contains only projectionMatrix
     glm::mat4 m_viewMatrix;         //!< Contains only viewMatrix
     
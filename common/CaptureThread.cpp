@@ -0,0 +1,84 @@
+#include "CaptureThread.hpp"
+
+#include <chrono>
+
+CaptureThread::CaptureThread(FrameSource* source, int width, int height)
+    : m_source(source), m_size(width, height), m_stop(false), m_hasNew(false),
+      m_latestTimestamp(-1.0), m_fetchedTimestamp(-1.0) {
+    if (m_source != nullptr && m_source->isOpened())
+        m_thread = std::thread(&CaptureThread::run, this);
+}
+
+CaptureThread::~CaptureThread() {
+    stop();
+}
+
+bool CaptureThread::isOpened() const {
+    return m_source != nullptr && m_source->isOpened();
+}
+
+void CaptureThread::run() {
+    cv::Mat captured;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop)
+                break;
+        }
+
+        if (!m_source->read(captured)) {
+            if (!m_source->isOpened())
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+
+        // Copy out of the source buffer (it may belong to the driver) while resizing if needed
+        if (m_size.width > 0 && m_size.height > 0 && captured.size() != m_size)
+            cv::resize(captured, m_back, m_size, 0, 0, cv::INTER_AREA);
+        else
+            captured.copyTo(m_back);
+        double timestamp = m_source->getTimestamp();
+        m_source->releaseFrame();
+
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::swap(m_back, m_latest);
+            m_hasNew = true;
+            m_latestTimestamp = timestamp;
+            callback = m_frameCallback;
+        }
+        if (callback)
+            callback();
+    }
+}
+
+void CaptureThread::setFrameCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frameCallback = callback;
+}
+
+bool CaptureThread::fetch(cv::Mat& frame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_hasNew)
+        return false;
+    std::swap(frame, m_latest);
+    m_hasNew = false;
+    m_fetchedTimestamp = m_latestTimestamp;
+    return true;
+}
+
+void CaptureThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    if (m_thread.joinable())
+        m_thread.join();
+    if (m_source != nullptr) {
+        m_source->release();
+        delete m_source;
+        m_source = nullptr;
+    }
+}
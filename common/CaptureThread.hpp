@@ -0,0 +1,74 @@
+#ifndef CAPTURETHREAD_HPP
+#define CAPTURETHREAD_HPP
+
+#include "FrameSource.hpp"
+#include <thread>
+#include <mutex>
+#include <functional>
+
+/**
+ * CaptureThread - Reads a FrameSource on its own thread and keeps only the latest frame.
+ *
+ * The render thread polls with fetch(), which never blocks on the camera. Three buffers
+ * rotate between the capture thread, the shared "latest" slot and the caller, so steady
+ * state capture does not allocate. Frames can be resized to a fixed size on the capture
+ * thread, e.g. to match the layers of a texture array.
+ */
+class CaptureThread {
+public:
+    /**
+     * Start capturing
+     * @param source Source to read from; ownership is taken
+     * @param width Output width, 0 keeps the source size
+     * @param height Output height, 0 keeps the source size
+     */
+    CaptureThread(FrameSource* source, int width = 0, int height = 0);
+    ~CaptureThread();
+
+    /**
+     * Check whether the underlying source is open
+     */
+    bool isOpened() const;
+
+    /**
+     * Take the newest frame if one arrived since the last call. Never blocks on capture.
+     * @param frame Receives the frame in the source's layout; its previous buffer is recycled by the capture thread
+     * @return True if a new frame was returned
+     */
+    bool fetch(cv::Mat& frame);
+
+    /**
+     * Capture timestamp of the frame returned by the last successful fetch()
+     * @return Seconds on the steady clock, negative if the source has no timestamps
+     */
+    double getTimestamp() const { return m_fetchedTimestamp; }
+
+    /**
+     * Called on the capture thread after each new frame, e.g. to wake an event loop.
+     * The callback must be safe to call from another thread.
+     */
+    void setFrameCallback(std::function<void()> callback);
+
+    /**
+     * Stop the thread and release the source
+     */
+    void stop();
+
+private:
+    void run();
+
+    FrameSource* m_source;
+    cv::Size m_size;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    bool m_stop;
+
+    cv::Mat m_back;         //!< written by the capture thread only
+    cv::Mat m_latest;       //!< newest complete frame, guarded by m_mutex
+    bool m_hasNew;
+    double m_latestTimestamp;   //!< guarded by m_mutex
+    double m_fetchedTimestamp;  //!< render thread only
+    std::function<void()> m_frameCallback;
+};
+
+#endif // CAPTURETHREAD_HPP
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "ColorLUT.hpp"
+
+ColorLUT::ColorLUT() : m_size(0) {
+}
+
+bool ColorLUT::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        fprintf(stderr, "ColorLUT: cannot open %s\n", filename.c_str());
+        return false;
+    }
+    int size = 0;
+    std::string title;
+    std::vector<float> rgb;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+        std::istringstream tokens(line);
+        std::string keyword;
+        if (!(tokens >> keyword))
+            continue;
+
+        if (keyword == "TITLE") {
+            size_t open = line.find('"');
+            size_t close = line.rfind('"');
+            if (open != std::string::npos && close > open)
+                title = line.substr(open + 1, close - open - 1);
+        } else if (keyword == "LUT_3D_SIZE") {
+            tokens >> size;
+            if (size < 2 || size > MAX_SIZE) {
+                fprintf(stderr, "ColorLUT: %s: unsupported LUT_3D_SIZE %d\n", filename.c_str(), size);
+                return false;
+            }
+            rgb.reserve((size_t)size * size * size * 3);
+        } else if (keyword == "LUT_1D_SIZE") {
+            fprintf(stderr, "ColorLUT: %s: 1D tables are not supported\n", filename.c_str());
+            return false;
+        } else if (keyword == "DOMAIN_MIN" || keyword == "DOMAIN_MAX") {
+            // Frames are 8-bit, only tables over the 0..1 input range make sense for them
+            float expected = keyword == "DOMAIN_MIN" ? 0.0f : 1.0f;
+            float value[3] = { expected, expected, expected };
+            tokens >> value[0] >> value[1] >> value[2];
+            if (value[0] != expected || value[1] != expected || value[2] != expected) {
+                fprintf(stderr, "ColorLUT: %s: only a 0..1 domain is supported\n", filename.c_str());
+                return false;
+            }
+        } else if (keyword == "LUT_3D_INPUT_RANGE") {
+            float low = 0.0f, high = 1.0f;
+            tokens >> low >> high;
+            if (low != 0.0f || high != 1.0f) {
+                fprintf(stderr, "ColorLUT: %s: only a 0..1 input range is supported\n", filename.c_str());
+                return false;
+            }
+        } else if ((keyword[0] >= '0' && keyword[0] <= '9') || keyword[0] == '-' || keyword[0] == '.') {
+            float r, g, b;
+            std::istringstream values(line);
+            if (!(values >> r >> g >> b)) {
+                fprintf(stderr, "ColorLUT: %s:%d: expected three values\n", filename.c_str(), lineNumber);
+                return false;
+            }
+            rgb.push_back(r);
+            rgb.push_back(g);
+            rgb.push_back(b);
+        }
+        // Other keywords (e.g. LUT_IN_VIDEO_RANGE) do not change the table
+    }
+    if (size == 0) {
+        fprintf(stderr, "ColorLUT: %s has no LUT_3D_SIZE\n", filename.c_str());
+        return false;
+    }
+    if (!setTable(size, rgb)) {
+        fprintf(stderr, "ColorLUT: %s has %d entries, expected %d\n", filename.c_str(),
+                (int)(rgb.size() / 3), size * size * size);
+        return false;
+    }
+    m_title = title.empty() ? filename : title;
+    return true;
+}
+
+bool ColorLUT::setTable(int size, const std::vector<float>& rgb) {
+    if (size < 2 || size > MAX_SIZE || rgb.size() != (size_t)size * size * size * 3)
+        return false;
+    m_size = size;
+    m_table = rgb;
+    buildFixed();
+    return true;
+}
+
+void ColorLUT::bake(int size, const std::function<cv::Vec3f(float r, float g, float b)>& function) {
+    size = std::max(2, std::min(size, (int)MAX_SIZE));
+    std::vector<float> rgb((size_t)size * size * size * 3);
+    const float step = 1.0f / (size - 1);
+    size_t i = 0;
+    for (int b = 0; b < size; b++) {
+        for (int g = 0; g < size; g++) {
+            for (int r = 0; r < size; r++, i += 3) {
+                cv::Vec3f out = function(r * step, g * step, b * step);
+                rgb[i] = out[0];
+                rgb[i + 1] = out[1];
+                rgb[i + 2] = out[2];
+            }
+        }
+    }
+    setTable(size, rgb);
+}
+
+ColorLUT ColorLUT::sinCity(int size) {
+    // Same math as Filters::applySinCity, evaluated at the grid points
+    ColorLUT lut;
+    lut.bake(size, [](float r, float g, float b) {
+        if (r - std::max(g, b) > 0.2f && r > 0.3f)
+            return cv::Vec3f(std::min(r * 1.2f, 1.0f), g * 0.3f, b * 0.3f);
+        float gray = 0.299f * r + 0.587f * g + 0.114f * b;
+        gray = std::max(0.0f, std::min(1.0f, (gray - 0.5f) * 1.5f + 0.5f));
+        float value = gray >= 0.5f ? 1.0f : 0.0f;
+        return cv::Vec3f(value, value, value);
+    });
+    lut.m_title = "Sin City";
+    return lut;
+}
+
+void ColorLUT::buildFixed() {
+    // 8-bit entries keep every product of the 16-bit blend (value * weight <= 255 * 256) in range
+    size_t entries = (size_t)m_size * m_size * m_size;
+    m_fixed.assign(entries * 4, 0);
+    for (size_t i = 0; i < entries; i++) {
+        for (int c = 0; c < 3; c++) {
+            float value = std::max(0.0f, std::min(1.0f, m_table[i * 3 + c]));
+            m_fixed[i * 4 + 2 - c] = (ushort)cvRound(value * 255.0f);    // RGB -> BGR
+        }
+    }
+}
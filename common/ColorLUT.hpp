@@ -0,0 +1,74 @@
+#ifndef COLORLUT_HPP
+#define COLORLUT_HPP
+
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * ColorLUT - 3D colour lookup table, e.g. a colour grade exported as a .cube file.
+ *
+ * The table is kept twice: as floats (RGB, red index fastest, like the .cube data) for the
+ * GPU's 3D texture, and as 8-bit values widened to 16-bit BGR0 entries for the CPU kernel in
+ * Filters::applyColorLUT, which blends four of them per pixel (tetrahedral interpolation).
+ */
+class ColorLUT {
+public:
+    static const int MAX_SIZE = 129;
+
+    ColorLUT();
+
+    /**
+     * Load a 3D table from an Adobe / Resolve .cube file
+     * @param filename Path to the .cube file (LUT_3D_SIZE, optional TITLE and DOMAIN_MIN/MAX of 0..1)
+     * @return False if the file could not be read or is not a 3D table
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * Set the table directly
+     * @param size Entries per axis (2 to MAX_SIZE)
+     * @param rgb size^3 RGB triples in 0..1, red index fastest, then green, then blue
+     * @return False if the sizes do not match
+     */
+    bool setTable(int size, const std::vector<float>& rgb);
+
+    /**
+     * Bake a per pixel colour function into a table
+     * @param size Entries per axis
+     * @param function Maps normalized (r, g, b) to normalized (r, g, b)
+     */
+    void bake(int size, const std::function<cv::Vec3f(float r, float g, float b)>& function);
+
+    /**
+     * The Sin City filter as a table. Exact at the grid points; the threshold is smoothed over
+     * one table cell, so it is close to but not identical with Filters::applySinCity
+     * @param size Entries per axis, 65 keeps the smoothed band to about four levels
+     */
+    static ColorLUT sinCity(int size = 65);
+
+    bool isEmpty() const { return m_size == 0; }
+    int getSize() const { return m_size; }
+    const std::string& getTitle() const { return m_title; }
+
+    /**
+     * Float table, RGB, red index fastest (GL_TEXTURE_3D layout with r along width)
+     */
+    const std::vector<float>& getTable() const { return m_table; }
+
+    /**
+     * CPU table: 4 ushorts per entry (B, G, R, 0) holding 0..255, same entry order as getTable()
+     */
+    const std::vector<ushort>& getFixedTable() const { return m_fixed; }
+
+private:
+    void buildFixed();
+
+    int m_size;
+    std::string m_title;
+    std::vector<float> m_table;
+    std::vector<ushort> m_fixed;
+};
+
+#endif // COLORLUT_HPP
@@ -1,23 +1,22 @@
 #include "Filters.hpp"
+#include "ColorLUT.hpp"
 #include <algorithm>
+#include <cmath>
 
-void Filters::applySinCity(const cv::Mat& input, cv::Mat& output) {
-    if (input.empty()) {
-        return;
-    }
-    
-    // Ensure output has the same size and type as input
-    output = input.clone();
-    
-    // Process each pixel
+#include <opencv2/core/hal/intrin.hpp>
+
+// Per-pixel work is written against row pointers with a compile time channel count, so the
+// 4-channel layout (see FrameFormat) gets one 32-bit word per pixel and a vectorisable loop
+template<int CN>
+static void sinCityRows(const cv::Mat& input, cv::Mat& output) {
     for (int y = 0; y < input.rows; y++) {
-        for (int x = 0; x < input.cols; x++) {
-            cv::Vec3b pixel = input.at<cv::Vec3b>(y, x);
-            
+        const uchar* src = input.ptr<uchar>(y);
+        uchar* dst = output.ptr<uchar>(y);
+        for (int x = 0; x < input.cols; x++, src += CN, dst += CN) {
             // OpenCV uses BGR format
-            float b = pixel[0] / 255.0f;
-            float g = pixel[1] / 255.0f;
-            float r = pixel[2] / 255.0f;
+            float b = src[0] / 255.0f;
+            float g = src[1] / 255.0f;
+            float r = src[2] / 255.0f;
             
             // Calculate grayscale using standard luminance formula
             float gray = 0.299f * r + 0.587f * g + 0.114f * b;
@@ -29,9 +28,9 @@ void Filters::applySinCity(const cv::Mat& input, cv::Mat& output) {
             if (isRed) {
                 // Keep red areas colored but enhance them
                 // Reduce other channels to emphasize red
-                output.at<cv::Vec3b>(y, x)[0] = cv::saturate_cast<uchar>(b * 0.3f * 255);  // B
-                output.at<cv::Vec3b>(y, x)[1] = cv::saturate_cast<uchar>(g * 0.3f * 255);  // G
-                output.at<cv::Vec3b>(y, x)[2] = cv::saturate_cast<uchar>(r * 1.2f * 255);  // R
+                dst[0] = cv::saturate_cast<uchar>(b * 0.3f * 255);  // B
+                dst[1] = cv::saturate_cast<uchar>(g * 0.3f * 255);  // G
+                dst[2] = cv::saturate_cast<uchar>(r * 1.2f * 255);  // R
             } else {
                 // Apply high contrast black and white effect
                 float contrast = 1.5f;
@@ -43,22 +42,18 @@ void Filters::applySinCity(const cv::Mat& input, cv::Mat& output) {
                 gray = (gray >= threshold) ? 1.0f : 0.0f;
                 
                 uchar grayValue = cv::saturate_cast<uchar>(gray * 255);
-                output.at<cv::Vec3b>(y, x) = cv::Vec3b(grayValue, grayValue, grayValue);
+                dst[0] = grayValue;
+                dst[1] = grayValue;
+                dst[2] = grayValue;
             }
+            if (CN == 4)
+                dst[3] = src[3];    // alpha passes through
         }
     }
 }
 
-void Filters::applyPixelation(const cv::Mat& input, cv::Mat& output, int pixelSize) {
-    if (input.empty()) {
-        return;
-    }
-    
-    // Ensure pixel size is at least 1
-    pixelSize = std::max(1, pixelSize);
-    
-    output = input.clone();
-    
+template<int CN>
+static void pixelationRows(const cv::Mat& input, cv::Mat& output, int pixelSize) {
     // Process the image in blocks
     for (int y = 0; y < input.rows; y += pixelSize) {
         for (int x = 0; x < input.cols; x += pixelSize) {
@@ -67,40 +62,315 @@ void Filters::applyPixelation(const cv::Mat& input, cv::Mat& output, int pixelSi
             int blockWidth = std::min(pixelSize, input.cols - x);
             
             // Calculate average color in the block
-            cv::Scalar avgColor(0, 0, 0);
-            int pixelCount = 0;
-            
+            int sum[CN] = {};
             for (int by = 0; by < blockHeight; by++) {
-                for (int bx = 0; bx < blockWidth; bx++) {
-                    cv::Vec3b pixel = input.at<cv::Vec3b>(y + by, x + bx);
-                    avgColor[0] += pixel[0];  // B
-                    avgColor[1] += pixel[1];  // G
-                    avgColor[2] += pixel[2];  // R
-                    pixelCount++;
-                }
+                const uchar* src = input.ptr<uchar>(y + by) + x * CN;
+                for (int i = 0; i < blockWidth * CN; i += CN)
+                    for (int c = 0; c < CN; c++)
+                        sum[c] += src[i + c];
             }
-            
-            // Calculate average
-            avgColor[0] /= pixelCount;
-            avgColor[1] /= pixelCount;
-            avgColor[2] /= pixelCount;
+            int pixelCount = blockWidth * blockHeight;
             
             // Fill the entire block with the average color
-            cv::Vec3b fillColor(
-                cv::saturate_cast<uchar>(avgColor[0]),
-                cv::saturate_cast<uchar>(avgColor[1]),
-                cv::saturate_cast<uchar>(avgColor[2])
-            );
+            uchar fillColor[CN];
+            for (int c = 0; c < CN; c++)
+                fillColor[c] = cv::saturate_cast<uchar>((double)sum[c] / pixelCount);
             
             for (int by = 0; by < blockHeight; by++) {
-                for (int bx = 0; bx < blockWidth; bx++) {
-                    output.at<cv::Vec3b>(y + by, x + bx) = fillColor;
+                uchar* dst = output.ptr<uchar>(y + by) + x * CN;
+                for (int i = 0; i < blockWidth * CN; i += CN)
+                    for (int c = 0; c < CN; c++)
+                        dst[i + c] = fillColor[c];
+            }
+        }
+    }
+}
+
+// Tetrahedral interpolation: the table cell around a colour is split into six tetrahedra along its
+// diagonal. Walking from the lower corner along the axes in order of decreasing fraction visits the
+// four corners of the one containing the colour; weights are the differences of the sorted fractions
+static inline void lutTetrahedron(const uchar* pixel, const ushort* table, const int* cell, const int* fraction,
+                                  int stepG, int stepB, const ushort** corner, int* weight) {
+    int f[3] = { fraction[pixel[2]], fraction[pixel[1]], fraction[pixel[0]] };
+    int step[3] = { 4, stepG, stepB };
+    if (f[0] < f[1]) { std::swap(f[0], f[1]); std::swap(step[0], step[1]); }
+    if (f[1] < f[2]) { std::swap(f[1], f[2]); std::swap(step[1], step[2]); }
+    if (f[0] < f[1]) { std::swap(f[0], f[1]); std::swap(step[0], step[1]); }
+    corner[0] = table + cell[pixel[2]] * 4 + cell[pixel[1]] * stepG + cell[pixel[0]] * stepB;
+    corner[1] = corner[0] + step[0];
+    corner[2] = corner[1] + step[1];
+    corner[3] = corner[2] + step[2];
+    weight[0] = 256 - f[0];
+    weight[1] = f[0] - f[1];
+    weight[2] = f[1] - f[2];
+    weight[3] = f[2];
+}
+
+template<int CN>
+static void colorLUTRows(const cv::Mat& input, cv::Mat& output, const ColorLUT& lut) {
+    const int size = lut.getSize();
+    const ushort* table = lut.getFixedTable().data();
+    const int stepG = 4 * size;
+    const int stepB = 4 * size * size;
+    // Per 8-bit level: lower cell index along an axis and the fraction towards the next one (0..256)
+    int cell[256];
+    int fraction[256];
+    for (int v = 0; v < 256; v++) {
+        int position = v * (size - 1);
+        int index = position / 255;
+        int rest = position - index * 255;
+        if (index == size - 1) {
+            index--;
+            rest = 255;
+        }
+        cell[v] = index;
+        fraction[v] = (rest * 256 + 127) / 255;
+    }
+
+    // Entries are BGR0 in 16-bit lanes, a blend of four of them needs at most 255 * 256 per lane
+    cv::parallel_for_(cv::Range(0, input.rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; y++) {
+            const uchar* src = input.ptr<uchar>(y);
+            uchar* dst = output.ptr<uchar>(y);
+            const ushort* cornerA[4];
+            const ushort* cornerB[4];
+            int weightA[4], weightB[4];
+            int x = 0;
+#if CV_SIMD128
+            // Two pixels per register, one in each half
+            for (; x <= input.cols - 2; x += 2, src += 2 * CN, dst += 2 * CN) {
+                lutTetrahedron(src, table, cell, fraction, stepG, stepB, cornerA, weightA);
+                lutTetrahedron(src + CN, table, cell, fraction, stepG, stepB, cornerB, weightB);
+                cv::v_uint16x8 sum = cv::v_setall_u16(128);
+                for (int k = 0; k < 4; k++) {
+                    ushort a = (ushort)weightA[k], b = (ushort)weightB[k];
+                    sum = sum + cv::v_load_halves(cornerA[k], cornerB[k]) * cv::v_uint16x8(a, a, a, a, b, b, b, b);
                 }
+                uchar blended[16];
+                cv::v_store(blended, cv::v_pack(sum >> 8, sum >> 8));
+                for (int c = 0; c < 3; c++) {
+                    dst[c] = blended[c];
+                    dst[CN + c] = blended[4 + c];
+                }
+                if (CN == 4) {
+                    dst[3] = src[3];    // alpha passes through
+                    dst[CN + 3] = src[CN + 3];
+                }
+            }
+#endif
+            for (; x < input.cols; x++, src += CN, dst += CN) {
+                lutTetrahedron(src, table, cell, fraction, stepG, stepB, cornerA, weightA);
+                for (int c = 0; c < 3; c++)
+                    dst[c] = (uchar)((cornerA[0][c] * weightA[0] + cornerA[1][c] * weightA[1] +
+                                      cornerA[2][c] * weightA[2] + cornerA[3][c] * weightA[3] + 128) >> 8);
+                if (CN == 4)
+                    dst[3] = src[3];
             }
         }
+    });
+}
+
+// One output row of the vertical running sum: out = acc / window, then the window slides down
+// by one row (add enters, sub leaves). Elements are independent, so channels need no special case
+static void slideRow(int* acc, const uchar* add, const uchar* sub, uchar* out, int n, float scale) {
+    int i = 0;
+#if CV_SIMD128
+    const cv::v_float32x4 vscale = cv::v_setall_f32(scale);
+    for (; i <= n - 8; i += 8) {
+        cv::v_int32x4 s0 = cv::v_load(acc + i);
+        cv::v_int32x4 s1 = cv::v_load(acc + i + 4);
+        cv::v_pack_u_store(out + i, cv::v_pack(cv::v_round(cv::v_cvt_f32(s0) * vscale),
+                                               cv::v_round(cv::v_cvt_f32(s1) * vscale)));
+        cv::v_uint32x4 a0, a1, r0, r1;
+        cv::v_expand(cv::v_load_expand(add + i), a0, a1);
+        cv::v_expand(cv::v_load_expand(sub + i), r0, r1);
+        cv::v_store(acc + i, s0 + cv::v_reinterpret_as_s32(a0) - cv::v_reinterpret_as_s32(r0));
+        cv::v_store(acc + i + 4, s1 + cv::v_reinterpret_as_s32(a1) - cv::v_reinterpret_as_s32(r1));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = (uchar)cvRound(acc[i] * scale);
+        acc[i] += add[i] - sub[i];
+    }
+}
+
+// Vertical box pass. Rows stream through the cache one after another; bands of rows run in
+// parallel, each band starts its own sum, so bands are kept large compared to the window
+static void boxBlurVertical(const cv::Mat& input, cv::Mat& output, int radius) {
+    output.create(input.size(), input.type());
+    const int rows = input.rows;
+    const int n = input.cols * input.channels();
+    const int window = 2 * radius + 1;
+    const float scale = 1.0f / window;
+    int stripes = std::max(1, std::min(rows / std::max(32, 4 * window), 4 * cv::getNumThreads()));
+
+    cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range& range) {
+        std::vector<int> acc(n, 0);
+        for (int k = range.start - radius; k <= range.start + radius; k++) {
+            const uchar* src = input.ptr<uchar>(std::min(std::max(k, 0), rows - 1));
+            for (int i = 0; i < n; i++)
+                acc[i] += src[i];
+        }
+        for (int y = range.start; y < range.end; y++) {
+            const uchar* add = input.ptr<uchar>(std::min(y + radius + 1, rows - 1));
+            const uchar* sub = input.ptr<uchar>(std::max(y - radius, 0));
+            slideRow(acc.data(), add, sub, output.ptr<uchar>(y), n, scale);
+        }
+    }, stripes);
+}
+
+// Separable blur as a chain of box passes: all vertical passes, then the horizontal ones as
+// vertical passes over the transposed image, which keeps every pass streaming whole rows
+static void boxBlurPasses(const cv::Mat& input, cv::Mat& output, const std::vector<int>& radii) {
+    cv::Mat buffers[2];
+    const cv::Mat* current = &input;
+    int next = 0;
+    for (int radius : radii) {
+        if (radius <= 0)
+            continue;
+        boxBlurVertical(*current, buffers[next], radius);
+        current = &buffers[next];
+        next ^= 1;
+    }
+    cv::Mat transposed[2];
+    cv::transpose(*current, transposed[0]);
+    current = &transposed[0];
+    next = 1;
+    for (int radius : radii) {
+        if (radius <= 0)
+            continue;
+        boxBlurVertical(*current, transposed[next], radius);
+        current = &transposed[next];
+        next ^= 1;
+    }
+    cv::transpose(*current, output);
+}
+
+// Radii of three box filters whose combined variance matches a Gaussian of the given sigma
+static std::vector<int> gaussianBoxRadii(float sigma) {
+    const int passes = 3;
+    double variance = 12.0 * sigma * sigma;
+    int lower = (int)std::floor(std::sqrt(variance / passes + 1.0));
+    if (lower % 2 == 0)
+        lower--;
+    int upper = lower + 2;
+    // Number of passes that use the smaller width
+    int smaller = (int)std::round((variance - passes * lower * lower - 4.0 * passes * lower - 3.0 * passes) /
+                                  (-4.0 * lower - 4.0));
+    std::vector<int> radii;
+    for (int i = 0; i < passes; i++)
+        radii.push_back(((i < smaller ? lower : upper) - 1) / 2);
+    return radii;
+}
+
+void Filters::applySinCity(const cv::Mat& input, cv::Mat& output) {
+    if (input.empty()) {
+        return;
+    }
+    
+    // Ensure output has the same size and type as input (keeps the buffer, or the ROI, if it already has)
+    output.create(input.size(), input.type());
+    
+    // BGR or BGRA
+    if (input.channels() == 4)
+        sinCityRows<4>(input, output);
+    else
+        sinCityRows<3>(input, output);
+}
+
+void Filters::applyPixelation(const cv::Mat& input, cv::Mat& output, int pixelSize) {
+    if (input.empty()) {
+        return;
+    }
+    
+    // Ensure pixel size is at least 1
+    pixelSize = std::max(1, pixelSize);
+    
+    output.create(input.size(), input.type());
+    
+    if (input.channels() == 4)
+        pixelationRows<4>(input, output, pixelSize);
+    else
+        pixelationRows<3>(input, output, pixelSize);
+}
+
+void Filters::applySinCity(const cv::Mat& input, cv::Mat& output, const std::vector<cv::Rect>& regions) {
+    if (input.empty()) {
+        return;
+    }
+    output.create(input.size(), input.type());
+    for (const cv::Rect& region : regions) {
+        // Writing through an ROI header fills that part of output in place
+        cv::Mat target = output(region);
+        applySinCity(input(region), target);
+    }
+}
+
+void Filters::applyPixelation(const cv::Mat& input, cv::Mat& output, const std::vector<cv::Rect>& regions,
+                              int pixelSize) {
+    if (input.empty()) {
+        return;
+    }
+    output.create(input.size(), input.type());
+    for (const cv::Rect& region : regions) {
+        cv::Mat target = output(region);
+        applyPixelation(input(region), target, pixelSize);
     }
 }
 
+void Filters::applyColorLUT(const cv::Mat& input, cv::Mat& output, const ColorLUT& lut) {
+    if (input.empty() || lut.isEmpty()) {
+        if (&output != &input)
+            input.copyTo(output);
+        return;
+    }
+    output.create(input.size(), input.type());
+    if (input.channels() == 4)
+        colorLUTRows<4>(input, output, lut);
+    else
+        colorLUTRows<3>(input, output, lut);
+}
+
+void Filters::applyColorLUT(const cv::Mat& input, cv::Mat& output, const std::vector<cv::Rect>& regions,
+                            const ColorLUT& lut) {
+    if (input.empty()) {
+        return;
+    }
+    output.create(input.size(), input.type());
+    for (const cv::Rect& region : regions) {
+        cv::Mat target = output(region);
+        applyColorLUT(input(region), target, lut);
+    }
+}
+
+void Filters::applyBoxBlur(const cv::Mat& input, cv::Mat& output, int radius) {
+    if (input.empty()) {
+        return;
+    }
+    if (radius <= 0) {
+        input.copyTo(output);
+        return;
+    }
+    boxBlurPasses(input, output, std::vector<int>(1, radius));
+}
+
+void Filters::applyGaussianBlur(const cv::Mat& input, cv::Mat& output, float sigma) {
+    if (input.empty()) {
+        return;
+    }
+    std::vector<int> radii = gaussianBoxRadii(std::max(0.0f, sigma));
+    if (radii[0] + radii[1] + radii[2] == 0) {
+        input.copyTo(output);
+        return;
+    }
+    boxBlurPasses(input, output, radii);
+}
+
+int Filters::gaussianBlurExtent(float sigma) {
+    std::vector<int> radii = gaussianBoxRadii(std::max(0.0f, sigma));
+    return radii[0] + radii[1] + radii[2];
+}
+
 void Filters::applyAffineTransform(const cv::Mat& input, cv::Mat& output, 
                                     const cv::Mat& transformMatrix) {
     if (input.empty() || transformMatrix.empty()) {
@@ -2,17 +2,21 @@
 #define FILTERS_HPP
 
 #include <opencv2/opencv.hpp>
+#include <vector>
+
+class ColorLUT;
 
 /**
  * Filters class - Contains CPU implementations of various image filters
  * for real-time video processing and performance comparison with GPU versions.
+ * Colour filters accept BGR (CV_8UC3) and BGRA (CV_8UC4, see FrameFormat) frames.
  */
 class Filters {
 public:
     /**
      * Apply Sin City style filter - high contrast black and white with selective red color
-     * @param input Input image (should be BGR format from OpenCV)
-     * @param output Output filtered image
+     * @param input Input image (BGR or BGRA)
+     * @param output Output filtered image, alpha is copied
      */
     static void applySinCity(const cv::Mat& input, cv::Mat& output);
     
@@ -23,6 +27,67 @@ public:
      * @param pixelSize Size of each pixel block (default: 10)
      */
     static void applyPixelation(const cv::Mat& input, cv::Mat& output, int pixelSize = 10);
+
+    /**
+     * Apply the Sin City filter to some regions only, the rest of output is left as is
+     * @param input Input image (BGR)
+     * @param output Output image, allocated to the input size if it is not already
+     * @param regions Regions to filter, e.g. from TileChangeDetector
+     */
+    static void applySinCity(const cv::Mat& input, cv::Mat& output, const std::vector<cv::Rect>& regions);
+
+    /**
+     * Apply the pixelation filter to some regions only, the rest of output is left as is
+     * @param input Input image
+     * @param output Output image, allocated to the input size if it is not already
+     * @param regions Regions to filter; their origins must be multiples of pixelSize so blocks match a full pass
+     * @param pixelSize Size of each pixel block
+     */
+    static void applyPixelation(const cv::Mat& input, cv::Mat& output, const std::vector<cv::Rect>& regions,
+                                int pixelSize);
+    
+    /**
+     * Box blur over a (2 * radius + 1) square window, edges are replicated. Running sums make the
+     * cost per pixel independent of the radius.
+     * @param input Input image (BGR or BGRA)
+     * @param output Output blurred image
+     * @param radius Window radius in pixels, 0 copies
+     */
+    static void applyBoxBlur(const cv::Mat& input, cv::Mat& output, int radius);
+
+    /**
+     * Gaussian blur approximated by three box blurs, so the cost does not grow with sigma
+     * @param input Input image (BGR or BGRA)
+     * @param output Output blurred image
+     * @param sigma Standard deviation in pixels
+     */
+    static void applyGaussianBlur(const cv::Mat& input, cv::Mat& output, float sigma);
+
+    /**
+     * How far applyGaussianBlur() reaches, i.e. the margin a cropped region needs so its
+     * inner part matches a full frame pass
+     * @param sigma Standard deviation in pixels
+     * @return Distance in pixels
+     */
+    static int gaussianBlurExtent(float sigma);
+    
+    /**
+     * Map colours through a 3D lookup table with tetrahedral interpolation
+     * @param input Input image (BGR or BGRA)
+     * @param output Output image, alpha is copied
+     * @param lut Table, e.g. a .cube colour grade or ColorLUT::sinCity()
+     */
+    static void applyColorLUT(const cv::Mat& input, cv::Mat& output, const ColorLUT& lut);
+
+    /**
+     * Apply the lookup table to some regions only, the rest of output is left as is
+     * @param input Input image (BGR or BGRA)
+     * @param output Output image, allocated to the input size if it is not already
+     * @param regions Regions to map, e.g. from TileChangeDetector
+     * @param lut Table
+     */
+    static void applyColorLUT(const cv::Mat& input, cv::Mat& output, const std::vector<cv::Rect>& regions,
+                              const ColorLUT& lut);
     
     /**
      * Apply affine transformation (translation, rotation, scaling)
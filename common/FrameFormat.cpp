@@ -0,0 +1,55 @@
+#include <stdio.h>
+
+#include "FrameFormat.hpp"
+
+#include <opencv2/core/hal/intrin.hpp>
+
+bool FrameFormat::isAligned(const cv::Mat& frame) {
+    return ((size_t)frame.data % ROW_ALIGNMENT) == 0 && (frame.step % ROW_ALIGNMENT) == 0;
+}
+
+void FrameFormat::allocateAligned(cv::Size size, int type, cv::Mat& frame) {
+    if (frame.size() == size && frame.type() == type && isAligned(frame))
+        return;
+
+    // OpenCV allocations start on a 64-byte boundary, padding the width makes every row do so too
+    size_t elemSize = CV_ELEM_SIZE(type);
+    int paddedWidth = size.width;
+    while ((paddedWidth * elemSize) % ROW_ALIGNMENT != 0)
+        paddedWidth++;
+    cv::Mat storage(size.height, paddedWidth, type);
+    frame = storage(cv::Rect(0, 0, size.width, size.height));
+}
+
+void FrameFormat::bgrToBGRA(const cv::Mat& bgr, cv::Mat& bgra, bool flipVertical) {
+    if (bgr.empty() || bgr.type() != CV_8UC3) {
+        fprintf(stderr, "FrameFormat::bgrToBGRA: expected a CV_8UC3 frame\n");
+        return;
+    }
+    allocateAligned(bgr.size(), CV_8UC4, bgra);
+
+    const int width = bgr.cols;
+    const int rows = bgr.rows;
+    cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; y++) {
+            const uchar* src = bgr.ptr<uchar>(y);
+            uchar* dst = bgra.ptr<uchar>(flipVertical ? rows - 1 - y : y);
+            int x = 0;
+#if CV_SIMD128
+            // 16 pixels per step: split the channel planes, then weave them back with alpha
+            const cv::v_uint8x16 alpha = cv::v_setall_u8(255);
+            for (; x <= width - 16; x += 16) {
+                cv::v_uint8x16 b, g, r;
+                cv::v_load_deinterleave(src + x * 3, b, g, r);
+                cv::v_store_interleave(dst + x * 4, b, g, r, alpha);
+            }
+#endif
+            for (; x < width; x++) {
+                dst[x * 4 + 0] = src[x * 3 + 0];
+                dst[x * 4 + 1] = src[x * 3 + 1];
+                dst[x * 4 + 2] = src[x * 3 + 2];
+                dst[x * 4 + 3] = 255;
+            }
+        }
+    });
+}
@@ -0,0 +1,42 @@
+#ifndef FRAMEFORMAT_HPP
+#define FRAMEFORMAT_HPP
+
+#include <opencv2/opencv.hpp>
+
+/**
+ * FrameFormat class - Internal 4-channel frame layout.
+ *
+ * Frames are kept as BGRA (CV_8UC4) with every row starting on a 64-byte boundary. Each
+ * pixel is one 32-bit word, so filters can use full vector loads, and uploads as GL_BGRA
+ * into GL_RGBA8 storage match what drivers handle without a software swizzle.
+ */
+class FrameFormat {
+public:
+    //! Row alignment in bytes (cache line, and a multiple of the AVX-512 vector width)
+    static const int ROW_ALIGNMENT = 64;
+
+    /**
+     * Allocate a frame whose rows start on ROW_ALIGNMENT boundaries. Nothing happens if
+     * frame already has this size and type and is aligned.
+     * @param size Frame size
+     * @param type OpenCV type, e.g. CV_8UC4
+     * @param frame Receives the frame; the row step may be larger than cols * elemSize()
+     */
+    static void allocateAligned(cv::Size size, int type, cv::Mat& frame);
+
+    /**
+     * Check whether data and step of a frame meet ROW_ALIGNMENT
+     */
+    static bool isAligned(const cv::Mat& frame);
+
+    /**
+     * Convert packed BGR to aligned BGRA with opaque alpha. Vectorised with OpenCV's
+     * universal intrinsics where available, rows are split across threads.
+     * @param bgr Input frame (CV_8UC3)
+     * @param bgra Output frame (CV_8UC4), reallocated with allocateAligned() if needed
+     * @param flipVertical Write rows bottom up, folds the OpenGL flip into the same pass
+     */
+    static void bgrToBGRA(const cv::Mat& bgr, cv::Mat& bgra, bool flipVertical = false);
+};
+
+#endif // FRAMEFORMAT_HPP
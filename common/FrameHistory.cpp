@@ -0,0 +1,37 @@
+#include "FrameHistory.hpp"
+
+FrameHistory::FrameHistory(int length)
+    : m_layers(nullptr), m_length(length < 1 ? 1 : length), m_newest(0), m_count(0) {
+}
+
+FrameHistory::~FrameHistory() {
+    delete m_layers;
+}
+
+void FrameHistory::setLength(int length) {
+    if (length < 1)
+        length = 1;
+    if (length == m_length)
+        return;
+    m_length = length;
+    delete m_layers;
+    m_layers = nullptr;
+    m_count = 0;
+}
+
+void FrameHistory::push(const unsigned char* data, int width, int height, int stride, int channels) {
+    if (m_layers == nullptr || m_layers->getWidth() != width || m_layers->getHeight() != height) {
+        delete m_layers;
+        m_layers = new TextureArray(width, height, m_length);
+        m_count = 0;
+    }
+    m_newest = m_count == 0 ? 0 : (m_newest + 1) % m_length;
+    m_layers->updateLayer(m_newest, data, stride, channels);
+    if (m_count < m_length)
+        m_count++;
+}
+
+void FrameHistory::bindTexture(int unit) {
+    if (m_layers != nullptr)
+        m_layers->bindTexture(unit);
+}
@@ -0,0 +1,57 @@
+/*
+ * FrameHistory.hpp
+ *
+ *  Ring of the most recent video frames on the GPU, one layer of a texture array per frame,
+ *  read by the temporal shaders.
+ *
+ */
+#ifndef FRAMEHISTORY_HPP
+#define FRAMEHISTORY_HPP
+
+#include <glad/gl.h>
+
+#include "TextureArray.hpp"
+
+//!  FrameHistory.
+/*!
+ A new frame is uploaded over the oldest layer and becomes the newest, so older frames are never
+ moved or copied: one layer upload per frame whatever the length. Storage is allocated on the
+ first push and again when the frame size or the length changes, which restarts the history.
+ */
+class FrameHistory {
+public:
+    //! Constructor
+    /*! Number of frames kept, no GL storage until the first push. */
+    FrameHistory(int length);
+    //! Destructor
+    /*! Deletes the texture array. */
+    ~FrameHistory();
+
+    //! setLength
+    /*! Changes the number of frames kept, the history restarts with the next push. */
+    void setLength(int length);
+
+    //! push
+    /*! Uploads a BGR or BGRA frame (bottom row first, stride in bytes) as the newest layer. */
+    void push(const unsigned char* data, int width, int height, int stride, int channels);
+
+    //! reset
+    /*! Forgets the stored frames, e.g. after the stream was interrupted. */
+    void reset() { m_count = 0; }
+
+    //! bindTexture
+    /*! Binds the layers as GL_TEXTURE_2D_ARRAY to the given unit. */
+    void bindTexture(int unit = 0);
+
+    int getLength() const { return m_length; }
+    int getCount() const { return m_count; }             //!< frames stored, at most getLength()
+    int getNewestLayer() const { return m_newest; }      //!< layer of the last pushed frame
+
+private:
+    TextureArray* m_layers;
+    int m_length;
+    int m_newest;
+    int m_count;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include "FrameQueue.hpp"
+
+#include <chrono>
+
+FrameQueue::FrameQueue(int capacity)
+    : m_slots(capacity < 1 ? 1 : capacity), m_timestamps(m_slots.size(), -1.0), m_head(0), m_tail(0) {
+}
+
+void FrameQueue::clear() {
+    m_head = 0;
+    m_tail = 0;
+}
+
+bool FrameQueue::push(const cv::Mat& frame, double timestamp) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) >= m_slots.size())
+        return false;
+    // The consumer is done with this slot, its buffer is reused if size and type match
+    const size_t slot = tail % m_slots.size();
+    frame.copyTo(m_slots[slot]);
+    m_timestamps[slot] = timestamp;
+    m_tail.store(tail + 1, std::memory_order_release);
+    m_wakeup.notify_one();
+    return true;
+}
+
+const cv::Mat* FrameQueue::front(double* timestamp) const {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire))
+        return nullptr;
+    const size_t slot = head % m_slots.size();
+    if (timestamp != nullptr)
+        *timestamp = m_timestamps[slot];
+    return &m_slots[slot];
+}
+
+void FrameQueue::pop() {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void FrameQueue::waitForFrame(int milliseconds) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (front() == nullptr)
+        m_wakeup.wait_for(lock, std::chrono::milliseconds(milliseconds));
+}
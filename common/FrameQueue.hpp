@@ -0,0 +1,73 @@
+#ifndef FRAMEQUEUE_HPP
+#define FRAMEQUEUE_HPP
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+/**
+ * FrameQueue - Bounded single-producer / single-consumer ring of frames.
+ *
+ * The producer copies frames into slots that keep their buffers, so steady state use does not
+ * allocate. Slots are handed over with atomic indices: push() never takes a lock and never
+ * waits, a full queue is reported to the caller, which decides whether to drop or retry.
+ * The consumer reads the oldest slot in place and releases it with pop().
+ */
+class FrameQueue {
+public:
+    /**
+     * @param capacity Number of slots
+     */
+    FrameQueue(int capacity);
+
+    /**
+     * Empty the queue; neither side may be using it
+     */
+    void clear();
+
+    /**
+     * Copy a frame into the next free slot (producer thread only)
+     * @param frame Frame to queue
+     * @param timestamp Stored with the frame
+     * @return False if the queue is full
+     */
+    bool push(const cv::Mat& frame, double timestamp = -1.0);
+
+    /**
+     * Oldest queued frame, stays valid until pop() (consumer thread only)
+     * @return Nullptr if the queue is empty
+     */
+    const cv::Mat* front(double* timestamp = nullptr) const;
+
+    /**
+     * Release the oldest frame to the producer (consumer thread only)
+     */
+    void pop();
+
+    /**
+     * Sleep until push() queued something or the timeout passed (consumer thread only).
+     * push() does not lock, so a wakeup can be missed; the timeout bounds the delay.
+     */
+    void waitForFrame(int milliseconds);
+
+    /**
+     * Wake a consumer sleeping in waitForFrame(), e.g. to make it notice a stop request
+     */
+    void wake() { m_wakeup.notify_one(); }
+
+    int size() const { return (int)(m_tail.load() - m_head.load()); }
+    int capacity() const { return (int)m_slots.size(); }
+    bool isFull() const { return size() >= capacity(); }
+
+private:
+    std::vector<cv::Mat> m_slots;
+    std::vector<double> m_timestamps;
+    std::atomic<size_t> m_head;     //!< next slot to read, written by the consumer only
+    std::atomic<size_t> m_tail;     //!< next slot to fill, written by the producer only
+    std::mutex m_mutex;             //!< only for sleeping on m_wakeup
+    std::condition_variable m_wakeup;
+};
+
+#endif // FRAMEQUEUE_HPP
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <chrono>
+
+#include "FrameRecorder.hpp"
+
+FrameRecorder::FrameRecorder(int queueLength, Policy policy)
+    : m_queue(queueLength), m_policy(policy), m_stop(false), m_failed(false), m_written(0), m_dropped(0), m_encodeMicroseconds(0),
+      m_fps(30.0), m_flipped(false) {
+}
+
+FrameRecorder::~FrameRecorder() {
+    stop();
+}
+
+bool FrameRecorder::start(const std::string& filename, double fps, bool flipped) {
+    if (isRecording())
+        return false;
+    m_filename = filename;
+    m_fps = fps > 0.0 ? fps : 30.0;
+    m_flipped = flipped;
+    m_size = cv::Size();
+    m_queue.clear();
+    m_stop = false;
+    m_failed = false;
+    m_written = 0;
+    m_dropped = 0;
+    m_encodeMicroseconds = 0;
+    m_thread = std::thread(&FrameRecorder::run, this);
+    return true;
+}
+
+void FrameRecorder::stop() {
+    if (!m_thread.joinable())
+        return;
+    m_stop = true;
+    m_queue.wake();
+    m_thread.join();
+}
+
+bool FrameRecorder::push(const cv::Mat& frame) {
+    if (!isRecording() || m_failed.load() || frame.empty())
+        return false;
+    while (!m_queue.push(frame)) {
+        if (m_policy == DROP || m_failed.load()) {
+            m_dropped++;
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+FrameRecorder::Statistics FrameRecorder::getStatistics() const {
+    Statistics statistics;
+    statistics.written = m_written.load();
+    statistics.dropped = m_dropped.load();
+    statistics.queueDepth = m_queue.size();
+    statistics.encodeMs = statistics.written > 0 ? m_encodeMicroseconds.load() / 1000.0 / statistics.written : 0.0;
+    return statistics;
+}
+
+bool FrameRecorder::openWriter(cv::Size size) {
+    std::string extension;
+    size_t dot = m_filename.rfind('.');
+    if (dot != std::string::npos)
+        extension = m_filename.substr(dot + 1);
+    int fourcc = extension == "mkv" ? cv::VideoWriter::fourcc('F', 'F', 'V', '1') :
+                 extension == "mp4" ? cv::VideoWriter::fourcc('m', 'p', '4', 'v') :
+                                      cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+    if (!m_writer.open(m_filename, fourcc, m_fps, size, true) || !m_writer.isOpened()) {
+        fprintf(stderr, "FrameRecorder: cannot open %s for writing\n", m_filename.c_str());
+        return false;
+    }
+    m_size = size;
+    return true;
+}
+
+void FrameRecorder::run() {
+    while (true) {
+        const cv::Mat* queued = m_queue.front();
+        if (queued == nullptr) {
+            // Queued frames are written before stopping
+            if (m_stop.load())
+                break;
+            m_queue.waitForFrame(5);
+            continue;
+        }
+
+        const cv::Mat& slot = *queued;
+        if (!m_failed.load()) {
+            auto encodeStart = std::chrono::steady_clock::now();
+            if (m_size.area() == 0 && !openWriter(slot.size()))
+                m_failed = true;
+            if (!m_failed.load()) {
+                const cv::Mat* image = &slot;
+                if (slot.channels() == 4) {
+                    cv::cvtColor(slot, m_converted, cv::COLOR_BGRA2BGR);
+                    image = &m_converted;
+                }
+                if (m_flipped) {
+                    // In place when the conversion already made a private copy
+                    cv::flip(*image, m_converted, 0);
+                    image = &m_converted;
+                }
+                if (image->size() != m_size) {
+                    cv::resize(*image, m_resized, m_size, 0, 0, cv::INTER_AREA);
+                    image = &m_resized;
+                }
+                m_writer.write(*image);
+                m_written++;
+                m_encodeMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - encodeStart).count();
+            }
+        }
+        if (m_failed.load())
+            m_dropped++;
+        m_queue.pop();
+    }
+    m_writer.release();
+}
@@ -0,0 +1,94 @@
+#ifndef FRAMERECORDER_HPP
+#define FRAMERECORDER_HPP
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "FrameQueue.hpp"
+
+/**
+ * FrameRecorder - Writes frames to a video file on an encoder thread.
+ *
+ * The render thread only copies a frame into a FrameQueue slot, which neither locks nor
+ * allocates in steady state. The encoder thread flips, converts and encodes with cv::VideoWriter. When the encoder falls behind, DROP
+ * discards new frames (the live display never waits) and BLOCK waits for a free slot
+ * (complete files, e.g. for offline runs).
+ */
+class FrameRecorder {
+public:
+    enum Policy { DROP, BLOCK };
+
+    /**
+     * Totals since start(), encode time is the mean per written frame
+     */
+    struct Statistics {
+        int written;
+        int dropped;
+        int queueDepth;
+        double encodeMs;
+    };
+
+    /**
+     * @param queueLength Frames that can wait for the encoder
+     * @param policy What push() does when the queue is full
+     */
+    FrameRecorder(int queueLength = 8, Policy policy = DROP);
+    ~FrameRecorder();
+
+    /**
+     * Start a recording, the file is opened by the encoder thread with the size of the first frame
+     * @param filename .avi (MJPEG), .mp4 (MPEG-4) or .mkv (lossless FFV1)
+     * @param fps Frame rate stored in the file
+     * @param flipped True if frames arrive bottom row first (OpenGL readback, flipped capture)
+     * @return False if a recording is already running
+     */
+    bool start(const std::string& filename, double fps, bool flipped);
+
+    /**
+     * Encode the queued frames, close the file and join the encoder thread
+     */
+    void stop();
+
+    bool isRecording() const { return m_thread.joinable(); }
+
+    /**
+     * True once the encoder could not open the file; frames pushed afterwards are dropped
+     */
+    bool hasFailed() const { return m_failed.load(); }
+
+    /**
+     * Queue a frame, called by one thread only
+     * @param frame 8-bit BGR or BGRA; frames of another size than the first are resized
+     * @return False if the frame was dropped
+     */
+    bool push(const cv::Mat& frame);
+
+    Statistics getStatistics() const;
+
+private:
+    void run();
+    bool openWriter(cv::Size size);
+
+    FrameQueue m_queue;
+    Policy m_policy;
+    std::atomic<bool> m_stop;
+    std::atomic<bool> m_failed;
+    std::atomic<int> m_written;
+    std::atomic<int> m_dropped;
+    std::atomic<long long> m_encodeMicroseconds;
+
+    std::thread m_thread;
+
+    // Encoder thread only
+    std::string m_filename;
+    double m_fps;
+    bool m_flipped;
+    cv::VideoWriter m_writer;
+    cv::Size m_size;
+    cv::Mat m_converted;
+    cv::Mat m_resized;
+};
+
+#endif // FRAMERECORDER_HPP
@@ -0,0 +1,54 @@
+#ifndef FRAMESOURCE_HPP
+#define FRAMESOURCE_HPP
+
+#include <opencv2/opencv.hpp>
+
+/**
+ * FrameSource - Interface for anything that delivers video frames to the render loop
+ * (OpenCV capture, native V4L2 capture, file replay, ...).
+ *
+ * Frames returned by read() may point straight into buffers owned by the source.
+ * They stay valid until releaseFrame() or the next read(), so the caller must call
+ * releaseFrame() once the frame has been uploaded or processed.
+ */
+class FrameSource {
+public:
+    virtual ~FrameSource() {}
+
+    /**
+     * Check whether the source was opened successfully
+     * @return True if frames can be read
+     */
+    virtual bool isOpened() const = 0;
+
+    /**
+     * Read the next frame, blocking until one is available
+     * @param frame Output frame; may be a non-owning header on a source buffer
+     * @return False if no frame could be read
+     */
+    virtual bool read(cv::Mat& frame) = 0;
+
+    /**
+     * Return the buffer behind the last frame to the source. Safe to call when no frame is held.
+     */
+    virtual void releaseFrame() {}
+
+    /**
+     * Capture time of the last frame on the steady (CLOCK_MONOTONIC) clock
+     * @return Timestamp in seconds, or a negative value if the source has none
+     */
+    virtual double getTimestamp() const { return -1.0; }
+
+    /**
+     * Frame size as negotiated with the device
+     */
+    virtual int getWidth() const = 0;
+    virtual int getHeight() const = 0;
+
+    /**
+     * Stop capturing and free all resources
+     */
+    virtual void release() = 0;
+};
+
+#endif // FRAMESOURCE_HPP
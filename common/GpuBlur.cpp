@@ -0,0 +1,87 @@
+#include "GpuBlur.hpp"
+
+#include <math.h>
+
+// Sigma, in texels of the level that gets blurred, above which another halving is cheaper
+static const float MAX_LEVEL_SIGMA = 4.0f;
+static const int MAX_LEVELS = 6;
+
+GpuBlur::GpuBlur() {
+    m_shader = new BlurShader("fullscreen.vert", "gaussianBlur.frag");
+    glGenVertexArrays(1, &m_vertexArrayID);
+    glGenSamplers(1, &m_samplerID);
+    glSamplerParameteri(m_samplerID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glSamplerParameteri(m_samplerID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glSamplerParameteri(m_samplerID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glSamplerParameteri(m_samplerID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+GpuBlur::~GpuBlur() {
+    for (RenderTarget* renderTarget : m_targets)
+        delete renderTarget;
+    glDeleteSamplers(1, &m_samplerID);
+    glDeleteVertexArrays(1, &m_vertexArrayID);
+    delete m_shader;
+}
+
+RenderTarget* GpuBlur::target(int index, int width, int height) {
+    while ((int)m_targets.size() <= index)
+        m_targets.push_back(new RenderTarget(width, height, false));
+    m_targets[index]->resize(width, height);
+    return m_targets[index];
+}
+
+void GpuBlur::pass(Texture* input, RenderTarget* output, float sigma, float du, float dv) {
+    output->bind();
+    m_shader->setTexture(input);
+    m_shader->setSigma(sigma);
+    m_shader->setDirection(du, dv);
+    m_shader->bind();
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+}
+
+Texture* GpuBlur::apply(Texture* source, int width, int height, float sigma) {
+    GLint viewport[4];
+    GLint vertexArray = 0;
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertexArray);
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glBindVertexArray(m_vertexArrayID);
+    glBindSampler(0, m_samplerID);
+    glDisable(GL_DEPTH_TEST);
+
+    // Each halving already blurs with variance 4^j / 4 (in source texels) at level j
+    int levels = 0;
+    double remaining = (double)sigma * sigma;
+    while (levels < MAX_LEVELS && sqrt(remaining) / (1 << levels) > MAX_LEVEL_SIGMA &&
+           (width >> (levels + 1)) >= 8 && (height >> (levels + 1)) >= 8) {
+        remaining -= (double)(1 << (2 * levels)) / 4.0;
+        levels++;
+    }
+
+    Texture* current = source;
+    int levelWidth = width;
+    int levelHeight = height;
+    for (int level = 1; level <= levels; level++) {
+        // Sampling the middle of each output texel hits the corner of a 2x2 block: one fetch averages it
+        levelWidth = width >> level;
+        levelHeight = height >> level;
+        RenderTarget* reduced = target(level - 1, levelWidth, levelHeight);
+        pass(current, reduced, 0.0f, 0.0f, 0.0f);
+        current = reduced->getTexture();
+    }
+
+    float levelSigma = remaining > 0.0 ? (float)(sqrt(remaining) / (1 << levels)) : 0.0f;
+    RenderTarget* horizontal = target(levels, levelWidth, levelHeight);
+    RenderTarget* vertical = target(levels + 1, levelWidth, levelHeight);
+    pass(current, horizontal, levelSigma, 1.0f / levelWidth, 0.0f);
+    pass(horizontal->getTexture(), vertical, levelSigma, 0.0f, 1.0f / levelHeight);
+
+    RenderTarget::unbind();
+    glBindSampler(0, 0);
+    if (depthTest)
+        glEnable(GL_DEPTH_TEST);
+    glBindVertexArray(vertexArray);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    return vertical->getTexture();
+}
@@ -0,0 +1,50 @@
+/*
+ * GpuBlur.hpp
+ *
+ *  Gaussian blur on the GPU through a chain of offscreen render targets. The cost stays
+ *  roughly flat in sigma: large kernels run on a downsampled copy.
+ *
+ */
+#ifndef GPUBLUR_HPP
+#define GPUBLUR_HPP
+
+#include <vector>
+
+#include <glad/gl.h>
+
+#include "Texture.hpp"
+#include "RenderTarget.hpp"
+#include "BlurShader.hpp"
+
+//!  GpuBlur.
+/*!
+ The source is halved (2x2 bilinear average per step) until sigma is at most a few texels of
+ the reduced image, then blurred by a horizontal and a vertical BlurShader pass. The result is
+ a texture of the reduced size; sampling it with linear filtering upsamples it smoothly.
+ */
+class GpuBlur {
+public:
+    //! Constructor
+    /*! Loads fullscreen.vert / gaussianBlur.frag, needs a current GL context. */
+    GpuBlur();
+    //! Destructor
+    /*! Deletes targets, sampler and vertex array. */
+    ~GpuBlur();
+
+    //! apply
+    /*! Blurs source (width x height texels) with sigma in source texels. Restores the default
+        framebuffer, viewport, depth test and vertex array afterwards. The returned texture is owned by the
+        GpuBlur and stays valid until the next call. */
+    Texture* apply(Texture* source, int width, int height, float sigma);
+
+private:
+    RenderTarget* target(int index, int width, int height);
+    void pass(Texture* input, RenderTarget* output, float sigma, float du, float dv);
+
+    BlurShader* m_shader;
+    std::vector<RenderTarget*> m_targets;   //!< downsample levels, then the two blur passes
+    GLuint m_vertexArrayID;                 //!< empty, the fullscreen triangle has no attributes
+    GLuint m_samplerID;                     //!< clamps edges, the video texture itself repeats
+};
+
+#endif
@@ -0,0 +1,49 @@
+#include "GpuTimer.hpp"
+
+GpuTimer::GpuTimer(int depth) : m_first(0), m_count(0), m_active(false) {
+    if (depth < 1)
+        depth = 1;
+    m_queries.resize(depth);
+    m_tags.resize(depth);
+    glGenQueries(depth, &m_queries[0]);
+}
+
+GpuTimer::~GpuTimer() {
+    glDeleteQueries((GLsizei)m_queries.size(), &m_queries[0]);
+}
+
+bool GpuTimer::begin(int tag) {
+    if (m_active || m_count == (int)m_queries.size())
+        return false;
+    int slot = (m_first + m_count) % (int)m_queries.size();
+    m_tags[slot] = tag;
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[slot]);
+    m_active = true;
+    return true;
+}
+
+void GpuTimer::end() {
+    if (!m_active)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_active = false;
+    m_count++;
+}
+
+bool GpuTimer::poll(int& tag, double& milliseconds) {
+    if (m_count == 0)
+        return false;
+    // The query being recorded is not counted yet, everything in the ring has ended
+    GLint available = 0;
+    glGetQueryObjectiv(m_queries[m_first], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return false;
+
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(m_queries[m_first], GL_QUERY_RESULT, &nanoseconds);
+    tag = m_tags[m_first];
+    milliseconds = nanoseconds / 1.0e6;
+    m_first = (m_first + 1) % (int)m_queries.size();
+    m_count--;
+    return true;
+}
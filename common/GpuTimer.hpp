@@ -0,0 +1,49 @@
+/*
+ * GpuTimer.hpp
+ *
+ *  GPU time measurement with GL_TIME_ELAPSED queries. Results are collected a few
+ *  frames later, so measuring never stalls the pipeline.
+ *
+ */
+#ifndef GPUTIMER_HPP
+#define GPUTIMER_HPP
+
+#include <vector>
+
+#include <glad/gl.h>
+
+//!  GpuTimer.
+/*!
+ Ring of timer queries. begin()/end() bracket the GL commands to time, poll() returns finished
+ measurements in submission order. Queries cannot nest.
+ */
+class GpuTimer {
+public:
+    //! Constructor
+    /*! depth is the number of measurements that can be in flight. Needs a current GL context. */
+    GpuTimer(int depth = 4);
+    //! Destructor
+    /*! Deletes the query objects. */
+    ~GpuTimer();
+
+    //! begin
+    /*! Starts timing, tag is handed back by poll(). Returns false if all queries are still in flight. */
+    bool begin(int tag);
+
+    //! end
+    /*! Stops timing the commands since begin(). */
+    void end();
+
+    //! poll
+    /*! Returns the oldest finished measurement without waiting for the GPU. */
+    bool poll(int& tag, double& milliseconds);
+
+private:
+    std::vector<GLuint> m_queries;
+    std::vector<int> m_tags;
+    int m_first;        //!< oldest query in flight
+    int m_count;        //!< queries in flight
+    bool m_active;
+};
+
+#endif
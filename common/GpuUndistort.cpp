@@ -0,0 +1,66 @@
+#include "GpuUndistort.hpp"
+
+GpuUndistort::GpuUndistort()
+    : m_target(nullptr), m_mapWidth(0), m_mapHeight(0), m_mapRevision(-1), m_mapUploads(0) {
+    m_shader = new UndistortShader("fullscreen.vert", "undistort.frag");
+    glGenTextures(1, &m_mapTextureID);
+    glBindTexture(GL_TEXTURE_2D, m_mapTextureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    m_shader->setMapTexture(m_mapTextureID);
+    glGenVertexArrays(1, &m_vertexArrayID);
+    glGenSamplers(1, &m_samplerID);
+    glSamplerParameteri(m_samplerID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glSamplerParameteri(m_samplerID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glSamplerParameteri(m_samplerID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glSamplerParameteri(m_samplerID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+GpuUndistort::~GpuUndistort() {
+    delete m_target;
+    glDeleteSamplers(1, &m_samplerID);
+    glDeleteVertexArrays(1, &m_vertexArrayID);
+    glDeleteTextures(1, &m_mapTextureID);
+    delete m_shader;
+}
+
+Texture* GpuUndistort::apply(Texture* source, int width, int height, Undistortion& lens) {
+    if (m_mapRevision != lens.getRevision() || m_mapWidth != width || m_mapHeight != height) {
+        // Offsets are small, half floats keep them to a fraction of a texel at 4K
+        const cv::Mat& offsets = lens.getOffsetMap(cv::Size(width, height));
+        glBindTexture(GL_TEXTURE_2D, m_mapTextureID);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, width, height, 0, GL_RG, GL_FLOAT, offsets.data);
+        m_mapWidth = width;
+        m_mapHeight = height;
+        m_mapRevision = lens.getRevision();
+        m_mapUploads++;
+    }
+    if (m_target == nullptr)
+        m_target = new RenderTarget(width, height, false);
+    m_target->resize(width, height);
+
+    GLint viewport[4];
+    GLint vertexArray = 0;
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertexArray);
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glBindVertexArray(m_vertexArrayID);
+    glBindSampler(0, m_samplerID);
+    glDisable(GL_DEPTH_TEST);
+
+    m_target->bind();
+    m_shader->setTexture(source);
+    m_shader->bind();
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    RenderTarget::unbind();
+    glBindSampler(0, 0);
+    if (depthTest)
+        glEnable(GL_DEPTH_TEST);
+    glBindVertexArray(vertexArray);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    return m_target->getTexture();
+}
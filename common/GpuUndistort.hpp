@@ -0,0 +1,55 @@
+/*
+ * GpuUndistort.hpp
+ *
+ *  Lens correction on the GPU: one offscreen pass that gathers the video texture through a
+ *  displacement map built from the calibration.
+ *
+ */
+#ifndef GPUUNDISTORT_HPP
+#define GPUUNDISTORT_HPP
+
+#include <glad/gl.h>
+
+#include "Texture.hpp"
+#include "RenderTarget.hpp"
+#include "UndistortShader.hpp"
+#include "Undistortion.hpp"
+
+//!  GpuUndistort.
+/*!
+ Renders the corrected frame into a render target of the frame size, so the filter shaders
+ sample it like the video texture. The displacement map (GL_RG16F, linear filtering) is only
+ uploaded again when the calibration or the frame size changed.
+ */
+class GpuUndistort {
+public:
+    //! Constructor
+    /*! Loads fullscreen.vert / undistort.frag, needs a current GL context. */
+    GpuUndistort();
+    //! Destructor
+    /*! Deletes target, map texture, sampler and vertex array. */
+    ~GpuUndistort();
+
+    //! apply
+    /*! Corrects source (width x height texels, bottom row first) with the calibration in lens.
+        Restores the default framebuffer, viewport, depth test and vertex array afterwards. The
+        returned texture is owned by the GpuUndistort and stays valid until the next call. */
+    Texture* apply(Texture* source, int width, int height, Undistortion& lens);
+
+    //! getMapUploads
+    /*! Number of displacement map uploads, for statistics. */
+    int getMapUploads() const { return m_mapUploads; }
+
+private:
+    UndistortShader* m_shader;
+    RenderTarget* m_target;
+    GLuint m_mapTextureID;
+    GLuint m_vertexArrayID;     //!< empty, the fullscreen triangle has no attributes
+    GLuint m_samplerID;         //!< clamps edges, the video texture itself repeats
+    int m_mapWidth;
+    int m_mapHeight;
+    int m_mapRevision;          //!< -1 before the first upload
+    int m_mapUploads;
+};
+
+#endif
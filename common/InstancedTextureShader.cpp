@@ -0,0 +1,9 @@
+#include "InstancedTextureShader.hpp"
+
+InstancedTextureShader::InstancedTextureShader(std::string fragmentShaderName)
+    : TextureShader("instancedTexture.vert", fragmentShaderName) {
+    // Without the VP uniform the queue would fall back to one MVP draw per object
+    if (!isInstanced()) {
+        printf("Warning: Could not find 'VP' uniform in instanced texture shader\n");
+    }
+}
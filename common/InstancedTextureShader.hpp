@@ -0,0 +1,14 @@
+#ifndef INSTANCED_TEXTURE_SHADER_HPP
+#define INSTANCED_TEXTURE_SHADER_HPP
+
+#include "TextureShader.hpp"
+#include <string>
+
+// Texture shader built on instancedTexture.vert: takes VP plus a per instance model matrix,
+// so the RenderQueue draws all objects sharing it and their geometry in one call
+class InstancedTextureShader : public TextureShader {
+public:
+    InstancedTextureShader(std::string fragmentShaderName = "videoTextureShader.frag");
+};
+
+#endif // INSTANCED_TEXTURE_SHADER_HPP
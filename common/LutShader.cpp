@@ -0,0 +1,43 @@
+#include "LutShader.hpp"
+#include <stdio.h>
+
+LutShader::LutShader(std::string vertexShaderName, std::string fragmentShaderName)
+    : TextureShader(vertexShaderName, fragmentShaderName), lutTextureID(0), lutSize(0) {
+    lutSamplerLocation = glGetUniformLocation(programID, "colorTable");
+    lutSizeLocation = glGetUniformLocation(programID, "lutSize");
+
+    if (lutSamplerLocation == -1) {
+        printf("Warning: Could not find 'colorTable' uniform in LUT shader\n");
+    }
+}
+
+LutShader::~LutShader() {
+    if (lutTextureID)
+        glDeleteTextures(1, &lutTextureID);
+}
+
+void LutShader::setLut(const ColorLUT& lut) {
+    if (lut.isEmpty())
+        return;
+    if (!lutTextureID)
+        glGenTextures(1, &lutTextureID);
+    lutSize = lut.getSize();
+    glBindTexture(GL_TEXTURE_3D, lutTextureID);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB16F, lutSize, lutSize, lutSize, 0, GL_RGB, GL_FLOAT, lut.getTable().data());
+    glBindTexture(GL_TEXTURE_3D, 0);
+}
+
+void LutShader::bind() {
+    TextureShader::bind();
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_3D, lutTextureID);
+    glActiveTexture(GL_TEXTURE0);
+    glUniform1i(lutSamplerLocation, 1);
+    glUniform1f(lutSizeLocation, (float)lutSize);
+}
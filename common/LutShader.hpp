@@ -0,0 +1,31 @@
+#ifndef LUT_SHADER_HPP
+#define LUT_SHADER_HPP
+
+#include "TextureShader.hpp"
+#include "ColorLUT.hpp"
+#include <string>
+
+//!  LutShader.
+/*!
+ Colour grading through a 3D lookup table (colorLUT.frag). The table lives in a GL_TEXTURE_3D
+ on unit 1 with r along the width, sampled with hardware trilinear filtering.
+ */
+class LutShader : public TextureShader {
+private:
+    GLint lutSamplerLocation;
+    GLint lutSizeLocation;
+    GLuint lutTextureID;
+    int lutSize;
+
+public:
+    LutShader(std::string vertexShaderName, std::string fragmentShaderName);
+    ~LutShader();
+
+    //! setLut
+    /*! Uploads the table as GL_RGB16F, replacing the previous one. */
+    void setLut(const ColorLUT& lut);
+
+    void bind() override;
+};
+
+#endif // LUT_SHADER_HPP
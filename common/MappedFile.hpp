@@ -0,0 +1,65 @@
+/*
+ * MappedFile.hpp
+ *
+ *  Read-only memory mapping of a whole file. Used by the binary asset loaders
+ *  so that data can be handed to OpenGL straight from the page cache.
+ *
+ */
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <stddef.h>
+#include <string>
+
+//!  MappedFile.
+/*!
+ Maps a file read-only into the address space. The mapping is released when the object is destroyed.
+ */
+class MappedFile {
+public:
+    //! Default constructor
+    /*! Creates an empty (unmapped) object. */
+    MappedFile();
+    //! Constructor
+    /*! Maps the given file, check isOpen() for success. */
+    MappedFile(const std::string& path);
+    //! Destructor
+    /*! Unmaps the file. */
+    ~MappedFile();
+
+    //! open
+    /*! Maps the given file. Returns false if the file could not be opened or is empty. */
+    bool open(const std::string& path);
+    //! close
+    /*! Releases the mapping. */
+    void close();
+
+    //! isOpen
+    /*! True if a file is currently mapped. */
+    bool isOpen() const { return m_data != nullptr; }
+    //! data
+    /*! Start of the mapped bytes. */
+    const unsigned char* data() const { return m_data; }
+    //! size
+    /*! Size of the mapped file in bytes. */
+    size_t size() const { return m_size; }
+
+    //! prefetch
+    /*! Asks the OS to start reading a range into the page cache, e.g. the next frames of a replay. Does not wait. */
+    void prefetch(size_t offset, size_t length) const;
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    unsigned char* m_data;  //!< start of the mapping
+    size_t m_size;          //!< size of the mapping in bytes
+#ifdef _WIN32
+    void* m_file;           //!< file handle
+    void* m_mapping;        //!< file mapping handle
+#else
+    int m_fd;               //!< file descriptor
+#endif
+};
+
+#endif
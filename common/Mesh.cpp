@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stddef.h>
+#include <map>
+
+#include "Mesh.hpp"
+#include "MeshFile.hpp"
+#include "MappedFile.hpp"
+
+// Meshes loaded from the same file share their buffers, so the RenderQueue can draw them instanced
+struct SharedMeshBuffers {
+    GLuint vertexbuffer;
+    GLuint elementbuffer;
+    GLsizei indexCount;
+    GLenum indexType;
+    int users;
+};
+static std::map<std::string, SharedMeshBuffers> sharedMeshBuffers;
+
+Mesh::Mesh() : vertexbuffer(0), elementbuffer(0), indexCount(0), indexType(GL_UNSIGNED_SHORT) {
+}
+
+Mesh::Mesh(std::string filename) : Mesh() {
+    loadMeshFile(filename);
+}
+
+Mesh::~Mesh(){
+    // Cleanup VBOs once the last mesh using them is gone
+    releaseBuffers();
+}
+
+void Mesh::releaseBuffers(){
+    if (!vertexbuffer)
+        return;
+    std::map<std::string, SharedMeshBuffers>::iterator shared = sharedMeshBuffers.find(filename);
+    if (shared != sharedMeshBuffers.end() && --shared->second.users == 0) {
+        glDeleteBuffers(1, &shared->second.vertexbuffer);
+        glDeleteBuffers(1, &shared->second.elementbuffer);
+        sharedMeshBuffers.erase(shared);
+    }
+    vertexbuffer = 0;
+    elementbuffer = 0;
+    indexCount = 0;
+}
+
+bool Mesh::loadMeshFile(std::string filename){
+    releaseBuffers();
+    std::map<std::string, SharedMeshBuffers>::iterator shared = sharedMeshBuffers.find(filename);
+    if (shared != sharedMeshBuffers.end()) {
+        shared->second.users++;
+        vertexbuffer = shared->second.vertexbuffer;
+        elementbuffer = shared->second.elementbuffer;
+        indexCount = shared->second.indexCount;
+        indexType = shared->second.indexType;
+        this->filename = filename;
+        return true;
+    }
+
+    printf("Reading mesh %s\n", filename.c_str());
+
+    MappedFile file(filename);
+    const MeshFileHeader* header = MeshFile::validate(file);
+    if (!header)
+        return false;
+
+    glGenBuffers(1, &vertexbuffer);
+    glGenBuffers(1, &elementbuffer);
+
+    // Upload straight from the mapping, the driver copies the pages it needs
+    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)header->vertexCount * header->vertexStride,
+                 file.data() + header->vertexOffset, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementbuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)header->indexCount * header->indexSize,
+                 file.data() + header->indexOffset, GL_STATIC_DRAW);
+
+    indexCount = (GLsizei)header->indexCount;
+    indexType = header->indexSize == 4 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    this->filename = filename;
+    SharedMeshBuffers entry = { vertexbuffer, elementbuffer, indexCount, indexType, 1 };
+    sharedMeshBuffers[filename] = entry;
+
+    printf("Loaded mesh with %u vertices and %u triangles\n", header->vertexCount, header->indexCount / 3);
+    return true;
+}
+
+void Mesh::render(Camera* camera){
+    bindShaders();
+    // Model matrix and MVP are cached until object or camera move
+    shader->updateMVP(getMVP(camera));
+
+    directRender();
+}
+
+void Mesh::directRender(){
+    if (indexCount == 0)
+        return;
+
+    bindGeometry();
+    glDrawElements(GL_TRIANGLES, indexCount, indexType, (void*)0);
+    unbindGeometry();
+}
+
+GLuint Mesh::getGeometryID(){
+    return indexCount > 0 ? vertexbuffer : 0;
+}
+
+void Mesh::bindGeometry(){
+    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer);
+    // 1rst attribute buffer : vertices
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshFileVertex),
+                          (void*)offsetof(MeshFileVertex, position));
+    // 2nd attribute buffer : UVs
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(MeshFileVertex),
+                          (void*)offsetof(MeshFileVertex, uv));
+    // 3rd attribute buffer : normals
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(MeshFileVertex),
+                          (void*)offsetof(MeshFileVertex, normal));
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementbuffer);
+}
+
+void Mesh::drawGeometry(GLsizei instanceCount){
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, indexType, (void*)0, instanceCount);
+}
+
+void Mesh::unbindGeometry(){
+    glDisableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
+    glDisableVertexAttribArray(2);
+}
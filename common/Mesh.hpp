@@ -0,0 +1,69 @@
+/*
+ * Mesh.hpp
+ *
+ *  Class for an indexed triangle mesh loaded from a binary .vcmesh file.
+ *
+ */
+#ifndef MESH_HPP
+#define MESH_HPP
+
+#include <string>
+
+#include "Object.hpp"
+
+//!  Mesh.
+/*!
+ Indexed mesh with interleaved position, uv and normal attributes. The buffers are filled
+ directly from a memory mapping of the mesh file, see MeshFile.hpp for the layout.
+ */
+class Mesh: public Object{
+
+    public:
+        //! Default constructor
+        /*! Creates an empty mesh. */
+        Mesh();
+        //! Constructor
+        /*! Loads the mesh from a .vcmesh file. */
+        Mesh(std::string filename);
+        //! Destructor
+        /*! Delete mesh buffers. */
+        ~Mesh();
+        //! loadMeshFile
+        /*! Maps a .vcmesh file and uploads it into the vertex and index buffers. A file that
+            is already loaded by another mesh is not read again, its buffers are shared. */
+        bool loadMeshFile(std::string filename);
+        //! isLoaded
+        /*! True if geometry has been uploaded. */
+        bool isLoaded() const { return indexCount > 0; }
+        //! render
+        /*! Render the mesh with its own shader. */
+        void render(Camera* camera);
+        //! directRender
+        /*! Direct rendering function that doesnt take camera into account. */
+        void directRender();
+        //! getGeometryID
+        /*! Vertex buffer of the mesh, 0 while nothing is loaded. */
+        GLuint getGeometryID();
+        //! bindGeometry
+        /*! Binds the interleaved attribute layout (locations 0-2) and the index buffer. */
+        void bindGeometry();
+        //! drawGeometry
+        /*! Issues the indexed draw for instanceCount instances. */
+        void drawGeometry(GLsizei instanceCount);
+        //! unbindGeometry
+        /*! Disables the attributes enabled by bindGeometry(). */
+        void unbindGeometry();
+
+    private:
+        //! releaseBuffers
+        /*! Drop this mesh's reference to the shared buffers. */
+        void releaseBuffers();
+
+        std::string filename;   //!< key of the shared buffers
+        GLuint vertexbuffer;
+        GLuint elementbuffer;
+        GLsizei indexCount;
+        GLenum indexType;
+};
+
+#endif
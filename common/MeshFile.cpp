@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "MeshFile.hpp"
+#include "MappedFile.hpp"
+
+static uint64_t alignUp(uint64_t value) {
+    return (value + MESHFILE_ALIGNMENT - 1) & ~(uint64_t)(MESHFILE_ALIGNMENT - 1);
+}
+
+static bool writePadding(FILE* file, uint64_t from, uint64_t to) {
+    static const unsigned char zeros[MESHFILE_ALIGNMENT] = { 0 };
+    return to == from || fwrite(zeros, 1, (size_t)(to - from), file) == (size_t)(to - from);
+}
+
+bool MeshFile::write(const std::string& path,
+                     const std::vector<unsigned short>& indices,
+                     const std::vector<glm::vec3>& vertices,
+                     const std::vector<glm::vec2>& uvs,
+                     const std::vector<glm::vec3>& normals) {
+    return write(path, indices.empty() ? nullptr : indices.data(), indices.size(), sizeof(unsigned short),
+                 vertices, uvs, normals);
+}
+
+bool MeshFile::write(const std::string& path,
+                     const std::vector<unsigned int>& indices,
+                     const std::vector<glm::vec3>& vertices,
+                     const std::vector<glm::vec2>& uvs,
+                     const std::vector<glm::vec3>& normals) {
+    return write(path, indices.empty() ? nullptr : indices.data(), indices.size(), sizeof(unsigned int),
+                 vertices, uvs, normals);
+}
+
+bool MeshFile::write(const std::string& path, const void* indices, size_t indexCount, uint32_t indexSize,
+                     const std::vector<glm::vec3>& vertices,
+                     const std::vector<glm::vec2>& uvs,
+                     const std::vector<glm::vec3>& normals) {
+    if (uvs.size() != vertices.size() || normals.size() != vertices.size()) {
+        printf("Mesh attribute counts do not match\n");
+        return false;
+    }
+
+    MeshFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MESHFILE_MAGIC, 4);
+    header.version = MESHFILE_VERSION;
+    header.vertexCount = (uint32_t)vertices.size();
+    header.indexCount = (uint32_t)indexCount;
+    header.vertexStride = sizeof(MeshFileVertex);
+    header.indexSize = indexSize;
+    header.vertexOffset = alignUp(sizeof(MeshFileHeader));
+    header.indexOffset = alignUp(header.vertexOffset + (uint64_t)header.vertexCount * header.vertexStride);
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        printf("%s could not be opened for writing.\n", path.c_str());
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && writePadding(file, sizeof(header), header.vertexOffset);
+
+    // Interleave position, uv and normal so the blob can be uploaded as-is
+    std::vector<MeshFileVertex> interleaved(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        MeshFileVertex& v = interleaved[i];
+        v.position[0] = vertices[i].x; v.position[1] = vertices[i].y; v.position[2] = vertices[i].z;
+        v.uv[0] = uvs[i].x;            v.uv[1] = uvs[i].y;
+        v.normal[0] = normals[i].x;    v.normal[1] = normals[i].y;    v.normal[2] = normals[i].z;
+    }
+    if (!interleaved.empty())
+        ok = ok && fwrite(interleaved.data(), sizeof(MeshFileVertex), interleaved.size(), file) == interleaved.size();
+
+    ok = ok && writePadding(file, header.vertexOffset + (uint64_t)header.vertexCount * header.vertexStride,
+                            header.indexOffset);
+    if (indexCount > 0)
+        ok = ok && fwrite(indices, indexSize, indexCount, file) == indexCount;
+
+    fclose(file);
+    if (!ok)
+        printf("Failed writing %s\n", path.c_str());
+    return ok;
+}
+
+const MeshFileHeader* MeshFile::validate(const MappedFile& file) {
+    if (!file.isOpen() || file.size() < sizeof(MeshFileHeader)) {
+        printf("Not a correct mesh file\n");
+        return nullptr;
+    }
+
+    const MeshFileHeader* header = reinterpret_cast<const MeshFileHeader*>(file.data());
+    if (memcmp(header->magic, MESHFILE_MAGIC, 4) != 0 || header->version != MESHFILE_VERSION) {
+        printf("Not a correct mesh file\n");
+        return nullptr;
+    }
+    if (header->vertexStride != sizeof(MeshFileVertex) ||
+        (header->indexSize != 2 && header->indexSize != 4)) {
+        printf("Unsupported mesh layout\n");
+        return nullptr;
+    }
+
+    // Offsets come from the file: compare against the remaining space so corrupt values cannot wrap
+    uint64_t size = file.size();
+    uint64_t vertexBytes = (uint64_t)header->vertexCount * header->vertexStride;
+    uint64_t indexBytes = (uint64_t)header->indexCount * header->indexSize;
+    if (header->vertexOffset < sizeof(MeshFileHeader) || header->indexOffset > size ||
+        header->vertexOffset > header->indexOffset ||
+        vertexBytes > header->indexOffset - header->vertexOffset ||
+        indexBytes > size - header->indexOffset) {
+        printf("Mesh file is truncated\n");
+        return nullptr;
+    }
+
+    // An index past the vertex blob would make the draw read past the end of the VBO
+    const unsigned char* indices = file.data() + header->indexOffset;
+    for (uint32_t i = 0; i < header->indexCount; i++) {
+        uint32_t index;
+        if (header->indexSize == 2) {
+            uint16_t value;
+            memcpy(&value, indices + (size_t)i * 2, 2);
+            index = value;
+        } else {
+            memcpy(&index, indices + (size_t)i * 4, 4);
+        }
+        if (index >= header->vertexCount) {
+            printf("Mesh file has an index out of range\n");
+            return nullptr;
+        }
+    }
+    return header;
+}
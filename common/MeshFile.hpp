@@ -0,0 +1,84 @@
+/*
+ * MeshFile.hpp
+ *
+ *  Compact binary mesh container (.vcmesh). The file is a fixed header followed by
+ *  an interleaved vertex blob and an index blob, each aligned so it can be passed
+ *  to glBufferData directly from a memory mapping.
+ *
+ *  Layout:
+ *    MeshFileHeader
+ *    padding up to vertexOffset
+ *    vertexCount * { vec3 position, vec2 uv, vec3 normal }
+ *    padding up to indexOffset
+ *    indexCount * index (indexSize bytes each)
+ *
+ */
+#ifndef MESHFILE_HPP
+#define MESHFILE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class MappedFile;
+
+#define MESHFILE_MAGIC "VCMB"
+#define MESHFILE_VERSION 1
+#define MESHFILE_ALIGNMENT 64
+
+//! Header at the start of every .vcmesh file, stored little-endian.
+struct MeshFileHeader {
+    char magic[4];          //!< "VCMB"
+    uint32_t version;       //!< MESHFILE_VERSION
+    uint32_t vertexCount;   //!< number of interleaved vertices
+    uint32_t indexCount;    //!< number of indices (3 per triangle)
+    uint32_t vertexStride;  //!< bytes per interleaved vertex
+    uint32_t indexSize;     //!< bytes per index, 2 or 4
+    uint64_t vertexOffset;  //!< file offset of the vertex blob
+    uint64_t indexOffset;   //!< file offset of the index blob
+};
+
+//! Interleaved vertex as stored in the vertex blob.
+struct MeshFileVertex {
+    float position[3];
+    float uv[2];
+    float normal[3];
+};
+
+//!  MeshFile.
+/*!
+ Reading and writing of the binary mesh container.
+ */
+class MeshFile {
+public:
+    //! write
+    /*! Writes indexed geometry (as produced by indexVBO) to a .vcmesh file with 16 bit indices. */
+    static bool write(const std::string& path,
+                      const std::vector<unsigned short>& indices,
+                      const std::vector<glm::vec3>& vertices,
+                      const std::vector<glm::vec2>& uvs,
+                      const std::vector<glm::vec3>& normals);
+
+    //! write
+    /*! Same with 32 bit indices (indexSize 4), for meshes with more than 65536 vertices. */
+    static bool write(const std::string& path,
+                      const std::vector<unsigned int>& indices,
+                      const std::vector<glm::vec3>& vertices,
+                      const std::vector<glm::vec2>& uvs,
+                      const std::vector<glm::vec3>& normals);
+
+    //! validate
+    /*! Checks the header of a mapped file against the real file size and every index against
+        the vertex count. Returns the header, or nullptr if the file is not a valid mesh. */
+    static const MeshFileHeader* validate(const MappedFile& file);
+
+private:
+    static bool write(const std::string& path, const void* indices, size_t indexCount, uint32_t indexSize,
+                      const std::vector<glm::vec3>& vertices,
+                      const std::vector<glm::vec2>& uvs,
+                      const std::vector<glm::vec3>& normals);
+};
+
+#endif
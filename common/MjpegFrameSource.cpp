@@ -0,0 +1,262 @@
+#include "MjpegFrameSource.hpp"
+
+#include <stdio.h>
+#include <chrono>
+#include <algorithm>
+
+// The consumer keeps its cv::Mat from read() as long as it likes; a slot buffer still referenced
+// there is left to it and the slot decodes into a new one instead of overwriting the frame in use
+static void detachIfShared(cv::Mat& image) {
+    if (image.u != nullptr && image.u->refcount > 1)
+        image.release();
+}
+
+MjpegFrameSource::MjpegFrameSource(FrameSource* compressed, int workerCount, int scale)
+    : m_source(compressed), m_scale(scale), m_width(0), m_height(0), m_imreadFlags(cv::IMREAD_COLOR),
+      m_stop(false), m_nextSequence(1), m_lastDelivered(0), m_heldSlot(-1), m_timestamp(-1.0),
+      m_dropped(0), m_decodeMs(0.0), m_decodeCount(0) {
+    if (m_scale == 2) {
+        m_imreadFlags = cv::IMREAD_REDUCED_COLOR_2;
+    } else if (m_scale == 4) {
+        m_imreadFlags = cv::IMREAD_REDUCED_COLOR_4;
+    } else {
+        m_scale = 1;
+    }
+
+    if (m_source == nullptr || !m_source->isOpened())
+        return;
+
+    // libjpeg rounds scaled sizes up
+    m_width = (m_source->getWidth() + m_scale - 1) / m_scale;
+    m_height = (m_source->getHeight() + m_scale - 1) / m_scale;
+
+    if (workerCount <= 0)
+        workerCount = std::max(1, (int)std::thread::hardware_concurrency());
+
+    // One slot per worker plus room for the frame being filled, the one held by the consumer and one spare
+    m_slots.resize(workerCount + 3);
+    for (Slot& slot : m_slots) {
+        slot.state = SlotState::FREE;
+        slot.sequence = 0;
+        slot.timestamp = -1.0;
+    }
+
+    for (int i = 0; i < workerCount; i++)
+        m_workers.push_back(std::thread(&MjpegFrameSource::decodeLoop, this));
+    m_captureThread = std::thread(&MjpegFrameSource::captureLoop, this);
+
+    printf("MJPEG: decoding on %d threads at 1/%d scale (%dx%d)\n", workerCount, m_scale, m_width, m_height);
+}
+
+MjpegFrameSource::~MjpegFrameSource() {
+    release();
+}
+
+bool MjpegFrameSource::isOpened() const {
+    return m_source != nullptr && m_source->isOpened() && !m_workers.empty();
+}
+
+int MjpegFrameSource::getWidth() const {
+    return m_width;
+}
+
+int MjpegFrameSource::getHeight() const {
+    return m_height;
+}
+
+int MjpegFrameSource::acquireSlot() {
+    int oldest = -1;
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        if (m_slots[i].state == SlotState::FREE)
+            return (int)i;
+        // Frames not yet handed out can be replaced, a newer frame makes them late anyway
+        if ((m_slots[i].state == SlotState::ENCODED || m_slots[i].state == SlotState::DECODED) &&
+            (oldest < 0 || m_slots[i].sequence < m_slots[oldest].sequence))
+            oldest = (int)i;
+    }
+    if (oldest >= 0)
+        m_dropped++;
+    return oldest;
+}
+
+void MjpegFrameSource::captureLoop() {
+    cv::Mat compressed;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop)
+                break;
+        }
+
+        if (!m_source->read(compressed)) {
+            if (!m_source->isOpened())
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+
+        double timestamp = m_source->getTimestamp();
+        if (timestamp < 0.0) // no driver timestamp, arrival time is the next best thing
+            timestamp = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        int index;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            index = acquireSlot();
+            if (index >= 0) {
+                m_slots[index].state = SlotState::FILLING;
+                m_slots[index].sequence = m_nextSequence++;
+                m_slots[index].timestamp = timestamp;
+            } else {
+                m_dropped++;
+            }
+        }
+
+        if (index >= 0) {
+            Slot& slot = m_slots[index];
+            SlotState next = SlotState::ENCODED;
+            if (compressed.rows == 1) {
+                // Copy the bitstream so the driver buffer can go straight back
+                const unsigned char* data = compressed.ptr<unsigned char>();
+                slot.jpeg.assign(data, data + compressed.total() * compressed.elemSize());
+            } else {
+                // Backend ignored the request for compressed frames and decoded already
+                detachIfShared(slot.image);
+                if (m_scale > 1)
+                    cv::resize(compressed, slot.image, cv::Size(m_width, m_height), 0, 0, cv::INTER_AREA);
+                else
+                    compressed.copyTo(slot.image);
+                next = SlotState::DECODED;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            slot.state = next;
+            if (next == SlotState::ENCODED)
+                m_encoded.notify_one();
+            else
+                m_decoded.notify_all();
+        }
+        m_source->releaseFrame();
+    }
+}
+
+void MjpegFrameSource::decodeLoop() {
+    while (true) {
+        int index = -1;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_encoded.wait(lock, [this, &index] {
+                if (m_stop)
+                    return true;
+                // Oldest first, so frames finish roughly in arrival order
+                for (size_t i = 0; i < m_slots.size(); i++) {
+                    if (m_slots[i].state == SlotState::ENCODED &&
+                        (index < 0 || m_slots[i].sequence < m_slots[index].sequence))
+                        index = (int)i;
+                }
+                return index >= 0;
+            });
+            if (m_stop)
+                return;
+            m_slots[index].state = SlotState::DECODING;
+        }
+
+        Slot& slot = m_slots[index];
+        auto start = std::chrono::steady_clock::now();
+        detachIfShared(slot.image);
+        cv::imdecode(slot.jpeg, m_imreadFlags, &slot.image);
+        double decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decodeMs += decodeMs;
+        m_decodeCount++;
+        if (slot.image.empty() || slot.sequence <= m_lastDelivered) {
+            // Corrupt frame, or a newer one was already handed out
+            slot.state = SlotState::FREE;
+            m_dropped++;
+        } else {
+            slot.state = SlotState::DECODED;
+            m_decoded.notify_all();
+        }
+    }
+}
+
+bool MjpegFrameSource::read(cv::Mat& frame) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_heldSlot >= 0) {
+        m_slots[m_heldSlot].state = SlotState::FREE;
+        m_heldSlot = -1;
+    }
+
+    int newest = -1;
+    bool ready = m_decoded.wait_for(lock, std::chrono::seconds(1), [this, &newest] {
+        for (size_t i = 0; i < m_slots.size(); i++) {
+            if (m_slots[i].state == SlotState::DECODED &&
+                (newest < 0 || m_slots[i].sequence > m_slots[newest].sequence))
+                newest = (int)i;
+        }
+        return newest >= 0 || m_stop;
+    });
+    if (!ready || newest < 0)
+        return false;
+
+    // Anything older than the frame handed out now would only arrive late
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        if (m_slots[i].state == SlotState::DECODED && (int)i != newest) {
+            m_slots[i].state = SlotState::FREE;
+            m_dropped++;
+        }
+    }
+
+    Slot& slot = m_slots[newest];
+    slot.state = SlotState::HELD;
+    m_heldSlot = newest;
+    m_lastDelivered = slot.sequence;
+    m_timestamp = slot.timestamp;
+    frame = slot.image;
+    return true;
+}
+
+void MjpegFrameSource::releaseFrame() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_heldSlot >= 0) {
+        m_slots[m_heldSlot].state = SlotState::FREE;
+        m_heldSlot = -1;
+    }
+}
+
+uint64_t MjpegFrameSource::getDroppedCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+double MjpegFrameSource::takeAverageDecodeMs() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    double average = m_decodeCount > 0 ? m_decodeMs / m_decodeCount : 0.0;
+    m_decodeMs = 0.0;
+    m_decodeCount = 0;
+    return average;
+}
+
+void MjpegFrameSource::release() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_encoded.notify_all();
+    m_decoded.notify_all();
+
+    if (m_captureThread.joinable())
+        m_captureThread.join();
+    for (std::thread& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+
+    if (m_source != nullptr) {
+        m_source->release();
+        delete m_source;
+        m_source = nullptr;
+    }
+    m_slots.clear();
+    m_heldSlot = -1;
+}
@@ -0,0 +1,95 @@
+#ifndef MJPEGFRAMESOURCE_HPP
+#define MJPEGFRAMESOURCE_HPP
+
+#include "FrameSource.hpp"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdint.h>
+
+/**
+ * MjpegFrameSource - Decodes a compressed MJPEG stream on a pool of worker threads.
+ *
+ * A capture thread pulls JPEG bitstreams from another FrameSource (OpenCV with
+ * CAP_PROP_FORMAT = -1, or V4L2 in MJPEG mode), copies them into pooled slots and
+ * returns the driver buffer immediately. Workers decode the slots with cv::imdecode
+ * into pooled BGR images, optionally at 1/2 or 1/4 scale (the reduction happens in
+ * the IDCT, so it is much cheaper than decoding at full size and resizing).
+ *
+ * Frames are numbered on arrival. read() always hands out the newest decoded frame;
+ * older frames that finish later are dropped, so output order never goes backwards
+ * and a slow consumer sees the latest picture instead of a growing backlog.
+ */
+class MjpegFrameSource : public FrameSource {
+public:
+    /**
+     * Start the capture thread and decode workers
+     * @param compressed Source delivering one JPEG bitstream per read() (1 x N CV_8UC1); ownership is taken
+     * @param workerCount Number of decode threads, 0 uses all hardware threads
+     * @param scale Decode scale divisor: 1, 2 or 4
+     */
+    MjpegFrameSource(FrameSource* compressed, int workerCount = 0, int scale = 1);
+    ~MjpegFrameSource();
+
+    bool isOpened() const override;
+    bool read(cv::Mat& frame) override;
+    void releaseFrame() override;
+    double getTimestamp() const override { return m_timestamp; }
+    int getWidth() const override;
+    int getHeight() const override;
+    void release() override;
+
+    /**
+     * Number of frames dropped because a newer one was decoded first or no slot was free
+     */
+    uint64_t getDroppedCount();
+
+    /**
+     * Average decode time per frame since the last call, in milliseconds
+     */
+    double takeAverageDecodeMs();
+
+private:
+    enum class SlotState { FREE, FILLING, ENCODED, DECODING, DECODED, HELD };
+
+    struct Slot {
+        SlotState state;
+        uint64_t sequence;          //!< arrival order of the frame in this slot
+        double timestamp;
+        std::vector<unsigned char> jpeg;
+        cv::Mat image;              //!< reused between frames of the same size unless the consumer still holds it
+    };
+
+    //! Capture thread main loop
+    void captureLoop();
+    //! Decode worker main loop
+    void decodeLoop();
+    //! Pick a slot for an incoming frame, evicting the oldest undelivered one if needed. Caller holds m_mutex.
+    int acquireSlot();
+
+    FrameSource* m_source;
+    int m_scale;
+    int m_width;                        //!< output size after scaling
+    int m_height;
+    int m_imreadFlags;
+
+    std::vector<Slot> m_slots;
+    std::thread m_captureThread;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_encoded;  //!< signalled when a slot is ready to decode
+    std::condition_variable m_decoded;  //!< signalled when a slot has been decoded
+    bool m_stop;
+
+    uint64_t m_nextSequence;
+    uint64_t m_lastDelivered;           //!< sequence of the last frame handed out by read()
+    int m_heldSlot;                     //!< slot currently handed out by read(), -1 if none
+    double m_timestamp;
+
+    uint64_t m_dropped;
+    double m_decodeMs;
+    int m_decodeCount;
+};
+
+#endif // MJPEGFRAMESOURCE_HPP
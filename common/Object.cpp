@@ -2,6 +2,7 @@
 
 // Include GLM
 // Include GLM
+#include <math.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -14,44 +15,89 @@
 //basic object base class that has a tranformation
 Object::Object(){
     // set identity
-    // Build the model matrix -get from object
-    rotMat = glm::mat4(1.0f);
-    transMat = glm::translate(glm::mat4(1.0), glm::vec3(0.0f, 0.0f, 0.0f));
-    scaleMat = glm::scale(glm::mat4(1.0), glm::vec3(1.0f, 1.0f, 1.0f));
-    transform = transMat * rotMat * scaleMat;
+    translation = glm::vec3(0.0f, 0.0f, 0.0f);
+    rotationZ = 0.0f;
+    uniformScale = 1.0f;
+    transform = glm::mat4(1.0f);
+    transformDirty = false;
+    transformVersion = 1;
+    
+    mvpCamera = NULL;
+    mvpCameraVersion = 0;
+    mvpTransformVersion = 0;
     
     shader = NULL;
+    ownsShader = true;
     
 }
 void Object::setShader(Shader* newshader){
-    if(shader!=NULL)
+    if(shader!=NULL && ownsShader)
         delete shader;
     
     shader = newshader;
+    ownsShader = true;
     
 }
-glm::mat4 Object::getTransform(){
+void Object::setSharedShader(Shader* newshader){
+    if(shader!=NULL && ownsShader)
+        delete shader;
+    
+    shader = newshader;
+    ownsShader = false;
+}
+const glm::mat4& Object::getTransform(){
+    if (transformDirty) {
+        // T * Rz * S written out: rotation columns scaled, translation in the last column
+        float radians = glm::radians(rotationZ);
+        float c = cosf(radians) * uniformScale;
+        float s = sinf(radians) * uniformScale;
+        transform = glm::mat4(1.0f);
+        transform[0][0] = c;  transform[0][1] = s;
+        transform[1][0] = -s; transform[1][1] = c;
+        transform[2][2] = uniformScale;
+        transform[3] = glm::vec4(translation, 1.0f);
+        transformDirty = false;
+    }
     return transform;
 }
 
+const glm::mat4& Object::getMVP(Camera* camera){
+    const glm::mat4& M = getTransform();
+    if (camera != mvpCamera || camera->getVersion() != mvpCameraVersion || transformVersion != mvpTransformVersion) {
+        mvp = camera->getViewProjectionMatrix() * M;
+        mvpCamera = camera;
+        mvpCameraVersion = camera->getVersion();
+        mvpTransformVersion = transformVersion;
+    }
+    return mvp;
+}
+
 void Object::addTransform(glm::mat4 mat){
     transform = mat;
+    transformDirty = false;
+    transformVersion++;
 }
 void Object::setTranslate(glm::vec3 translateVec){
-    transMat = glm::translate(glm::mat4(1.0), translateVec);
-    // Build the model matrix -get from object
-    transform = transMat * rotMat * scaleMat;
+    if (translateVec == translation)
+        return;
+    translation = translateVec;
+    transformDirty = true;
+    transformVersion++;
 }
 void Object::setScale(float scale){
-    scaleMat = glm::scale(glm::mat4(1.0), glm::vec3(scale));
-    // Build the model matrix -get from object
-    transform = transMat * rotMat * scaleMat;
+    if (scale == uniformScale)
+        return;
+    uniformScale = scale;
+    transformDirty = true;
+    transformVersion++;
 }
 void Object::setRotate(float zDegrees){
     // Rotate around Z-axis
-    float radians = glm::radians(zDegrees);
-    rotMat = glm::rotate(glm::mat4(1.0), radians, glm::vec3(0.0f, 0.0f, 1.0f));
-    transform = transMat * rotMat * scaleMat;
+    if (zDegrees == rotationZ)
+        return;
+    rotationZ = zDegrees;
+    transformDirty = true;
+    transformVersion++;
 }
 void Object::bindShaders(){
     // Use our shader
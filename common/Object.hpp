@@ -34,32 +34,60 @@ class Object{
         /*! Delete all related ressources. */
         virtual ~Object(){
             
-            delete shader;
+            if (ownsShader)
+                delete shader;
         }
         //! setShader
         /*! Set a shader object that will be used during the rendering of this object. */
         void setShader(Shader* newshader);
+        //! setSharedShader
+        /*! Use a shader that is owned elsewhere, e.g. one shader shared by many instances of a mesh. */
+        void setSharedShader(Shader* newshader);
+        //! getShader
+        /*! Shader used by render(). */
+        Shader* getShader(){ return shader; }
         
         //! getTransform
-        /*! Get the transform matrix 4x4 of this object. */
-        glm::mat4 getTransform();
+        /*! Get the transform matrix 4x4 of this object. Recomposed only after translate, rotate or scale changed. */
+        const glm::mat4& getTransform();
+        
+        //! getMVP
+        /*! Model-view-projection matrix for a camera. Cached until the object or the camera changes. */
+        const glm::mat4& getMVP(Camera* camera);
         
         //! addTransform
-        /*! Add a transform matrix (4x4) to this object. */
+        /*! Add a transform matrix (4x4) to this object. Replaces the composed transform until translate, rotate or scale change. */
         void addTransform(glm::mat4 mat);
        
         //! render
         /*! Virtual render method, needs to be defined for each geometry class */
         virtual void render(Camera* camera)=0;
-        
+
+        //! directRender
+        /*! Draw the geometry with whatever shader is currently bound. */
+        virtual void directRender(){}
+
+        //! getGeometryID
+        /*! Identifies the vertex data for batching in the RenderQueue. 0 means the object is drawn through render(). */
+        virtual GLuint getGeometryID(){ return 0; }
+        //! bindGeometry
+        /*! Enable and bind the vertex attributes (locations 0-2) of this object. */
+        virtual void bindGeometry(){}
+        //! drawGeometry
+        /*! Issue the (instanced) draw call, geometry must be bound. */
+        virtual void drawGeometry(GLsizei instanceCount){}
+        //! unbindGeometry
+        /*! Disable the vertex attributes enabled by bindGeometry(). */
+        virtual void unbindGeometry(){}
+
         //! setTranslate
-        /*! Set defined translate this object. */
+        /*! Set defined translate this object. No-op if unchanged. */
         void setTranslate(glm::vec3 translateVec);
         //! setScale
-        /*! Set defined scale this object. */
+        /*! Set defined scale this object. No-op if unchanged. */
         void setScale(float scale);
         //! setRotate
-        /*! Set defined rotation around Z-axis*/
+        /*! Set defined rotation around Z-axis. No-op if unchanged. */
         void setRotate(float zDegrees);
         //! bindShaders
         /*! Bind shader of this object. */
@@ -70,13 +98,21 @@ class Object{
         
     private:
         std::string name;       //!< name of object
-        glm::mat4 transform;    //!< transform matrix of the object
-        glm::mat4 rotMat;       //!< rotation matrix
-        glm::mat4 transMat;     //!< translation matrix
-        glm::mat4 scaleMat;     //!< scale matrix
+        glm::vec3 translation;  //!< translation part of the transform
+        float rotationZ;        //!< rotation around Z-axis in degrees
+        float uniformScale;     //!< scale part of the transform
+        glm::mat4 transform;    //!< transform matrix of the object, valid unless transformDirty
+        bool transformDirty;    //!< translation, rotation or scale changed since the last composition
+        unsigned int transformVersion;  //!< incremented on every transform change
+        
+        glm::mat4 mvp;                  //!< cached model-view-projection matrix
+        Camera* mvpCamera;              //!< camera the cached MVP belongs to
+        unsigned int mvpCameraVersion;  //!< camera version the cached MVP was built with
+        unsigned int mvpTransformVersion;   //!< transform version the cached MVP was built with
         
     protected:
         Shader* shader;         //!< each object can have a shader
+        bool ownsShader;        //!< delete the shader with the object (false for shared shaders)
         
     
 };
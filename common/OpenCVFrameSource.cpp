@@ -0,0 +1,31 @@
+#include "OpenCVFrameSource.hpp"
+
+OpenCVFrameSource::OpenCVFrameSource(int deviceIndex) : m_capture(deviceIndex) {
+}
+
+OpenCVFrameSource::OpenCVFrameSource(const std::string& filename) : m_capture(filename) {
+}
+
+OpenCVFrameSource::~OpenCVFrameSource() {
+    release();
+}
+
+bool OpenCVFrameSource::isOpened() const {
+    return m_capture.isOpened();
+}
+
+bool OpenCVFrameSource::read(cv::Mat& frame) {
+    return m_capture.read(frame) && !frame.empty();
+}
+
+int OpenCVFrameSource::getWidth() const {
+    return (int)m_capture.get(cv::CAP_PROP_FRAME_WIDTH);
+}
+
+int OpenCVFrameSource::getHeight() const {
+    return (int)m_capture.get(cv::CAP_PROP_FRAME_HEIGHT);
+}
+
+void OpenCVFrameSource::release() {
+    m_capture.release();
+}
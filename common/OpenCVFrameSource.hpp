@@ -0,0 +1,42 @@
+#ifndef OPENCVFRAMESOURCE_HPP
+#define OPENCVFRAMESOURCE_HPP
+
+#include "FrameSource.hpp"
+
+/**
+ * OpenCVFrameSource - FrameSource backed by cv::VideoCapture (camera index or file/URL).
+ * Frames are owned by OpenCV, releaseFrame() is a no-op.
+ */
+class OpenCVFrameSource : public FrameSource {
+public:
+    /**
+     * Open a camera by index
+     * @param deviceIndex Camera index as used by cv::VideoCapture
+     */
+    OpenCVFrameSource(int deviceIndex);
+
+    /**
+     * Open a video file or stream URL
+     * @param filename Path or URL
+     */
+    OpenCVFrameSource(const std::string& filename);
+
+    ~OpenCVFrameSource();
+
+    bool isOpened() const override;
+    bool read(cv::Mat& frame) override;
+    int getWidth() const override;
+    int getHeight() const override;
+    void release() override;
+
+    /**
+     * Access the underlying capture to set backend properties
+     * @return The wrapped cv::VideoCapture
+     */
+    cv::VideoCapture& getCapture() { return m_capture; }
+
+private:
+    cv::VideoCapture m_capture;
+};
+
+#endif // OPENCVFRAMESOURCE_HPP
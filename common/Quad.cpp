@@ -1,22 +1,43 @@
+#include <map>
+
 #include "Quad.hpp"
 
+// Quads of the same aspect ratio share one vertex buffer, which is what lets the
+// RenderQueue merge them into a single instanced draw
+struct SharedQuadBuffer {
+    GLuint buffer;
+    int users;
+};
+static std::map<float, SharedQuadBuffer> sharedQuadBuffers;
+
 // Default constructor: creates a 1:1 aspect ratio quad
-Quad::Quad(){
+Quad::Quad(): vertexbuffer(0), aspect(0.0f){
     init(1.0f); // Default to a square
 };
 
 // Overloaded constructor that takes an aspect ratio
-Quad::Quad(float aspectRatio){
+Quad::Quad(float aspectRatio): vertexbuffer(0), aspect(0.0f){
     init(aspectRatio);
 };
 
 
 Quad::~Quad(){
-    // Cleanup VBO
-    glDeleteBuffers(1, &vertexbuffer);
+    // Cleanup VBO once the last quad using it is gone
+    releaseBuffer();
     
 };
 
+void Quad::releaseBuffer(){
+    if (!vertexbuffer)
+        return;
+    std::map<float, SharedQuadBuffer>::iterator shared = sharedQuadBuffers.find(aspect);
+    if (shared != sharedQuadBuffers.end() && --shared->second.users == 0) {
+        glDeleteBuffers(1, &shared->second.buffer);
+        sharedQuadBuffers.erase(shared);
+    }
+    vertexbuffer = 0;
+}
+
 
 // init  takes an aspect ratio to define the quad's shape
 void Quad::init(float aspectRatio){
@@ -36,21 +57,28 @@ void Quad::init(float aspectRatio){
     g_vertex_buffer_data[15] =  width; g_vertex_buffer_data[16] =  height; g_vertex_buffer_data[17] = 0.0f;
     
     
+    releaseBuffer();
+    aspect = aspectRatio;
+    std::map<float, SharedQuadBuffer>::iterator shared = sharedQuadBuffers.find(aspect);
+    if (shared != sharedQuadBuffers.end()) {
+        shared->second.users++;
+        vertexbuffer = shared->second.buffer;
+        return;
+    }
     glGenBuffers(1, &vertexbuffer);
     glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer);
     glBufferData(GL_ARRAY_BUFFER, sizeof(g_vertex_buffer_data), g_vertex_buffer_data, GL_STATIC_DRAW);
+    SharedQuadBuffer entry = { vertexbuffer, 1 };
+    sharedQuadBuffers[aspect] = entry;
     
 }
 
 // render() and directRender() are unchanged
 void Quad::render(Camera* camera){
     bindShaders();
-    // Build the model matrix -get from object
-    glm::mat4 ModelMatrix = this->getTransform();
-    glm::mat4 MVP = camera->getViewProjectionMatrix() * ModelMatrix;
     // Send our transformation to the currently bound shader,
-    // in the "MVP" uniform
-    shader->updateMVP(MVP);
+    // in the "MVP" uniform (cached until object or camera move)
+    shader->updateMVP(getMVP(camera));
     
     
     // 1rst attribute buffer : vertices
@@ -71,6 +99,24 @@ void Quad::render(Camera* camera){
     
 }
 
+GLuint Quad::getGeometryID(){
+    return vertexbuffer;
+}
+
+void Quad::bindGeometry(){
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+}
+
+void Quad::drawGeometry(GLsizei instanceCount){
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, instanceCount);
+}
+
+void Quad::unbindGeometry(){
+    glDisableVertexAttribArray(0);
+}
+
 void Quad::directRender(){
 // 1rst attribute buffer : vertices
     glEnableVertexAttribArray(0);
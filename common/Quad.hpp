@@ -33,7 +33,7 @@ class Quad:  public Object{
         /*! Delete quad. */
         ~Quad();
         //! init
-        /*! Setting up default quad. */
+        /*! Setting up default quad. Quads with the same aspect ratio share one vertex buffer. */
         void init(float aspectRatio);
         //! render
         /*! Render default quad. */
@@ -41,13 +41,29 @@ class Quad:  public Object{
         //! directRender
         /*! Direct rendering function that doesnt take camera into account. */
         void directRender();
+        //! getGeometryID
+        /*! Vertex buffer of the quad, the same for all quads of one aspect ratio. */
+        GLuint getGeometryID();
+        //! bindGeometry
+        /*! Bind the position attribute (location 0). */
+        void bindGeometry();
+        //! drawGeometry
+        /*! Draw instanceCount copies of the quad. */
+        void drawGeometry(GLsizei instanceCount);
+        //! unbindGeometry
+        /*! Disable the position attribute. */
+        void unbindGeometry();
     
     
     private:
+        //! releaseBuffer
+        /*! Drop this quad's reference to the shared vertex buffer. */
+        void releaseBuffer();
         
         GLfloat g_vertex_buffer_data[18];
         GLuint uvbuffer;
         GLuint vertexbuffer;
+        float aspect;   //!< key of the shared vertex buffer
     
 };
 
@@ -0,0 +1,64 @@
+/*
+ * RawFrameFile.hpp
+ *
+ *  Raw frame container (.vcraw) for recording camera input and replaying it without decoding.
+ *  A recording is a series of segments <base>.000.vcraw, <base>.001.vcraw, ... so no single
+ *  file grows without bound; a new segment also starts when the frame format changes.
+ *
+ *  Segment layout:
+ *    RawFrameHeader
+ *    padding up to RAWFRAME_ALIGNMENT
+ *    frames, each starting on a RAWFRAME_ALIGNMENT boundary
+ *    frameCount * RawFrameIndexEntry at indexOffset
+ *
+ *  Uncompressed frames are height rows of stride bytes, so they can be used in place from a
+ *  memory mapping. LZ4 frames hold the same bytes compressed as one block.
+ *
+ */
+#ifndef RAWFRAMEFILE_HPP
+#define RAWFRAMEFILE_HPP
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+#define RAWFRAME_MAGIC "VCRF"
+#define RAWFRAME_VERSION 1
+#define RAWFRAME_ALIGNMENT 4096     // page size, frames map to whole pages
+#define RAWFRAME_EXTENSION ".vcraw"
+
+//! Frame compression stored in RawFrameHeader::compression.
+enum RawFrameCompression {
+    RAWFRAME_UNCOMPRESSED = 0,
+    RAWFRAME_LZ4 = 1
+};
+
+//! Header at the start of every segment, stored little-endian. indexOffset is 0 while the segment is written.
+struct RawFrameHeader {
+    char magic[4];          //!< "VCRF"
+    uint32_t version;       //!< RAWFRAME_VERSION
+    uint32_t width;
+    uint32_t height;
+    int32_t type;           //!< OpenCV type of the frames, e.g. CV_8UC3
+    uint32_t stride;        //!< bytes per row, a multiple of 64
+    uint32_t compression;   //!< RawFrameCompression
+    uint32_t frameCount;
+    uint64_t indexOffset;   //!< file offset of the frame index
+};
+
+//! One frame in the index at the end of a segment.
+struct RawFrameIndexEntry {
+    uint64_t offset;        //!< file offset of the frame data
+    uint32_t size;          //!< stored bytes (height * stride if uncompressed)
+    uint32_t reserved;
+    double timestamp;       //!< capture time in seconds, negative if unknown
+};
+
+//! Path of segment number index of a recording.
+inline std::string rawFrameSegmentPath(const std::string& basePath, int index) {
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), ".%03d", index);
+    return basePath + suffix + RAWFRAME_EXTENSION;
+}
+
+#endif
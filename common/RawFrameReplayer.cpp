@@ -0,0 +1,183 @@
+#include "RawFrameReplayer.hpp"
+
+#include <string.h>
+#include <thread>
+
+#ifdef VC_HAVE_LZ4
+#include <lz4.h>
+#endif
+
+// Frames prefetched ahead of the one being read
+static const int PREFETCH_FRAMES = 4;
+
+RawFrameReplayer::RawFrameReplayer(const std::string& path, bool loop)
+    : m_frameCount(0), m_position(0), m_loop(loop), m_realTime(false), m_timestamp(-1.0),
+      m_recordedTimestamp(-1.0), m_firstRecordedTimestamp(-1.0) {
+    // Accept a segment path as well as the base path
+    std::string basePath = path;
+    const std::string extension = RAWFRAME_EXTENSION;
+    if (basePath.size() > extension.size() + 4 &&
+        basePath.compare(basePath.size() - extension.size(), extension.size(), extension) == 0)
+        basePath = basePath.substr(0, basePath.size() - extension.size() - 4);
+
+    for (int index = 0;; index++) {
+        std::string segmentPath = rawFrameSegmentPath(basePath, index);
+        FILE* probe = fopen(segmentPath.c_str(), "rb");
+        if (probe == nullptr)
+            break;
+        fclose(probe);
+        if (!openSegment(segmentPath)) {
+            release();
+            return;
+        }
+    }
+    if (m_frameCount == 0) {
+        fprintf(stderr, "RawFrameReplayer: no frames in %s\n", basePath.c_str());
+        release();
+        return;
+    }
+    for (int position = 0; position < PREFETCH_FRAMES; position++)
+        prefetch(position);
+}
+
+RawFrameReplayer::~RawFrameReplayer() {
+    release();
+}
+
+bool RawFrameReplayer::openSegment(const std::string& path) {
+    MappedFile* file = new MappedFile(path);
+    if (!file->isOpen() || file->size() < sizeof(RawFrameHeader)) {
+        fprintf(stderr, "RawFrameReplayer: cannot map %s\n", path.c_str());
+        delete file;
+        return false;
+    }
+    const RawFrameHeader* header = (const RawFrameHeader*)file->data();
+    const char* problem = nullptr;
+    if (memcmp(header->magic, RAWFRAME_MAGIC, 4) != 0 || header->version != RAWFRAME_VERSION)
+        problem = "not a raw frame segment of this version";
+    else if (header->indexOffset == 0)
+        problem = "segment was not finished (recording interrupted)";
+    else if (header->indexOffset + (uint64_t)header->frameCount * sizeof(RawFrameIndexEntry) > file->size())
+        problem = "index is truncated";
+    else if (header->stride < header->width * CV_ELEM_SIZE(header->type))
+        problem = "invalid row stride";
+#ifndef VC_HAVE_LZ4
+    else if (header->compression == RAWFRAME_LZ4)
+        problem = "LZ4 compressed, but built without LZ4";
+#endif
+    else if (header->compression != RAWFRAME_UNCOMPRESSED && header->compression != RAWFRAME_LZ4)
+        problem = "unknown compression";
+    const RawFrameIndexEntry* index = problem == nullptr ?
+        (const RawFrameIndexEntry*)(file->data() + header->indexOffset) : nullptr;
+    const uint64_t rawBytes = (uint64_t)header->height * header->stride;
+    for (uint32_t i = 0; problem == nullptr && i < header->frameCount; i++) {
+        if (index[i].offset + index[i].size > file->size() ||
+            (header->compression == RAWFRAME_UNCOMPRESSED && index[i].size != rawBytes))
+            problem = "frame outside the file";
+    }
+    if (problem != nullptr) {
+        fprintf(stderr, "RawFrameReplayer: %s: %s\n", path.c_str(), problem);
+        delete file;
+        return false;
+    }
+
+    Segment segment;
+    segment.file = file;
+    segment.header = header;
+    segment.index = index;
+    m_segments.push_back(segment);
+    m_firstFrame.push_back(m_frameCount);
+    m_frameCount += (int)header->frameCount;
+    return true;
+}
+
+bool RawFrameReplayer::locate(int position, int& segment, int& frame) const {
+    if (position < 0 || position >= m_frameCount)
+        return false;
+    segment = (int)m_segments.size() - 1;
+    while (m_firstFrame[segment] > position)
+        segment--;
+    frame = position - m_firstFrame[segment];
+    return true;
+}
+
+void RawFrameReplayer::prefetch(int position) const {
+    int segment, frame;
+    if (locate(m_loop ? position % m_frameCount : position, segment, frame)) {
+        const RawFrameIndexEntry& entry = m_segments[segment].index[frame];
+        m_segments[segment].file->prefetch((size_t)entry.offset, entry.size);
+    }
+}
+
+bool RawFrameReplayer::isOpened() const {
+    return m_frameCount > 0;
+}
+
+bool RawFrameReplayer::read(cv::Mat& frame) {
+    if (m_frameCount == 0)
+        return false;
+    if (m_position >= m_frameCount) {
+        if (!m_loop)
+            return false;
+        m_position = 0;
+    }
+    int segmentIndex, frameIndex;
+    locate(m_position, segmentIndex, frameIndex);
+    const Segment& segment = m_segments[segmentIndex];
+    const RawFrameHeader& header = *segment.header;
+    const RawFrameIndexEntry& entry = segment.index[frameIndex];
+    const unsigned char* data = segment.file->data() + entry.offset;
+
+    // Pages of the frames ahead are read while this one is processed
+    prefetch(m_position + PREFETCH_FRAMES);
+
+#ifdef VC_HAVE_LZ4
+    if (header.compression == RAWFRAME_LZ4) {
+        const int rawBytes = (int)(header.height * header.stride);
+        m_decompressed.resize((size_t)rawBytes);
+        if (LZ4_decompress_safe((const char*)data, (char*)m_decompressed.data(), (int)entry.size, rawBytes) != rawBytes) {
+            fprintf(stderr, "RawFrameReplayer: frame %d is corrupt\n", m_position);
+            m_position++;
+            return false;
+        }
+        data = m_decompressed.data();
+    }
+#endif
+
+    if (m_realTime && entry.timestamp >= 0.0) {
+        if (m_position == 0 || m_firstRecordedTimestamp < 0.0) {
+            m_firstRecordedTimestamp = entry.timestamp;
+            m_replayStart = std::chrono::steady_clock::now();
+        }
+        std::this_thread::sleep_until(m_replayStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                          std::chrono::duration<double>(entry.timestamp - m_firstRecordedTimestamp)));
+    }
+
+    // A header on the mapping (or the decompression buffer), valid until the next read
+    frame = cv::Mat((int)header.height, (int)header.width, header.type, (void*)data, header.stride);
+    m_recordedTimestamp = entry.timestamp;
+    m_timestamp = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    m_position++;
+    return true;
+}
+
+double RawFrameReplayer::getTimestamp() const {
+    return m_timestamp;
+}
+
+int RawFrameReplayer::getWidth() const {
+    return m_segments.empty() ? 0 : (int)m_segments[0].header->width;
+}
+
+int RawFrameReplayer::getHeight() const {
+    return m_segments.empty() ? 0 : (int)m_segments[0].header->height;
+}
+
+void RawFrameReplayer::release() {
+    for (Segment& segment : m_segments)
+        delete segment.file;
+    m_segments.clear();
+    m_firstFrame.clear();
+    m_frameCount = 0;
+    m_position = 0;
+}
@@ -0,0 +1,73 @@
+#ifndef RAWFRAMEREPLAYER_HPP
+#define RAWFRAMEREPLAYER_HPP
+
+#include "FrameSource.hpp"
+#include "MappedFile.hpp"
+#include "RawFrameFile.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * RawFrameReplayer - FrameSource that plays back a .vcraw recording (see RawFrameWriter).
+ *
+ * Segments are memory mapped. Uncompressed frames are returned as headers on the mapping,
+ * without a copy, and the next frames are prefetched with madvise so page faults overlap
+ * with processing; replay speed is then bound by memory bandwidth, not by the disk or a
+ * decoder. LZ4 frames are decompressed into one reused buffer. By default frames are
+ * delivered as fast as they are read, which is what profiling wants.
+ */
+class RawFrameReplayer : public FrameSource {
+public:
+    /**
+     * Open a recording
+     * @param path Base path of the recording or the path of any of its segments
+     * @param loop Start over after the last frame instead of ending the stream
+     */
+    RawFrameReplayer(const std::string& path, bool loop = true);
+    ~RawFrameReplayer() override;
+
+    bool isOpened() const override;
+    bool read(cv::Mat& frame) override;
+    double getTimestamp() const override;
+    int getWidth() const override;
+    int getHeight() const override;
+    void release() override;
+
+    /**
+     * Wait out the recorded intervals between frames instead of replaying at full speed
+     */
+    void setRealTime(bool realTime) { m_realTime = realTime; }
+
+    /**
+     * Capture time stored with the last frame returned by read()
+     */
+    double getRecordedTimestamp() const { return m_recordedTimestamp; }
+
+    int getFrameCount() const { return m_frameCount; }
+
+private:
+    struct Segment {
+        MappedFile* file;
+        const RawFrameHeader* header;
+        const RawFrameIndexEntry* index;
+    };
+
+    bool openSegment(const std::string& path);
+    void prefetch(int position) const;
+    bool locate(int position, int& segment, int& frame) const;
+
+    std::vector<Segment> m_segments;
+    std::vector<int> m_firstFrame;      //!< position of each segment's first frame
+    int m_frameCount;
+    int m_position;                     //!< next frame to read
+    bool m_loop;
+    bool m_realTime;
+    std::vector<unsigned char> m_decompressed;
+    double m_timestamp;
+    double m_recordedTimestamp;
+    double m_firstRecordedTimestamp;
+    std::chrono::steady_clock::time_point m_replayStart;
+};
+
+#endif // RAWFRAMEREPLAYER_HPP
@@ -0,0 +1,199 @@
+#include <string.h>
+#include <algorithm>
+
+#include "RawFrameWriter.hpp"
+
+#ifdef VC_HAVE_LZ4
+#include <lz4.h>
+#endif
+
+RawFrameWriter::RawFrameWriter(int queueLength)
+    : m_queue(queueLength), m_stop(false), m_failed(false), m_written(0), m_dropped(0), m_segments(0),
+      m_bytes(0), m_compress(false), m_segmentBytes(DEFAULT_SEGMENT_BYTES), m_file(nullptr), m_offset(0) {
+    memset(&m_header, 0, sizeof(m_header));
+}
+
+RawFrameWriter::~RawFrameWriter() {
+    close();
+}
+
+bool RawFrameWriter::open(const std::string& basePath, bool compress, size_t segmentBytes) {
+    if (isOpen())
+        return false;
+#ifndef VC_HAVE_LZ4
+    if (compress)
+        fprintf(stderr, "RawFrameWriter: built without LZ4, frames are written uncompressed\n");
+    compress = false;
+#endif
+    m_basePath = basePath;
+    m_compress = compress;
+    m_segmentBytes = segmentBytes;
+    m_queue.clear();
+    m_stop = false;
+    m_failed = false;
+    m_written = 0;
+    m_dropped = 0;
+    m_segments = 0;
+    m_bytes = 0;
+    m_thread = std::thread(&RawFrameWriter::run, this);
+    return true;
+}
+
+void RawFrameWriter::close() {
+    if (!m_thread.joinable())
+        return;
+    m_stop = true;
+    m_queue.wake();
+    m_thread.join();
+}
+
+bool RawFrameWriter::write(const cv::Mat& frame, double timestamp) {
+    if (!isOpen() || m_failed.load() || frame.empty() || frame.depth() != CV_8U)
+        return false;
+    if (!m_queue.push(frame, timestamp)) {
+        m_dropped++;
+        return false;
+    }
+    return true;
+}
+
+RawFrameWriter::Statistics RawFrameWriter::getStatistics() const {
+    Statistics statistics;
+    statistics.written = m_written.load();
+    statistics.dropped = m_dropped.load();
+    statistics.queueDepth = m_queue.size();
+    statistics.segments = m_segments.load();
+    statistics.megabytes = m_bytes.load() / (1024.0 * 1024.0);
+    return statistics;
+}
+
+void RawFrameWriter::run() {
+    while (true) {
+        double timestamp;
+        const cv::Mat* frame = m_queue.front(&timestamp);
+        if (frame == nullptr) {
+            // Queued frames are written before stopping
+            if (m_stop.load())
+                break;
+            m_queue.waitForFrame(5);
+            continue;
+        }
+        if (m_failed.load() || !appendFrame(*frame, timestamp)) {
+            m_failed = true;
+            m_dropped++;
+        } else {
+            m_written++;
+        }
+        m_queue.pop();
+    }
+    if (m_file != nullptr && !finishSegment())
+        m_failed = true;
+}
+
+bool RawFrameWriter::pad() {
+    static const unsigned char zeros[RAWFRAME_ALIGNMENT] = {};
+    size_t padding = (size_t)((RAWFRAME_ALIGNMENT - m_offset % RAWFRAME_ALIGNMENT) % RAWFRAME_ALIGNMENT);
+    if (padding > 0 && fwrite(zeros, 1, padding, m_file) != padding)
+        return false;
+    m_offset += padding;
+    return true;
+}
+
+bool RawFrameWriter::beginSegment(const cv::Mat& frame) {
+    std::string path = rawFrameSegmentPath(m_basePath, m_segments.load());
+    m_file = fopen(path.c_str(), "wb");
+    if (m_file == nullptr) {
+        fprintf(stderr, "RawFrameWriter: cannot create %s\n", path.c_str());
+        return false;
+    }
+    memset(&m_header, 0, sizeof(m_header));
+    memcpy(m_header.magic, RAWFRAME_MAGIC, 4);
+    m_header.version = RAWFRAME_VERSION;
+    m_header.width = (uint32_t)frame.cols;
+    m_header.height = (uint32_t)frame.rows;
+    m_header.type = frame.type();
+    // Rows padded to 64 bytes like FrameFormat::allocateAligned, so aligned frames copy straight through
+    m_header.stride = (uint32_t)((frame.cols * frame.elemSize() + 63) & ~(size_t)63);
+    m_header.compression = m_compress ? RAWFRAME_LZ4 : RAWFRAME_UNCOMPRESSED;
+    m_index.clear();
+    // The header is rewritten with frame count and index offset when the segment is finished
+    m_offset = sizeof(m_header);
+    if (fwrite(&m_header, sizeof(m_header), 1, m_file) != 1 || !pad()) {
+        fprintf(stderr, "RawFrameWriter: cannot write %s\n", path.c_str());
+        return false;
+    }
+    m_segments++;
+    return true;
+}
+
+bool RawFrameWriter::finishSegment() {
+    bool ok = pad();
+    m_header.frameCount = (uint32_t)m_index.size();
+    m_header.indexOffset = m_offset;
+    ok = ok && (m_index.empty() || fwrite(m_index.data(), sizeof(RawFrameIndexEntry), m_index.size(), m_file) == m_index.size());
+    ok = ok && fseek(m_file, 0, SEEK_SET) == 0 && fwrite(&m_header, sizeof(m_header), 1, m_file) == 1;
+    ok = fclose(m_file) == 0 && ok;
+    m_file = nullptr;
+    if (!ok)
+        fprintf(stderr, "RawFrameWriter: cannot finish segment %d of %s\n", m_segments.load() - 1, m_basePath.c_str());
+    return ok;
+}
+
+bool RawFrameWriter::appendFrame(const cv::Mat& frame, double timestamp) {
+    if (m_file != nullptr && (frame.cols != (int)m_header.width || frame.rows != (int)m_header.height ||
+                              frame.type() != m_header.type)) {
+        if (!finishSegment())
+            return false;
+    }
+    if (m_file == nullptr && !beginSegment(frame))
+        return false;
+    const size_t rawBytes = (size_t)frame.rows * m_header.stride;
+    const size_t rowBytes = frame.cols * frame.elemSize();
+
+    // Frame rows in the stored layout, taken in place when the frame already has it
+    const unsigned char* data = frame.data;
+    if (frame.step != m_header.stride || !frame.isContinuous()) {
+        m_rows.resize(rawBytes);
+        for (int y = 0; y < frame.rows; y++) {
+            unsigned char* row = &m_rows[(size_t)y * m_header.stride];
+            memcpy(row, frame.ptr(y), rowBytes);
+            memset(row + rowBytes, 0, m_header.stride - rowBytes);
+        }
+        data = m_rows.data();
+    }
+    size_t storedBytes = rawBytes;
+#ifdef VC_HAVE_LZ4
+    if (m_compress) {
+        m_compressed.resize((size_t)LZ4_compressBound((int)rawBytes));
+        int compressed = LZ4_compress_default((const char*)data, m_compressed.data(), (int)rawBytes,
+                                              (int)m_compressed.size());
+        if (compressed <= 0) {
+            fprintf(stderr, "RawFrameWriter: LZ4 compression failed\n");
+            return false;
+        }
+        data = (const unsigned char*)m_compressed.data();
+        storedBytes = (size_t)compressed;
+    }
+#endif
+
+    // Keep segments below the limit, the index of the finished one goes at its end
+    size_t indexBytes = (m_index.size() + 1) * sizeof(RawFrameIndexEntry);
+    if (!m_index.empty() && m_offset + storedBytes + RAWFRAME_ALIGNMENT + indexBytes > m_segmentBytes) {
+        if (!finishSegment() || !beginSegment(frame))
+            return false;
+    }
+
+    RawFrameIndexEntry entry;
+    entry.offset = m_offset;
+    entry.size = (uint32_t)storedBytes;
+    entry.reserved = 0;
+    entry.timestamp = timestamp;
+    if (fwrite(data, 1, storedBytes, m_file) != storedBytes) {
+        fprintf(stderr, "RawFrameWriter: write failed (disk full?)\n");
+        return false;
+    }
+    m_offset += storedBytes;
+    m_index.push_back(entry);
+    m_bytes += (long long)storedBytes;
+    return pad();
+}
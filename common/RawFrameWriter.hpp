@@ -0,0 +1,100 @@
+#ifndef RAWFRAMEWRITER_HPP
+#define RAWFRAMEWRITER_HPP
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FrameQueue.hpp"
+#include "RawFrameFile.hpp"
+
+/**
+ * RawFrameWriter - Records frames bit-exact into .vcraw segments (see RawFrameFile.hpp).
+ *
+ * write() copies the frame into a FrameQueue slot and returns; a writer thread pads the rows
+ * to the stored stride, optionally compresses them with LZ4 and appends them to the current
+ * segment. Frames are dropped, never waited for, when the disk falls behind.
+ */
+class RawFrameWriter {
+public:
+    static const size_t DEFAULT_SEGMENT_BYTES = (size_t)1 << 30;
+
+    /**
+     * Totals since open()
+     */
+    struct Statistics {
+        int written;
+        int dropped;
+        int queueDepth;
+        int segments;
+        double megabytes;   //!< stored bytes, after compression
+    };
+
+    /**
+     * @param queueLength Frames that can wait for the writer thread
+     */
+    RawFrameWriter(int queueLength = 16);
+    ~RawFrameWriter();
+
+    /**
+     * Start a recording
+     * @param basePath Segments are written as basePath.000.vcraw, basePath.001.vcraw, ...
+     * @param compress Compress frames with LZ4; written uncompressed if built without VC_HAVE_LZ4
+     * @param segmentBytes A new segment starts before a frame would make the current one larger
+     * @return False if a recording is already running
+     */
+    bool open(const std::string& basePath, bool compress, size_t segmentBytes = DEFAULT_SEGMENT_BYTES);
+
+    /**
+     * Write the queued frames, finish the segment index and join the writer thread
+     */
+    void close();
+
+    bool isOpen() const { return m_thread.joinable(); }
+
+    /**
+     * True once a segment could not be written; frames queued afterwards are dropped
+     */
+    bool hasFailed() const { return m_failed.load(); }
+
+    /**
+     * Queue a frame, never blocks (called by one thread only)
+     * @param frame 8-bit frame with 1 to 4 channels; a new size or type starts a new segment
+     * @param timestamp Capture time in seconds, stored in the index
+     * @return False if the frame was dropped
+     */
+    bool write(const cv::Mat& frame, double timestamp);
+
+    Statistics getStatistics() const;
+
+private:
+    void run();
+    bool beginSegment(const cv::Mat& frame);
+    bool finishSegment();
+    bool appendFrame(const cv::Mat& frame, double timestamp);
+    bool pad();
+
+    FrameQueue m_queue;
+    std::thread m_thread;
+    std::atomic<bool> m_stop;
+    std::atomic<bool> m_failed;
+    std::atomic<int> m_written;
+    std::atomic<int> m_dropped;
+    std::atomic<int> m_segments;
+    std::atomic<long long> m_bytes;
+
+    // Writer thread only
+    std::string m_basePath;
+    bool m_compress;
+    size_t m_segmentBytes;
+    FILE* m_file;
+    RawFrameHeader m_header;
+    std::vector<RawFrameIndexEntry> m_index;
+    uint64_t m_offset;                  //!< current end of the segment
+    std::vector<unsigned char> m_rows;  //!< frame repacked to the stored stride
+    std::vector<char> m_compressed;
+};
+
+#endif // RAWFRAMEWRITER_HPP
@@ -0,0 +1,109 @@
+#include <algorithm>
+
+#include "RenderQueue.hpp"
+
+RenderQueue::RenderQueue() : m_instanceBuffer(0), m_instanceCapacity(0), m_drawCalls(0) {
+}
+
+RenderQueue::~RenderQueue() {
+    if (m_instanceBuffer)
+        glDeleteBuffers(1, &m_instanceBuffer);
+}
+
+void RenderQueue::submit(Object* object) {
+    DrawItem item;
+    item.shader = object->getShader();
+    item.object = object;
+    item.geometry = item.shader != NULL ? object->getGeometryID() : 0;
+    item.program = item.shader != NULL ? item.shader->getProgramID() : 0;
+    item.texture = item.shader != NULL ? item.shader->getTextureID() : 0;
+    m_items.push_back(item);
+}
+
+void RenderQueue::bindInstances(size_t first, size_t last) {
+    m_instanceData.clear();
+    for (size_t i = first; i < last; i++)
+        m_instanceData.push_back(m_items[i].object->getTransform());
+
+    if (!m_instanceBuffer)
+        glGenBuffers(1, &m_instanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    // Orphan the previous contents so the driver never waits for draws still reading them
+    if (m_instanceData.size() > m_instanceCapacity)
+        m_instanceCapacity = m_instanceData.size();
+    glBufferData(GL_ARRAY_BUFFER, m_instanceCapacity * sizeof(glm::mat4), NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, m_instanceData.size() * sizeof(glm::mat4), &m_instanceData[0]);
+
+    // A mat4 attribute occupies four consecutive vec4 locations
+    for (int column = 0; column < 4; column++) {
+        GLuint location = RENDERQUEUE_INSTANCE_ATTRIBUTE + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                              (void*)(sizeof(glm::vec4) * column));
+        glVertexAttribDivisor(location, 1);
+    }
+}
+
+void RenderQueue::flush(Camera* camera) {
+    m_drawCalls = 0;
+    if (m_items.empty())
+        return;
+
+    // Group by state that is expensive to change, program first
+    std::sort(m_items.begin(), m_items.end(), [](const DrawItem& a, const DrawItem& b) {
+        if (a.program != b.program) return a.program < b.program;
+        if (a.texture != b.texture) return a.texture < b.texture;
+        if (a.geometry != b.geometry) return a.geometry < b.geometry;
+        return a.shader < b.shader;
+    });
+
+    const glm::mat4& VP = camera->getViewProjectionMatrix();
+    Shader* boundShader = NULL;
+
+    size_t i = 0;
+    while (i < m_items.size()) {
+        DrawItem& item = m_items[i];
+        if (item.geometry == 0) {
+            // Not batchable, the object binds its own state
+            item.object->render(camera);
+            boundShader = NULL;
+            m_drawCalls++;
+            i++;
+            continue;
+        }
+
+        // Run of items sharing shader and geometry
+        size_t last = i + 1;
+        while (last < m_items.size() && m_items[last].shader == item.shader && m_items[last].geometry == item.geometry)
+            last++;
+
+        if (item.shader != boundShader) {
+            item.shader->bind();
+            boundShader = item.shader;
+        }
+        item.object->bindGeometry();
+
+        if (item.shader->isInstanced()) {
+            item.shader->updateVP(VP);
+            bindInstances(i, last);
+            item.object->drawGeometry((GLsizei)(last - i));
+            m_drawCalls++;
+            for (int column = 0; column < 4; column++) {
+                glVertexAttribDivisor(RENDERQUEUE_INSTANCE_ATTRIBUTE + column, 0);
+                glDisableVertexAttribArray(RENDERQUEUE_INSTANCE_ATTRIBUTE + column);
+            }
+        } else {
+            // Shader expects a full MVP: one draw per object, but no rebinding in between
+            for (size_t k = i; k < last; k++) {
+                item.shader->updateMVP(m_items[k].object->getMVP(camera));
+                item.object->drawGeometry(1);
+                m_drawCalls++;
+            }
+        }
+
+        item.object->unbindGeometry();
+        i = last;
+    }
+
+    m_items.clear();
+}
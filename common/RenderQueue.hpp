@@ -0,0 +1,69 @@
+/*
+ * RenderQueue.hpp
+ *
+ *  Collects draw items for a frame, sorts them by program, texture and geometry and merges
+ *  objects that share geometry and shader into instanced draw calls.
+ *
+ */
+#ifndef RENDERQUEUE_HPP
+#define RENDERQUEUE_HPP
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Object.hpp"
+#include "Camera.hpp"
+
+//! First vertex attribute location of the per instance model matrix (uses 4 locations)
+#define RENDERQUEUE_INSTANCE_ATTRIBUTE 3
+
+//!  RenderQueue.
+/*!
+ Objects are submitted each frame and drawn by flush(). Runs of items with the same shader and
+ geometry become one glDraw*Instanced call when the shader is instanced (VP uniform plus a
+ mat4 model attribute at RENDERQUEUE_INSTANCE_ATTRIBUTE). Other shaders still benefit from the
+ sorting: each shader is bound once and the view projection matrix is computed once per flush.
+ Objects without batchable geometry are drawn through their own render().
+ */
+class RenderQueue {
+public:
+    //! Constructor
+    /*! The instance buffer is created on first use. */
+    RenderQueue();
+    //! Destructor
+    /*! Deletes the instance buffer. */
+    ~RenderQueue();
+
+    //! submit
+    /*! Adds an object to this frame's queue. */
+    void submit(Object* object);
+
+    //! flush
+    /*! Sorts and draws all submitted objects, then empties the queue. */
+    void flush(Camera* camera);
+
+    //! getDrawCallCount
+    /*! Number of draw calls issued by the last flush(). */
+    int getDrawCallCount() const { return m_drawCalls; }
+
+private:
+    struct DrawItem {
+        GLuint program;
+        GLuint texture;
+        GLuint geometry;    //!< 0: not batchable, drawn with Object::render
+        Shader* shader;
+        Object* object;
+    };
+
+    //! Uploads the model matrices of items [first, last) into the instance buffer and sets up the attributes
+    void bindInstances(size_t first, size_t last);
+
+    std::vector<DrawItem> m_items;
+    std::vector<glm::mat4> m_instanceData;
+    GLuint m_instanceBuffer;
+    size_t m_instanceCapacity;  //!< allocated size of the instance buffer in matrices
+    int m_drawCalls;
+};
+
+#endif
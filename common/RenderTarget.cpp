@@ -0,0 +1,67 @@
+#include "RenderTarget.hpp"
+
+RenderTarget::RenderTarget(int width, int height, bool depth)
+    : m_framebufferID(0), m_colorID(0), m_color(nullptr), m_depthID(0), m_width(width), m_height(height), m_depth(depth) {
+    glGenFramebuffers(1, &m_framebufferID);
+    glGenTextures(1, &m_colorID);
+    m_color = new Texture(m_colorID);
+    if (m_depth)
+        glGenRenderbuffers(1, &m_depthID);
+    allocate();
+}
+
+RenderTarget::~RenderTarget() {
+    if (m_depthID)
+        glDeleteRenderbuffers(1, &m_depthID);
+    delete m_color;
+    glDeleteFramebuffers(1, &m_framebufferID);
+}
+
+void RenderTarget::allocate() {
+    glBindTexture(GL_TEXTURE_2D, m_colorID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_colorID, 0);
+    if (m_depth) {
+        glBindRenderbuffer(GL_RENDERBUFFER, m_depthID);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_width, m_height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthID);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void RenderTarget::resize(int width, int height) {
+    if (width == m_width && height == m_height)
+        return;
+    m_width = width;
+    m_height = height;
+    allocate();
+}
+
+void RenderTarget::bind() {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+    glViewport(0, 0, m_width, m_height);
+}
+
+void RenderTarget::unbind() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+bool RenderTarget::isComplete() {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return status == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void RenderTarget::readPixels(unsigned char* data) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebufferID);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, m_width, m_height, GL_BGRA, GL_UNSIGNED_BYTE, data);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
@@ -0,0 +1,68 @@
+/*
+ * RenderTarget.hpp
+ *
+ *  Offscreen framebuffer with a colour texture and a depth buffer, used for headless
+ *  rendering and for multi-pass effects.
+ *
+ */
+#ifndef RENDERTARGET_HPP
+#define RENDERTARGET_HPP
+
+#include <glad/gl.h>
+
+#include "Texture.hpp"
+
+//!  RenderTarget.
+/*!
+ Framebuffer object with a GL_RGBA8 colour texture (linear filtering, clamped) and an optional
+ depth renderbuffer. bind() redirects drawing into it and sets the viewport to its size.
+ */
+class RenderTarget {
+public:
+    //! Constructor
+    /*! Allocates the attachments, needs a current GL context. */
+    RenderTarget(int width, int height, bool depth = true);
+    //! Destructor
+    /*! Deletes framebuffer and attachments. */
+    ~RenderTarget();
+
+    //! resize
+    /*! Reallocates the attachments if the size changed, the contents are undefined afterwards. */
+    void resize(int width, int height);
+
+    //! bind
+    /*! Draws into this target from now on and sets the viewport to cover it. */
+    void bind();
+    //! unbind
+    /*! Returns to the default framebuffer, the caller restores its viewport. */
+    static void unbind();
+
+    //! isComplete
+    /*! False if the driver rejected the attachment combination. */
+    bool isComplete();
+
+    //! readPixels
+    /*! Copies the colour attachment as tightly packed BGRA rows, bottom row first, into data
+        (width * height * 4 bytes). Waits for rendering to finish. */
+    void readPixels(unsigned char* data);
+
+    //! getTexture
+    /*! Colour attachment, owned by the target. Can be handed to a TextureShader. */
+    Texture* getTexture() { return m_color; }
+    GLuint getTextureID() const { return m_colorID; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+private:
+    void allocate();
+
+    GLuint m_framebufferID;
+    GLuint m_colorID;
+    Texture* m_color;   //!< wraps m_colorID and deletes it
+    GLuint m_depthID;   //!< 0 without depth buffer
+    int m_width;
+    int m_height;
+    bool m_depth;
+};
+
+#endif
@@ -14,8 +14,9 @@ void Scene::render(Camera* camera){
     
     for (int i=0;i<sceneObjects.size();i++)
     {
-        sceneObjects[i]->render(camera);
+        renderQueue.submit(sceneObjects[i]);
     }
+    renderQueue.flush(camera);
 }
 
 void Scene::addObject(Object *object){
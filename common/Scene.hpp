@@ -11,6 +11,7 @@
 
 #include <vector>
 #include "Object.hpp"
+#include "RenderQueue.hpp"
 
 
 //!  Scene.
@@ -23,14 +24,19 @@ class Scene{
         Scene(){};
         ~Scene();
         //! render
-        /*! Render all objects in the scene. Will call individal render methods. */
+        /*! Render all objects in the scene through the render queue. Objects sharing shader and
+            geometry are drawn instanced, others fall back to their individual render methods. */
         void render(Camera* camera);
         //! addObject
         /*! Add an object to the scene. */
         void addObject(Object *object);
+        //! getDrawCallCount
+        /*! Draw calls issued by the last render(). */
+        int getDrawCallCount() const { return renderQueue.getDrawCallCount(); }
     
     private:
         std::vector<Object*> sceneObjects;
+        RenderQueue renderQueue;
     
     
 };
@@ -121,12 +121,15 @@ void Shader::initShaders(std::string vertexshaderName, std::string fragmentshade
 	m_MID = glGetUniformLocation(programID, "M");
 	m_VID = glGetUniformLocation(programID, "V");
 	m_PID = glGetUniformLocation(programID, "P");
+	m_VPID = glGetUniformLocation(programID, "VP");
 	
 }
 
 void Shader::updateMatrices(glm::mat4 MVP,glm::mat4 M,glm::mat4 V,glm::mat4 P){
 	
 	glUniformMatrix4fv(m_MVPID, 1, GL_FALSE, &MVP[0][0]);
+	m_lastMVP = MVP;
+	m_MVPValid = true;
 	glUniformMatrix4fv(m_MID, 1, GL_FALSE, &M[0][0]);
 	glUniformMatrix4fv(m_VID, 1, GL_FALSE, &V[0][0]);
 	glUniformMatrix4fv(m_PID, 1, GL_FALSE, &P[0][0]);
@@ -134,9 +137,23 @@ void Shader::updateMatrices(glm::mat4 MVP,glm::mat4 M,glm::mat4 V,glm::mat4 P){
 }
 
 
-void Shader::updateMVP(glm::mat4 MVP){
+void Shader::updateMVP(const glm::mat4& MVP){
 	
+	if (m_MVPValid && MVP == m_lastMVP)
+		return;
 	glUniformMatrix4fv(m_MVPID, 1, GL_FALSE, &MVP[0][0]);
+	m_lastMVP = MVP;
+	m_MVPValid = true;
+	
+}
+
+void Shader::updateVP(const glm::mat4& VP){
+	
+	if (m_VPValid && VP == m_lastVP)
+		return;
+	glUniformMatrix4fv(m_VPID, 1, GL_FALSE, &VP[0][0]);
+	m_lastVP = VP;
+	m_VPValid = true;
 	
 }
 
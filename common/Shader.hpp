@@ -27,20 +27,20 @@ class Shader{
 public:
     //! Default constructor
     /*! Does nothing at the moment */
-	Shader(){
+	Shader(): m_MVPValid(false), m_VPValid(false){
 		
 	}
     //! Constructor with shader source specification
     /*! Creates the shaders from source, creates vertex and fragment shader at the same time. 
         Uses different source file naming conventions*/
-	Shader(std::string vertexshaderName, std::string fragmentshaderName){
+	Shader(std::string vertexshaderName, std::string fragmentshaderName): m_MVPValid(false), m_VPValid(false){
 		initShaders(vertexshaderName,fragmentshaderName);
 		
 	}
     //! Constructor with shader source specification
     /*! Creates the shaders from source, creates vertex and fragment shader at the same time. 
      Assumes that fragment and vertex shader have the same names*/
-	Shader(std::string shaderName){
+	Shader(std::string shaderName): m_MVPValid(false), m_VPValid(false){
 		initShaders(shaderName+".vert",shaderName+".frag");
 		
 	}
@@ -62,8 +62,24 @@ public:
 	void updateMatrices(glm::mat4 MVP,glm::mat4 M,glm::mat4 V, glm::mat4 P);
 	
     //! updateMVP
-    /*! Updates the values for the model-view projection matrix*/
-	void updateMVP(glm::mat4 MVP);
+    /*! Updates the values for the model-view projection matrix. Skips the upload if the program already has this value*/
+	void updateMVP(const glm::mat4& MVP);
+	
+    //! updateVP
+    /*! Updates the view projection matrix of instanced shaders, the model matrix comes per instance. Skips unchanged uploads*/
+	void updateVP(const glm::mat4& VP);
+	
+    //! isInstanced
+    /*! True if the vertex shader takes a VP uniform and a per instance model matrix (locations 3-6)*/
+	bool isInstanced() const { return m_VPID != -1; }
+	
+    //! getProgramID
+    /*! Program handle, used as sort key when batching draws*/
+	GLuint getProgramID() const { return programID; }
+	
+    //! getTextureID
+    /*! Texture bound by bind(), 0 if none. Used as sort key when batching draws*/
+	virtual GLuint getTextureID() { return 0; }
 	
     //! bind
     /*! Shader binding, virtual */
@@ -75,6 +91,13 @@ protected:
 	GLuint m_VID;       //!<   all shader should get information about the view matrix
 	GLuint m_MID;       //!<   all shader should get information about the model matrix
     GLuint m_PID;       //!<   all shader should get information about the projection matrix
+    GLint m_VPID;       //!<   view projection matrix of instanced shaders, -1 otherwise
+    
+    // Uniforms are program state, so the last uploaded values stay valid across binds
+    glm::mat4 m_lastMVP;    //!<   MVP currently stored in the program
+    bool m_MVPValid;        //!<   m_lastMVP holds the uploaded value
+    glm::mat4 m_lastVP;     //!<   VP currently stored in the program
+    bool m_VPValid;         //!<   m_lastVP holds the uploaded value
      
 };
 
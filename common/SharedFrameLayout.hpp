@@ -0,0 +1,78 @@
+/*
+ * SharedFrameLayout.hpp
+ *
+ *  Layout of the POSIX shared memory frame ring written by SharedFrameRing and read by
+ *  SharedFrameReader. One writer, any number of local readers; readers use the frames in
+ *  place, the only copy is the writer's.
+ *
+ *  Layout:
+ *    SharedFrameHeader
+ *    padding up to slotOffset
+ *    slotCount * { SharedFrameSlot, padding up to SHAREDFRAME_DATA_OFFSET, frame data }, slotBytes apart
+ *
+ *  Every slot is a seqlock: the writer makes version odd, fills the slot and makes it even
+ *  again. A reader that sees the same even version before and after using a frame knows the
+ *  frame was not overwritten meanwhile. Readers sleep on the futex word, the writer wakes
+ *  them after publishing if any are waiting.
+ *
+ */
+#ifndef SHAREDFRAMELAYOUT_HPP
+#define SHAREDFRAMELAYOUT_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SHAREDFRAME_MAGIC "VCSF"
+#define SHAREDFRAME_VERSION 1
+#define SHAREDFRAME_DATA_OFFSET 64      // frame data offset inside a slot, rows stay 64-byte aligned
+#define SHAREDFRAME_BOTTOM_UP 1u        // SharedFrameSlot::flags: row 0 is the bottom of the image (OpenGL readback)
+
+// The ring holds 32-bit (int) and 64-bit (long long) atomics, both must always be lock free
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2 && sizeof(int) == sizeof(uint32_t),
+              "shared memory atomics must not need a lock");
+
+//! Start of the shared memory object, stored in native byte order.
+struct SharedFrameHeader {
+    char magic[4];                      //!< "VCSF", written last when the ring is created
+    uint32_t version;                   //!< SHAREDFRAME_VERSION
+    uint32_t slotCount;
+    int32_t writerPid;                  //!< process that created the ring
+    uint64_t slotOffset;                //!< offset of the first slot
+    uint64_t slotBytes;                 //!< distance between slots, a multiple of the page size
+    uint64_t capacity;                  //!< largest frame in bytes (height * stride)
+    std::atomic<uint64_t> published;    //!< number of the newest complete frame, 0 = none yet
+    std::atomic<uint32_t> futex;        //!< low 32 bits of published, readers wait on it
+    std::atomic<uint32_t> waiters;      //!< readers sleeping on futex
+};
+
+//! Header of one slot, the frame data follows at SHAREDFRAME_DATA_OFFSET.
+struct SharedFrameSlot {
+    std::atomic<uint32_t> version;      //!< seqlock, odd while the writer fills the slot
+    uint32_t flags;                     //!< SHAREDFRAME_BOTTOM_UP
+    uint64_t frameNumber;               //!< 1 for the first published frame
+    double timestamp;                   //!< steady clock (CLOCK_MONOTONIC) seconds
+    uint32_t width;
+    uint32_t height;
+    int32_t type;                       //!< OpenCV type code, e.g. 24 = CV_8UC4
+    uint32_t stride;                    //!< bytes per row
+};
+
+static_assert(sizeof(SharedFrameSlot) <= SHAREDFRAME_DATA_OFFSET, "slot header overlaps the frame data");
+
+//! Shared memory object name as shm_open wants it (one leading slash).
+inline std::string sharedFrameObjectName(const std::string& name) {
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+//! futex(2) on a word in shared memory (not FUTEX_PRIVATE, the waiters are other processes).
+inline long sharedFrameFutex(std::atomic<uint32_t>* word, int operation, uint32_t value, const timespec* timeout) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), operation, value, timeout, nullptr, 0);
+}
+
+#endif
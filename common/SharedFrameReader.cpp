@@ -0,0 +1,142 @@
+#include "SharedFrameReader.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <chrono>
+
+SharedFrameReader::SharedFrameReader()
+    : m_fd(-1), m_memory(nullptr), m_size(0), m_header(nullptr), m_last(0), m_skipped(0) {
+}
+
+SharedFrameReader::~SharedFrameReader() {
+    close();
+}
+
+bool SharedFrameReader::open(const std::string& name) {
+    close();
+    std::string objectName = sharedFrameObjectName(name);
+    // Read-write: waiting readers register in the header so the writer knows to wake them
+    m_fd = shm_open(objectName.c_str(), O_RDWR, 0);
+    if (m_fd < 0) {
+        fprintf(stderr, "SharedFrameReader: cannot open %s: %s\n", objectName.c_str(), strerror(errno));
+        return false;
+    }
+    struct stat info;
+    if (fstat(m_fd, &info) != 0 || (size_t)info.st_size < sizeof(SharedFrameHeader)) {
+        fprintf(stderr, "SharedFrameReader: %s is not a frame ring\n", objectName.c_str());
+        close();
+        return false;
+    }
+    void* memory = mmap(nullptr, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (memory == MAP_FAILED) {
+        fprintf(stderr, "SharedFrameReader: cannot map %s: %s\n", objectName.c_str(), strerror(errno));
+        close();
+        return false;
+    }
+    m_memory = (unsigned char*)memory;
+    m_size = (size_t)info.st_size;
+
+    SharedFrameHeader* header = (SharedFrameHeader*)m_memory;
+    if (memcmp(header->magic, SHAREDFRAME_MAGIC, 4) != 0 || header->version != SHAREDFRAME_VERSION) {
+        fprintf(stderr, "SharedFrameReader: %s is not a version %d frame ring\n", objectName.c_str(),
+                SHAREDFRAME_VERSION);
+        close();
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->slotCount == 0 || header->slotBytes < SHAREDFRAME_DATA_OFFSET + header->capacity ||
+        header->slotOffset + header->slotBytes * header->slotCount > m_size) {
+        fprintf(stderr, "SharedFrameReader: %s has an inconsistent header\n", objectName.c_str());
+        close();
+        return false;
+    }
+    m_header = header;
+    // Start with the newest frame, older ones do not count as skipped
+    m_last = 0;
+    m_skipped = 0;
+    return true;
+}
+
+void SharedFrameReader::close() {
+    m_header = nullptr;
+    if (m_memory != nullptr) {
+        munmap(m_memory, m_size);
+        m_memory = nullptr;
+        m_size = 0;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+const SharedFrameSlot* SharedFrameReader::slot(uint64_t index) const {
+    return (const SharedFrameSlot*)(m_memory + m_header->slotOffset + index * m_header->slotBytes);
+}
+
+int SharedFrameReader::getWriterPid() const {
+    return m_header != nullptr ? m_header->writerPid : 0;
+}
+
+bool SharedFrameReader::acquire(Frame& frame, int timeoutMs) {
+    if (m_header == nullptr)
+        return false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    for (;;) {
+        const uint64_t published = m_header->published.load(std::memory_order_acquire);
+        if (published != 0 && published != m_last) {
+            // Seqlock read of the slot header; a mismatch means the writer lapped us, take the next newest
+            const int index = (int)((published - 1) % m_header->slotCount);
+            const SharedFrameSlot* source = slot(index);
+            const uint32_t version = source->version.load(std::memory_order_acquire);
+            // An odd version means the writer is still copying into the newest slot (one slot ring, or it
+            // lapped us): sleep until it publishes that frame instead of spinning through the copy
+            if ((version & 1) == 0) {
+                Frame result;
+                result.data = (const unsigned char*)source + SHAREDFRAME_DATA_OFFSET;
+                result.width = (int)source->width;
+                result.height = (int)source->height;
+                result.type = source->type;
+                result.stride = (int)source->stride;
+                result.flags = source->flags;
+                result.number = source->frameNumber;
+                result.timestamp = source->timestamp;
+                result.version = version;
+                result.slot = index;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (source->version.load(std::memory_order_relaxed) != version || result.number != published ||
+                    (uint64_t)result.height * (uint64_t)result.stride > m_header->capacity)
+                    continue;
+
+                if (m_last != 0 && published > m_last + 1)
+                    m_skipped += published - m_last - 1;
+                m_last = published;
+                frame = result;
+                return true;
+            }
+        }
+
+        auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0)
+            return false;
+        timespec timeout;
+        timeout.tv_sec = (time_t)(remaining / 1000000000);
+        timeout.tv_nsec = (long)(remaining % 1000000000);
+        // The futex only sleeps if the word still holds the frame number read above
+        m_header->waiters.fetch_add(1, std::memory_order_seq_cst);
+        sharedFrameFutex(&m_header->futex, FUTEX_WAIT, (uint32_t)published, &timeout);
+        m_header->waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+bool SharedFrameReader::isValid(const Frame& frame) const {
+    if (m_header == nullptr)
+        return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot(frame.slot)->version.load(std::memory_order_relaxed) == frame.version;
+}
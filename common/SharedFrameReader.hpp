@@ -0,0 +1,87 @@
+#ifndef SHAREDFRAMEREADER_HPP
+#define SHAREDFRAMEREADER_HPP
+
+#include <stddef.h>
+#include <string>
+
+#include "SharedFrameLayout.hpp"
+
+/**
+ * SharedFrameReader - Attaches to a SharedFrameRing published by another process.
+ *
+ * Only depends on POSIX, so consumers do not need OpenCV. acquire() sleeps on the ring's
+ * futex until a newer frame is published and returns it in place: data points into the
+ * shared mapping, nothing is copied. The writer may overwrite the slot once it has published
+ * slotCount - 1 further frames, so after using a frame call isValid(); if it returns false
+ * the frame was torn and whatever was computed from it should be discarded.
+ */
+class SharedFrameReader {
+public:
+    /**
+     * A frame inside the shared mapping, valid until the writer reuses its slot
+     */
+    struct Frame {
+        const unsigned char* data;
+        int width;
+        int height;
+        int type;           //!< OpenCV type code, e.g. 24 = CV_8UC4
+        int stride;         //!< bytes per row
+        uint32_t flags;     //!< SHAREDFRAME_BOTTOM_UP
+        uint64_t number;    //!< frame number, consecutive on the writer side
+        double timestamp;   //!< steady clock (CLOCK_MONOTONIC) seconds
+
+        uint32_t version;   //!< slot seqlock version the frame was read at
+        int slot;
+    };
+
+    SharedFrameReader();
+    ~SharedFrameReader();
+
+    /**
+     * Map a ring created by SharedFrameRing::create
+     * @param name Same name the writer used
+     * @return False if the object does not exist or is not a frame ring
+     */
+    bool open(const std::string& name);
+
+    void close();
+
+    bool isOpen() const { return m_header != nullptr; }
+
+    /**
+     * Wait for a frame newer than the one returned last and return the newest
+     * @param frame Receives the frame, pointing into shared memory
+     * @param timeoutMs Longest wait, 0 to only poll
+     * @return False on timeout
+     */
+    bool acquire(Frame& frame, int timeoutMs);
+
+    /**
+     * Check that a frame from acquire() was not overwritten, call after using its data
+     * @param frame Frame returned by acquire()
+     * @return True if the data read since acquire() is consistent
+     */
+    bool isValid(const Frame& frame) const;
+
+    /**
+     * Frames published but never returned because newer ones were available
+     */
+    uint64_t getSkipped() const { return m_skipped; }
+
+    /**
+     * Process id of the writer, e.g. to check with kill(pid, 0) whether it is still running
+     */
+    int getWriterPid() const;
+
+private:
+    const SharedFrameSlot* slot(uint64_t index) const;
+
+    int m_fd;
+    unsigned char* m_memory;
+    size_t m_size;
+    SharedFrameHeader* m_header;
+    uint64_t m_last;
+    uint64_t m_skipped;
+};
+
+#endif // SHAREDFRAMEREADER_HPP
@@ -0,0 +1,115 @@
+#include "SharedFrameRing.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+SharedFrameRing::SharedFrameRing() : m_fd(-1), m_memory(nullptr), m_size(0), m_header(nullptr) {
+}
+
+SharedFrameRing::~SharedFrameRing() {
+    destroy();
+}
+
+bool SharedFrameRing::create(const std::string& name, int slotCount, size_t capacity) {
+    destroy();
+    if (slotCount < 2)
+        slotCount = 2;
+    const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t slotOffset = (sizeof(SharedFrameHeader) + pageSize - 1) / pageSize * pageSize;
+    const size_t slotBytes = (SHAREDFRAME_DATA_OFFSET + capacity + pageSize - 1) / pageSize * pageSize;
+    const size_t size = slotOffset + slotBytes * slotCount;
+
+    m_name = sharedFrameObjectName(name);
+    // A ring left by an earlier run is unlinked, not truncated: readers still attached keep
+    // their (now orphaned) pages instead of getting SIGBUS, and the new object starts zeroed
+    shm_unlink(m_name.c_str());
+    m_fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (m_fd < 0) {
+        fprintf(stderr, "SharedFrameRing: cannot create %s: %s\n", m_name.c_str(), strerror(errno));
+        return false;
+    }
+    if (ftruncate(m_fd, (off_t)size) != 0) {
+        fprintf(stderr, "SharedFrameRing: cannot size %s to %zu bytes: %s\n", m_name.c_str(), size, strerror(errno));
+        destroy();
+        return false;
+    }
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (memory == MAP_FAILED) {
+        fprintf(stderr, "SharedFrameRing: cannot map %s: %s\n", m_name.c_str(), strerror(errno));
+        destroy();
+        return false;
+    }
+    m_memory = (unsigned char*)memory;
+    m_size = size;
+
+    // The object is zero filled, which is a valid state for every atomic and slot
+    SharedFrameHeader* header = (SharedFrameHeader*)m_memory;
+    header->version = SHAREDFRAME_VERSION;
+    header->slotCount = (uint32_t)slotCount;
+    header->writerPid = (int32_t)getpid();
+    header->slotOffset = slotOffset;
+    header->slotBytes = slotBytes;
+    header->capacity = capacity;
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(header->magic, SHAREDFRAME_MAGIC, 4);
+    m_header = header;
+    return true;
+}
+
+void SharedFrameRing::destroy() {
+    if (m_memory != nullptr) {
+        m_header = nullptr;
+        munmap(m_memory, m_size);
+        m_memory = nullptr;
+        m_size = 0;
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+        m_fd = -1;
+        shm_unlink(m_name.c_str());
+    }
+}
+
+SharedFrameSlot* SharedFrameRing::slot(uint64_t index) const {
+    return (SharedFrameSlot*)(m_memory + m_header->slotOffset + index * m_header->slotBytes);
+}
+
+uint64_t SharedFrameRing::getPublished() const {
+    return m_header != nullptr ? m_header->published.load() : 0;
+}
+
+bool SharedFrameRing::publish(const unsigned char* data, int width, int height, int type, int stride,
+                              double timestamp, uint32_t flags) {
+    if (m_header == nullptr || width <= 0 || height <= 0 || (uint64_t)height * stride > m_header->capacity)
+        return false;
+    const uint64_t number = m_header->published.load(std::memory_order_relaxed) + 1;
+    SharedFrameSlot* target = slot((number - 1) % m_header->slotCount);
+
+    // Seqlock write: odd version, then the data, then the next even version
+    const uint32_t version = target->version.load(std::memory_order_relaxed);
+    target->version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    target->flags = flags;
+    target->frameNumber = number;
+    target->timestamp = timestamp;
+    target->width = (uint32_t)width;
+    target->height = (uint32_t)height;
+    target->type = type;
+    target->stride = (uint32_t)stride;
+    memcpy((unsigned char*)target + SHAREDFRAME_DATA_OFFSET, data, (size_t)height * stride);
+    target->version.store(version + 2, std::memory_order_release);
+
+    m_header->published.store(number, std::memory_order_release);
+    // Store then load on different words: both sequentially consistent (as the reader's increment of
+    // waiters), otherwise the load may pass the store and miss a reader about to sleep on the old value
+    m_header->futex.store((uint32_t)number, std::memory_order_seq_cst);
+    // The syscall is only paid when someone sleeps
+    if (m_header->waiters.load(std::memory_order_seq_cst) > 0)
+        sharedFrameFutex(&m_header->futex, FUTEX_WAKE, INT_MAX, nullptr);
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef SHAREDFRAMERING_HPP
+#define SHAREDFRAMERING_HPP
+
+#include <stddef.h>
+#include <string>
+
+#include "SharedFrameLayout.hpp"
+
+/**
+ * SharedFrameRing - Publishes frames to other local processes through POSIX shared memory.
+ *
+ * The ring is a shm_open object with a few slots (see SharedFrameLayout.hpp). publish()
+ * copies a frame into the oldest slot under its seqlock and wakes waiting readers; readers
+ * (SharedFrameReader) then work on the slot in place, so any number of consumers costs no
+ * further copies. The writer never waits for readers: a reader that falls more than
+ * slotCount - 1 frames behind sees its frame overwritten and skips ahead.
+ */
+class SharedFrameRing {
+public:
+    SharedFrameRing();
+    ~SharedFrameRing();
+
+    /**
+     * Create the shared memory object; one left by an earlier run is unlinked and replaced
+     * @param name Object name, e.g. "vc_frames" (appears as /dev/shm/vc_frames)
+     * @param slotCount Frames kept, readers have slotCount - 1 frame times to use one
+     * @param capacity Largest frame in bytes; pages are only backed once written
+     * @return False if the object could not be created or mapped
+     */
+    bool create(const std::string& name, int slotCount = 4, size_t capacity = (size_t)3840 * 2160 * 4);
+
+    /**
+     * Unmap and remove the object; attached readers keep their mapping until they close it
+     */
+    void destroy();
+
+    bool isOpen() const { return m_header != nullptr; }
+
+    /**
+     * Copy a frame into the next slot and make it the newest
+     * @param data First row
+     * @param width Width in pixels
+     * @param height Rows
+     * @param type OpenCV type code
+     * @param stride Bytes between rows in data; rows are stored with the same stride
+     * @param timestamp Steady clock seconds
+     * @param flags SHAREDFRAME_BOTTOM_UP if row 0 is the bottom of the image
+     * @return False if the frame is larger than the capacity
+     */
+    bool publish(const unsigned char* data, int width, int height, int type, int stride, double timestamp,
+                 uint32_t flags = 0);
+
+    uint64_t getPublished() const;
+
+private:
+    SharedFrameSlot* slot(uint64_t index) const;
+
+    std::string m_name;
+    int m_fd;
+    unsigned char* m_memory;
+    size_t m_size;
+    SharedFrameHeader* m_header;
+};
+
+#endif // SHAREDFRAMERING_HPP
@@ -0,0 +1,91 @@
+#include "SyntheticFrameSource.hpp"
+
+#include <chrono>
+#include <algorithm>
+
+SyntheticFrameSource::SyntheticFrameSource(int width, int height, unsigned int seed)
+    : m_width(width), m_height(height), m_seed(seed), m_frameIndex(0), m_timestamp(-1.0) {
+    buildPattern();
+}
+
+void SyntheticFrameSource::buildPattern() {
+    // Horizontal hue ramp over a vertical brightness ramp, repeated once so any window wraps seamlessly
+    int period = m_width;
+    m_pattern.create(m_height, 2 * period, CV_8UC3);
+    for (int y = 0; y < m_height; y++) {
+        cv::Vec3b* row = m_pattern.ptr<cv::Vec3b>(y);
+        int value = 64 + 191 * y / std::max(1, m_height - 1);
+        for (int x = 0; x < period; x++) {
+            int phase = 765 * x / period;   // three 255 wide segments
+            int r = phase < 255 ? 255 - phase : (phase < 510 ? 0 : phase - 510);
+            int g = phase < 255 ? phase : (phase < 510 ? 510 - phase : 0);
+            int b = phase < 255 ? 0 : (phase < 510 ? phase - 255 : 765 - phase);
+            cv::Vec3b color((uchar)(b * value / 255), (uchar)(g * value / 255), (uchar)(r * value / 255));
+            row[x] = color;
+            row[x + period] = color;
+        }
+    }
+
+    // Saturated red blocks (kept by the Sin City filter) and black and white edges
+    int block = std::max(8, m_height / 8);
+    for (int x = block / 2; x + block < period; x += 3 * block) {
+        cv::Rect red(x, m_height / 4, block, block);
+        cv::Rect white(x + block, m_height / 2, block / 2, block);
+        cv::rectangle(m_pattern, red, cv::Scalar(20, 20, 230), cv::FILLED);
+        cv::rectangle(m_pattern, red + cv::Point(period, 0), cv::Scalar(20, 20, 230), cv::FILLED);
+        cv::rectangle(m_pattern, white, cv::Scalar(255, 255, 255), cv::FILLED);
+        cv::rectangle(m_pattern, white + cv::Point(period, 0), cv::Scalar(255, 255, 255), cv::FILLED);
+    }
+
+    // Sensor-like noise in the lower third
+    cv::RNG rng(m_seed);
+    cv::Mat noise(m_height / 3, period, CV_8UC3);
+    rng.fill(noise, cv::RNG::UNIFORM, 0, 256);
+    noise.copyTo(m_pattern(cv::Rect(0, m_height - noise.rows, period, noise.rows)));
+    noise.copyTo(m_pattern(cv::Rect(period, m_height - noise.rows, period, noise.rows)));
+
+    m_frameIndex = 0;
+}
+
+bool SyntheticFrameSource::isOpened() const {
+    return !m_pattern.empty();
+}
+
+bool SyntheticFrameSource::read(cv::Mat& frame) {
+    if (m_pattern.empty())
+        return false;
+    // Scroll by 4 pixels per frame, copied so the caller gets continuous rows like a capture
+    int offset = (m_frameIndex * 4) % m_width;
+    m_pattern(cv::Rect(offset, 0, m_width, m_height)).copyTo(m_frame);
+    frame = m_frame;
+    m_frameIndex++;
+    m_timestamp = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    return true;
+}
+
+double SyntheticFrameSource::getTimestamp() const {
+    return m_timestamp;
+}
+
+int SyntheticFrameSource::getWidth() const {
+    return m_width;
+}
+
+int SyntheticFrameSource::getHeight() const {
+    return m_height;
+}
+
+void SyntheticFrameSource::release() {
+    m_pattern.release();
+    m_frame.release();
+}
+
+void SyntheticFrameSource::setSize(int width, int height) {
+    if (width == m_width && height == m_height && !m_pattern.empty()) {
+        m_frameIndex = 0;
+        return;
+    }
+    m_width = width;
+    m_height = height;
+    buildPattern();
+}
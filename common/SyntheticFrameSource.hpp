@@ -0,0 +1,53 @@
+#ifndef SYNTHETICFRAMESOURCE_HPP
+#define SYNTHETICFRAMESOURCE_HPP
+
+#include "FrameSource.hpp"
+
+/**
+ * SyntheticFrameSource - FrameSource that generates a deterministic moving test pattern.
+ *
+ * The pattern has colour gradients, hard edges and a noise patch, so every filter has work
+ * comparable to a camera image, and it scrolls a few pixels per frame so every frame differs.
+ * Frames are produced without waiting for a frame rate; used by the benchmarks and validators
+ * where no camera is available.
+ */
+class SyntheticFrameSource : public FrameSource {
+public:
+    /**
+     * Create a source
+     * @param width Frame width
+     * @param height Frame height
+     * @param seed Seed of the noise patch, equal seeds give identical frame sequences
+     */
+    SyntheticFrameSource(int width, int height, unsigned int seed = 12345);
+
+    bool isOpened() const override;
+    bool read(cv::Mat& frame) override;
+    double getTimestamp() const override;
+    int getWidth() const override;
+    int getHeight() const override;
+    void release() override;
+
+    /**
+     * Change the frame size, the sequence restarts at frame 0
+     */
+    void setSize(int width, int height);
+
+    /**
+     * Frames delivered since creation or the last setSize()
+     */
+    int getFrameIndex() const { return m_frameIndex; }
+
+private:
+    void buildPattern();
+
+    cv::Mat m_pattern;      //!< twice the frame width, frames are scrolling windows into it
+    cv::Mat m_frame;
+    int m_width;
+    int m_height;
+    unsigned int m_seed;
+    int m_frameIndex;
+    double m_timestamp;
+};
+
+#endif // SYNTHETICFRAMESOURCE_HPP
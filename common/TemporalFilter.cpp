@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+
+#include "TemporalFilter.hpp"
+#include <opencv2/core/hal/intrin.hpp>
+
+static const int FRACTION_BITS = 7;    // 255 << 7 still fits a short
+
+// log2 of 1 / weight, rounded, for an average whose weight is about 2 / (frames + 1)
+static int averageShift(int frames) {
+    int shift = (int)std::lround(std::log2((frames + 1) * 0.5));
+    return std::max(0, std::min(shift, 7));
+}
+
+TemporalFilter::TemporalFilter()
+    : m_length(8), m_averageShift(averageShift(8)), m_trailShift(2), m_motionThreshold(30),
+      m_valid(false), m_mode(DENOISE), m_type(-1) {
+}
+
+void TemporalFilter::setHistoryLength(int length) {
+    m_length = std::max(1, std::min(length, 64));
+    m_averageShift = averageShift(m_length);
+}
+
+void TemporalFilter::setTrailDecay(float decay) {
+    decay = std::max(0.0f, std::min(decay, 0.99f));
+    m_trailShift = (int)std::lround(std::log2(1.0 / (1.0 - decay)));
+    m_trailShift = std::max(1, std::min(m_trailShift, 7));
+}
+
+// average += (value - average) >> shift for one row, n elements; out receives the new average
+static void accumulateRow(short* average, const uchar* src, uchar* out, int n, int shift) {
+    int i = 0;
+#if CV_SIMD128
+    const cv::v_int16x8 half = cv::v_setall_s16(1 << (FRACTION_BITS - 1));
+    for (; i <= n - 8; i += 8) {
+        cv::v_int16x8 value = cv::v_reinterpret_as_s16(cv::v_load_expand(src + i) << FRACTION_BITS);
+        cv::v_int16x8 sum = cv::v_load(average + i);
+        sum = sum + ((value - sum) >> shift);
+        cv::v_store(average + i, sum);
+        if (out != nullptr)
+            cv::v_pack_u_store(out + i, (sum + half) >> FRACTION_BITS);
+    }
+#endif
+    for (; i < n; i++) {
+        int sum = average[i] + (((src[i] << FRACTION_BITS) - average[i]) >> shift);
+        average[i] = (short)sum;
+        if (out != nullptr)
+            out[i] = (uchar)((sum + (1 << (FRACTION_BITS - 1))) >> FRACTION_BITS);
+    }
+}
+
+// Moving pixels keep their colour, static ones get the Sin City black and white threshold.
+// Compares against the average before the current frame is added to it
+template <int CN>
+static void motionRow(const short* average, const uchar* src, uchar* dst, int cols, int threshold) {
+    const int limit = threshold << FRACTION_BITS;
+    for (int x = 0; x < cols; x++, src += CN, dst += CN, average += CN) {
+        int difference = 0;
+        for (int c = 0; c < 3; c++)
+            difference = std::max(difference, std::abs((src[c] << FRACTION_BITS) - average[c]));
+        if (difference > limit) {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+        } else {
+            // (gray - 0.5) * 1.5 + 0.5 >= 0.5 exactly when gray >= 0.5
+            uchar value = 114 * src[0] + 587 * src[1] + 299 * src[2] >= 127500 ? 255 : 0;
+            dst[0] = dst[1] = dst[2] = value;
+        }
+        if (CN == 4)
+            dst[3] = src[3];
+    }
+}
+
+void TemporalFilter::apply(const cv::Mat& input, cv::Mat& output, Mode mode) {
+    CV_Assert(input.depth() == CV_8U && (input.channels() == 3 || input.channels() == 4));
+    output.create(input.size(), input.type());
+    const int n = input.cols * input.channels();
+
+    if (!m_valid || input.size() != m_size || input.type() != m_type || mode != m_mode) {
+        // Start from the current frame, as if it had always been there
+        m_average.resize((size_t)n * input.rows);
+        for (int y = 0; y < input.rows; y++) {
+            const uchar* src = input.ptr<uchar>(y);
+            short* average = &m_average[(size_t)y * n];
+            for (int i = 0; i < n; i++)
+                average[i] = (short)(src[i] << FRACTION_BITS);
+        }
+        m_size = input.size();
+        m_type = input.type();
+        m_mode = mode;
+        m_valid = true;
+    }
+
+    const int shift = mode == TRAILS ? m_trailShift : m_averageShift;
+    const int channels = input.channels();
+    cv::parallel_for_(cv::Range(0, input.rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; y++) {
+            const uchar* src = input.ptr<uchar>(y);
+            uchar* dst = output.ptr<uchar>(y);
+            short* average = &m_average[(size_t)y * n];
+            if (mode == MOTION) {
+                if (channels == 4)
+                    motionRow<4>(average, src, dst, input.cols, m_motionThreshold);
+                else
+                    motionRow<3>(average, src, dst, input.cols, m_motionThreshold);
+                accumulateRow(average, src, nullptr, n, shift);
+            } else {
+                accumulateRow(average, src, dst, n, shift);
+                if (channels == 4) {
+                    for (int x = 3; x < n; x += 4)
+                        dst[x] = src[x];
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,70 @@
+#ifndef TEMPORALFILTER_HPP
+#define TEMPORALFILTER_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * TemporalFilter - CPU fallback for the temporal shaders (FrameHistory + temporal.frag).
+ *
+ * Instead of keeping the last N frames it keeps one exponential running average per channel
+ * in 16-bit fixed point (8.7), so memory and work per frame do not grow with the history
+ * length. An average with weight 2 / (N + 1) has the same mean age as an N frame window; the
+ * weight is rounded to a power of two so the update is a shift. Results are close to the GPU
+ * modes, not identical: the window there is a plain mean, here older frames fade out.
+ */
+class TemporalFilter {
+public:
+    enum Mode { DENOISE, MOTION, TRAILS };
+
+    TemporalFilter();
+
+    /**
+     * Number of frames the denoise and motion averages should span
+     * @param length 1 to 64 frames, 1 passes frames through
+     */
+    void setHistoryLength(int length);
+    int getHistoryLength() const { return m_length; }
+
+    /**
+     * @param threshold Largest channel difference (0-255) to the background still treated as static
+     */
+    void setMotionThreshold(int threshold) { m_motionThreshold = threshold; }
+
+    /**
+     * @param decay Weight factor per frame of age for the trails, rounded to 1 - 1/2^k
+     */
+    void setTrailDecay(float decay);
+
+    /**
+     * Forget the history, the next frame starts a new one
+     */
+    void reset() { m_valid = false; }
+
+    /**
+     * True once a frame went into the history (until reset())
+     */
+    bool hasHistory() const { return m_valid; }
+
+    /**
+     * Add a frame to the history and filter it
+     * @param input 8-bit BGR or BGRA frame; a new size, type or mode restarts the history
+     * @param output Filtered frame, alpha is copied
+     * @param mode DENOISE: the average, MOTION: moving pixels in colour over a black and white
+     *             background, TRAILS: a slower average that leaves ghosts behind moving objects
+     */
+    void apply(const cv::Mat& input, cv::Mat& output, Mode mode);
+
+private:
+    int m_length;
+    int m_averageShift;         //!< log2 of 1 / weight for denoise and motion
+    int m_trailShift;
+    int m_motionThreshold;
+    bool m_valid;
+    Mode m_mode;
+    cv::Size m_size;
+    int m_type;
+    std::vector<short> m_average;   //!< 8.7 fixed point, one value per channel
+};
+
+#endif // TEMPORALFILTER_HPP
@@ -0,0 +1,47 @@
+#include "TemporalShader.hpp"
+#include <stdio.h>
+
+TemporalShader::TemporalShader(std::string vertexShaderName, std::string fragmentShaderName)
+    : Shader(vertexShaderName, fragmentShaderName), history(nullptr), mode(DENOISE),
+      motionThreshold(0.12f), trailDecay(0.8f) {
+    historyLocation = glGetUniformLocation(programID, "historySampler");
+    newestLayerLocation = glGetUniformLocation(programID, "newestLayer");
+    frameCountLocation = glGetUniformLocation(programID, "frameCount");
+    ringSizeLocation = glGetUniformLocation(programID, "ringSize");
+    modeLocation = glGetUniformLocation(programID, "mode");
+    motionThresholdLocation = glGetUniformLocation(programID, "motionThreshold");
+    trailDecayLocation = glGetUniformLocation(programID, "trailDecay");
+
+    if (historyLocation == -1) {
+        printf("Warning: Could not find 'historySampler' uniform in temporal shader\n");
+    }
+}
+
+void TemporalShader::setHistory(FrameHistory* frameHistory) {
+    history = frameHistory;
+}
+
+void TemporalShader::setMode(Mode filterMode) {
+    mode = filterMode;
+}
+
+void TemporalShader::setMotionThreshold(float threshold) {
+    motionThreshold = threshold;
+}
+
+void TemporalShader::setTrailDecay(float decay) {
+    trailDecay = decay;
+}
+
+void TemporalShader::bind() {
+    glUseProgram(programID);
+    if (history != nullptr)
+        history->bindTexture(0);
+    glUniform1i(historyLocation, 0);
+    glUniform1i(newestLayerLocation, history != nullptr ? history->getNewestLayer() : 0);
+    glUniform1i(frameCountLocation, history != nullptr && history->getCount() > 0 ? history->getCount() : 1);
+    glUniform1i(ringSizeLocation, history != nullptr ? history->getLength() : 1);
+    glUniform1i(modeLocation, mode);
+    glUniform1f(motionThresholdLocation, motionThreshold);
+    glUniform1f(trailDecayLocation, trailDecay);
+}
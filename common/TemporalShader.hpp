@@ -0,0 +1,47 @@
+#ifndef TEMPORAL_SHADER_HPP
+#define TEMPORAL_SHADER_HPP
+
+#include "Shader.hpp"
+#include "FrameHistory.hpp"
+#include <string>
+
+//!  TemporalShader.
+/*!
+ Filters over the frames of a FrameHistory (temporal.frag): noise averaging, motion highlighting
+ (moving regions in colour, the rest in Sin City black and white) and ghost trails.
+ */
+class TemporalShader : public Shader {
+private:
+    GLint historyLocation;
+    GLint newestLayerLocation;
+    GLint frameCountLocation;
+    GLint ringSizeLocation;
+    GLint modeLocation;
+    GLint motionThresholdLocation;
+    GLint trailDecayLocation;
+    FrameHistory* history;
+    int mode;
+    float motionThreshold;
+    float trailDecay;
+
+public:
+    //! Filter modes, values match the mode uniform read in temporal.frag
+    enum Mode { DENOISE = 0, MOTION = 1, TRAILS = 2 };
+
+    TemporalShader(std::string vertexShaderName, std::string fragmentShaderName);
+
+    //! setHistory
+    /*! Frames to filter, not owned. */
+    void setHistory(FrameHistory* frameHistory);
+    void setMode(Mode filterMode);
+    //! setMotionThreshold
+    /*! Largest channel difference (0..1) to the mean of the older frames that still counts as static. */
+    void setMotionThreshold(float threshold);
+    //! setTrailDecay
+    /*! Weight factor per frame of age for the trails. */
+    void setTrailDecay(float decay);
+
+    void bind() override;
+};
+
+#endif // TEMPORAL_SHADER_HPP
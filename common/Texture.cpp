@@ -5,17 +5,20 @@
 #include <GLFW/glfw3.h>
 
 #include "Texture.hpp"
+#include "TextureLoader.hpp"
 
-Texture::Texture() : m_textureID(0) {}
+Texture::Texture() : m_textureID(0), m_width(0), m_height(0), m_internalFormat(0), m_immutable(false) {}
 
-Texture::Texture(std::string filename) {
+Texture::Texture(std::string filename) : m_width(0), m_height(0), m_internalFormat(0), m_immutable(false) {
     if (filename.find("dds") != std::string::npos || filename.find("DDS") != std::string::npos)
         m_textureID = loadDDS(filename.c_str());
     else
         m_textureID = loadBMP_custom(filename.c_str());
 }
 
-Texture::Texture(int w, int h) {
+Texture::Texture(GLuint textureID) : m_textureID(textureID), m_width(0), m_height(0), m_internalFormat(0), m_immutable(false) {}
+
+Texture::Texture(int w, int h) : m_width(w), m_height(h), m_internalFormat(GL_RGB), m_immutable(false) {
     glGenTextures(1, &m_textureID);
     glBindTexture(GL_TEXTURE_2D, m_textureID);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
@@ -25,7 +28,8 @@ Texture::Texture(int w, int h) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 }
 
-Texture::Texture(unsigned char* data, int width, int height, bool bgrFormat) {
+Texture::Texture(unsigned char* data, int width, int height, bool bgrFormat)
+    : m_width(width), m_height(height), m_internalFormat(GL_RGB), m_immutable(false) {
     glGenTextures(1, &m_textureID);
     glBindTexture(GL_TEXTURE_2D, m_textureID);
     GLenum inputFormat = bgrFormat ? GL_BGR : GL_RGB;
@@ -51,129 +55,99 @@ GLuint Texture::getTextureID() {
     return m_textureID;
 }
 
+// File loading goes through the memory-mapped loader, see TextureLoader.hpp
 GLuint Texture::loadBMP_custom(const char* imagepath) {
-    printf("Reading image %s\n", imagepath);
-
-    unsigned char header[54];
-    unsigned int dataPos;
-    unsigned int imageSize;
-    unsigned int width, height;
-    unsigned char* data;
-
-    FILE* file = fopen(imagepath, "rb");
-    if (!file) {
-        printf("%s could not be opened.\n", imagepath);
-        return 0;
-    }
-
-    if (fread(header, 1, 54, file) != 54) {
-        printf("Not a correct BMP file\n");
-        return 0;
-    }
-    if (header[0] != 'B' || header[1] != 'M') {
-        printf("Not a correct BMP file\n");
-        return 0;
-    }
-    if (*(int*)&(header[0x1E]) != 0 || *(int*)&(header[0x1C]) != 24) {
-        printf("Not a 24bpp BMP file\n");
-        return 0;
-    }
-
-    dataPos = *(int*)&(header[0x0A]);
-    imageSize = *(int*)&(header[0x22]);
-    width = *(int*)&(header[0x12]);
-    height = *(int*)&(header[0x16]);
-
-    if (imageSize == 0) imageSize = width * height * 3;
-    if (dataPos == 0) dataPos = 54;
-
-    data = new unsigned char[imageSize];
-    fread(data, 1, imageSize, file);
-    fclose(file);
-
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_BGR, GL_UNSIGNED_BYTE, data);
-    delete[] data;
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    return textureID;
+    return TextureLoader::loadBMP(imagepath);
 }
 
-#define FOURCC_DXT1 0x31545844
-#define FOURCC_DXT3 0x33545844
-#define FOURCC_DXT5 0x35545844
-
 GLuint Texture::loadDDS(const char* imagepath) {
-    unsigned char header[124];
-    FILE* fp = fopen(imagepath, "rb");
-    if (fp == NULL) {
-        printf("%s could not be opened.\n", imagepath);
-        return 0;
-    }
-
-    char filecode[4];
-    fread(filecode, 1, 4, fp);
-    if (strncmp(filecode, "DDS ", 4) != 0) {
-        fclose(fp);
-        return 0;
-    }
-
-    fread(&header, 124, 1, fp);
-
-    unsigned int height = *(unsigned int*)&(header[8]);
-    unsigned int width = *(unsigned int*)&(header[12]);
-    unsigned int linearSize = *(unsigned int*)&(header[16]);
-    unsigned int mipMapCount = *(unsigned int*)&(header[24]);
-    unsigned int fourCC = *(unsigned int*)&(header[80]);
-
-    unsigned int bufsize = mipMapCount > 1 ? linearSize * 2 : linearSize;
-    unsigned char* buffer = (unsigned char*)malloc(bufsize);
-    fread(buffer, 1, bufsize, fp);
-    fclose(fp);
-
-    unsigned int format;
-    switch (fourCC) {
-        case FOURCC_DXT1: format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
-        case FOURCC_DXT3: format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; break;
-        case FOURCC_DXT5: format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
-        default:
-            free(buffer);
-            return 0;
-    }
-
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-    unsigned int blockSize = (format == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT) ? 8 : 16;
-    unsigned int offset = 0;
-
-    for (unsigned int level = 0; level < mipMapCount && (width || height); ++level) {
-        unsigned int size = ((width + 3) / 4) * ((height + 3) / 4) * blockSize;
-        glCompressedTexImage2D(GL_TEXTURE_2D, level, format, width, height, 0, size, buffer + offset);
-        offset += size;
-        width /= 2;
-        height /= 2;
-        if (width < 1) width = 1;
-        if (height < 1) height = 1;
-    }
+    return TextureLoader::loadDDS(imagepath);
+}
 
-    free(buffer);
-    return textureID;
+void Texture::recreate() {
+    if (m_textureID)
+        glDeleteTextures(1, &m_textureID);
+    glGenTextures(1, &m_textureID);
+    m_immutable = false;
 }
+
 void Texture::update(unsigned char* data, int width, int height, bool bgrFormat) {
+    if (m_immutable)
+        recreate();
    
 	 glBindTexture(GL_TEXTURE_2D, m_textureID);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, bgrFormat ? GL_BGR : GL_RGB, GL_UNSIGNED_BYTE, data);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);				
+        m_width = width;
+        m_height = height;
+        m_internalFormat = GL_RGB;
+}
+
+void Texture::updateCompressed(const unsigned char* data, int width, int height, GLenum format, GLsizei imageSize) {
+    if (m_immutable && (width != m_width || height != m_height || format != m_internalFormat))
+        recreate();
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    if (width != m_width || height != m_height || format != m_internalFormat) {
+        // (Re)allocate compressed storage, single level only
+        glCompressedTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, imageSize, data);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        m_width = width;
+        m_height = height;
+        m_internalFormat = format;
+    } else {
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, imageSize, data);
+    }
+}
+
+bool Texture::updateRegion(const unsigned char* data, int stride, int x, int y, int width, int height, bool bgrFormat) {
+    if ((m_internalFormat != GL_RGB && m_internalFormat != GL_RGBA8) ||
+        x < 0 || y < 0 || x + width > m_width || y + height > m_height) {
+        fprintf(stderr, "Texture::updateRegion: %dx%d at (%d, %d) does not fit the texture\n", width, height, x, y);
+        return false;
+    }
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    // Let GL walk the full frame rows instead of packing the rectangle first
+    int channels = m_internalFormat == GL_RGBA8 ? 4 : 3;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / channels);
+    if (channels == 4)
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, bgrFormat ? GL_BGRA : GL_RGBA,
+                        GL_UNSIGNED_INT_8_8_8_8_REV, data + (size_t)y * stride + (size_t)x * 4);
+    else
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, bgrFormat ? GL_BGR : GL_RGB, GL_UNSIGNED_BYTE,
+                        data + (size_t)y * stride + (size_t)x * 3);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    return true;
+}
+
+void Texture::updateBGRA(const unsigned char* data, int width, int height, int stride) {
+    if (width != m_width || height != m_height || m_internalFormat != GL_RGBA8) {
+        // Immutable storage cannot be resized, start over with a fresh texture object
+        recreate();
+        glBindTexture(GL_TEXTURE_2D, m_textureID);
+        if (GLAD_GL_VERSION_4_2 || GLAD_GL_ARB_texture_storage) {
+            glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+            m_immutable = true;
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, nullptr);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        m_width = width;
+        m_height = height;
+        m_internalFormat = GL_RGBA8;
+    } else {
+        glBindTexture(GL_TEXTURE_2D, m_textureID);
+    }
+    // BGRA as packed 32-bit words is the layout drivers copy without swizzling
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, data);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 }
@@ -17,6 +17,7 @@ class Texture {
 public:
     Texture();
     Texture(std::string filename);
+    explicit Texture(GLuint textureID); // takes ownership of an existing texture
     Texture(int w, int h);
     Texture(unsigned char* data, int width, int height, bool bgrFormat = true);
     ~Texture();
@@ -24,13 +25,28 @@ public:
     void bindTexture();
     GLuint getTextureID();
     void update(unsigned char* data, int width, int height, bool bgrFormat = true);
+    // Upload pre-compressed data (e.g. GL_COMPRESSED_RGBA_S3TC_DXT1_EXT). Storage is only
+    // reallocated when size or format change, otherwise glCompressedTexSubImage2D is used.
+    void updateCompressed(const unsigned char* data, int width, int height, GLenum format, GLsizei imageSize);
+    // Upload a sub-rectangle of a frame that already has the texture's size. data points to the
+    // frame's first pixel, stride is its row pitch in bytes, so no copy of the rectangle is needed.
+    bool updateRegion(const unsigned char* data, int stride, int x, int y, int width, int height, bool bgrFormat = true);
+    // Upload a 4-channel BGRA frame (see FrameFormat) into GL_RGBA8 storage. Storage is allocated
+    // once per size (immutable where glTexStorage2D is available), frames go through glTexSubImage2D.
+    void updateBGRA(const unsigned char* data, int width, int height, int stride);
 
 
 private:
     GLuint loadBMP_custom(const char* imagepath);
     GLuint loadDDS(const char* imagepath);
+    // Replace the texture object, needed before re-specifying immutable storage
+    void recreate();
 
     GLuint m_textureID;
+    int m_width;
+    int m_height;
+    GLenum m_internalFormat;
+    bool m_immutable;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include <stdio.h>
+
+#include "TextureArray.hpp"
+
+TextureArray::TextureArray(int width, int height, int layers)
+    : m_textureID(0), m_width(width), m_height(height), m_layers(layers) {
+    glGenTextures(1, &m_textureID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGB8, width, height, layers, 0, GL_BGR, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+TextureArray::~TextureArray() {
+    glDeleteTextures(1, &m_textureID);
+}
+
+void TextureArray::updateLayer(int layer, const unsigned char* data, bool bgrFormat) {
+    if (layer < 0 || layer >= m_layers) {
+        fprintf(stderr, "TextureArray: layer %d out of range (%d layers)\n", layer, m_layers);
+        return;
+    }
+    // 3 channel rows are not necessarily 4-byte aligned
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_width, m_height, 1,
+                    bgrFormat ? GL_BGR : GL_RGB, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void TextureArray::updateLayer(int layer, const unsigned char* data, int stride, int channels) {
+    if (layer < 0 || layer >= m_layers) {
+        fprintf(stderr, "TextureArray: layer %d out of range (%d layers)\n", layer, m_layers);
+        return;
+    }
+    if (channels != 3 && channels != 4) {
+        fprintf(stderr, "TextureArray: %d channel frames are not supported\n", channels);
+        return;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / channels);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_width, m_height, 1,
+                    channels == 4 ? GL_BGRA : GL_BGR, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void TextureArray::bindTexture(int unit) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID);
+    glActiveTexture(GL_TEXTURE0);
+}
@@ -0,0 +1,50 @@
+/*
+ * TextureArray.hpp
+ *
+ *  Class for a 2D texture array (GL_TEXTURE_2D_ARRAY). All layers share one size and format,
+ *  so a single sampler binding serves many video streams.
+ *
+ */
+#ifndef TEXTUREARRAY_HPP
+#define TEXTUREARRAY_HPP
+
+#include <glad/gl.h>
+
+//!  TextureArray.
+/*!
+ Fixed size array of 8-bit RGB layers, updated one layer at a time with glTexSubImage3D.
+ */
+class TextureArray {
+public:
+    //! Constructor
+    /*! Allocates storage for all layers, contents are undefined until updated. */
+    TextureArray(int width, int height, int layers);
+    //! Destructor
+    /*! Deletes the texture. */
+    ~TextureArray();
+
+    //! updateLayer
+    /*! Uploads a tightly packed 3 channel frame of exactly getWidth() x getHeight() into one layer. */
+    void updateLayer(int layer, const unsigned char* data, bool bgrFormat = true);
+    //! updateLayer
+    /*! Uploads a BGR or BGRA frame of getWidth() x getHeight() with a row pitch of stride bytes,
+        straight from the frame rows (no repacking of padded or aligned frames). */
+    void updateLayer(int layer, const unsigned char* data, int stride, int channels);
+
+    //! bindTexture
+    /*! Binds the array to the given texture unit. */
+    void bindTexture(int unit = 0);
+
+    GLuint getTextureID() const { return m_textureID; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    int getLayers() const { return m_layers; }
+
+private:
+    GLuint m_textureID;
+    int m_width;
+    int m_height;
+    int m_layers;
+};
+
+#endif
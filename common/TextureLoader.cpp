@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "TextureLoader.hpp"
+#include "MappedFile.hpp"
+
+#define FOURCC_DXT1 0x31545844
+#define FOURCC_DXT3 0x33545844
+#define FOURCC_DXT5 0x35545844
+
+// Unaligned little-endian reads from the mapped header
+static uint32_t readU32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static int32_t readS32(const unsigned char* p) {
+    int32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static uint16_t readU16(const unsigned char* p) {
+    uint16_t v;
+    memcpy(&v, p, 2);
+    return v;
+}
+
+GLuint TextureLoader::load(const std::string& filename) {
+    if (filename.find("dds") != std::string::npos || filename.find("DDS") != std::string::npos)
+        return loadDDS(filename.c_str());
+    return loadBMP(filename.c_str());
+}
+
+GLuint TextureLoader::loadBMP(const char* imagepath) {
+    printf("Reading image %s\n", imagepath);
+
+    MappedFile file(imagepath);
+    if (!file.isOpen())
+        return 0;
+
+    const unsigned char* header = file.data();
+    if (file.size() < 54 || header[0] != 'B' || header[1] != 'M') {
+        printf("Not a correct BMP file\n");
+        return 0;
+    }
+    if (readU32(header + 0x1E) != 0 || readU16(header + 0x1C) != 24) {
+        printf("Not a 24bpp BMP file\n");
+        return 0;
+    }
+
+    uint32_t dataPos = readU32(header + 0x0A);
+    int32_t width = readS32(header + 0x12);
+    int32_t height = readS32(header + 0x16);
+    if (dataPos == 0) dataPos = 54;
+    if (width <= 0 || height <= 0) {
+        printf("Unsupported BMP dimensions %d x %d\n", width, height);
+        return 0;
+    }
+
+    // Rows are padded to 4 bytes, which matches the default GL_UNPACK_ALIGNMENT
+    uint64_t rowStride = ((uint64_t)width * 3 + 3) & ~(uint64_t)3;
+    if (dataPos + rowStride * (uint64_t)height > file.size()) {
+        printf("BMP file %s is truncated\n", imagepath);
+        return 0;
+    }
+
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_BGR, GL_UNSIGNED_BYTE, file.data() + dataPos);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    return textureID;
+}
+
+GLuint TextureLoader::loadDDS(const char* imagepath) {
+    printf("Reading image %s\n", imagepath);
+
+    MappedFile file(imagepath);
+    if (!file.isOpen())
+        return 0;
+
+    // "DDS " magic followed by the 124 byte header
+    if (file.size() < 128 || strncmp((const char*)file.data(), "DDS ", 4) != 0) {
+        printf("Not a correct DDS file\n");
+        return 0;
+    }
+    const unsigned char* header = file.data() + 4;
+
+    unsigned int height = readU32(header + 8);
+    unsigned int width = readU32(header + 12);
+    unsigned int mipMapCount = readU32(header + 24);
+    unsigned int fourCC = readU32(header + 80);
+    if (mipMapCount == 0) mipMapCount = 1;
+
+    unsigned int format;
+    switch (fourCC) {
+        case FOURCC_DXT1: format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+        case FOURCC_DXT3: format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT; break;
+        case FOURCC_DXT5: format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+        default:
+            printf("Unsupported DDS format in %s\n", imagepath);
+            return 0;
+    }
+    if (width == 0 || height == 0) {
+        printf("Invalid DDS dimensions in %s\n", imagepath);
+        return 0;
+    }
+
+    unsigned int blockSize = (format == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT) ? 8 : 16;
+    const unsigned char* data = file.data() + 128;
+    uint64_t available = file.size() - 128;
+
+    // Count the levels that are actually present in the file instead of trusting linearSize
+    unsigned int levels = 0;
+    uint64_t required = 0;
+    for (unsigned int w = width, h = height; levels < mipMapCount; ++levels) {
+        uint64_t size = (uint64_t)((w + 3) / 4) * ((h + 3) / 4) * blockSize;
+        if (required + size > available)
+            break;
+        required += size;
+        if (w == 1 && h == 1) { ++levels; break; }
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+    }
+    if (levels == 0) {
+        printf("DDS file %s is truncated\n", imagepath);
+        return 0;
+    }
+    if (levels < mipMapCount)
+        printf("DDS file %s holds %u of %u mip levels\n", imagepath, levels, mipMapCount);
+
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    uint64_t offset = 0;
+    for (unsigned int level = 0; level < levels; ++level) {
+        unsigned int size = ((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, format, width, height, 0, size, data + offset);
+        offset += size;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+    return textureID;
+}
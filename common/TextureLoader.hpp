@@ -0,0 +1,33 @@
+/*
+ * TextureLoader.hpp
+ *
+ *  Loads BMP and DDS images by memory-mapping the file and uploading the
+ *  pixel data (and all DDS mip levels) straight from the mapping.
+ *
+ */
+#ifndef TEXTURELOADER_HPP
+#define TEXTURELOADER_HPP
+
+#include <string>
+
+#include <glad/gl.h>
+
+//!  TextureLoader.
+/*!
+ File texture loading without intermediate heap copies. All headers are validated against the real
+ file size before anything is handed to OpenGL. Needs a current GL context (any thread).
+ */
+class TextureLoader {
+public:
+    //! load
+    /*! Loads a .bmp or .dds file, chosen by extension. Returns the texture name or 0 on failure. */
+    static GLuint load(const std::string& filename);
+    //! loadBMP
+    /*! Loads an uncompressed 24bpp bottom-up BMP and builds mipmaps. */
+    static GLuint loadBMP(const char* imagepath);
+    //! loadDDS
+    /*! Loads a DXT1/3/5 compressed DDS including the mip levels stored in the file. */
+    static GLuint loadDDS(const char* imagepath);
+};
+
+#endif
@@ -1,11 +1,11 @@
 
 #include "TextureShader.hpp"
 
-TextureShader::TextureShader(){
+TextureShader::TextureShader(): m_texture(NULL){
         
     }
 // version of constructor that allows for  vertex and fragment shader with differnt names
-TextureShader::TextureShader(std::string vertexshaderName, std::string fragmentshaderName): Shader(vertexshaderName, fragmentshaderName){
+TextureShader::TextureShader(std::string vertexshaderName, std::string fragmentshaderName): Shader(vertexshaderName, fragmentshaderName), m_texture(NULL){
     
     m_TextureID  = glGetUniformLocation(programID, "myTextureSampler");
     
@@ -13,7 +13,7 @@ TextureShader::TextureShader(std::string vertexshaderName, std::string fragments
 }
 
 // version of constructor that assumes that vertex and fragment shader have same name
-TextureShader::TextureShader(std::string shaderName): Shader(shaderName){
+TextureShader::TextureShader(std::string shaderName): Shader(shaderName), m_texture(NULL){
     
     m_TextureID  = glGetUniformLocation(programID, "myTextureSampler");
     
@@ -31,6 +31,10 @@ void TextureShader::setTexture(Texture* texture){
 
 }
 
+GLuint TextureShader::getTextureID(){
+    return m_texture != NULL ? m_texture->getTextureID() : 0;
+}
+
 void TextureShader::bind(){
     // Use our shader
     glUseProgram(programID);
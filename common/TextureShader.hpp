@@ -30,6 +30,9 @@ class TextureShader: public Shader{
     //! bind
     /*! Bind the shader. */
     void bind();
+    //! getTextureID
+    /*! ID of the referenced texture, 0 if none. */
+    GLuint getTextureID();
     
 
     private:
@@ -0,0 +1,127 @@
+#include <stdio.h>
+
+#include "TextureStreamer.hpp"
+#include "TextureLoader.hpp"
+
+TextureStreamer::TextureStreamer(GLFWwindow* renderWindow) : m_context(nullptr), m_stop(false), m_nextID(0) {
+    // Hidden 1x1 window with the same context version, sharing objects with the render context
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    m_context = glfwCreateWindow(1, 1, "TextureStreamer", NULL, renderWindow);
+    glfwDefaultWindowHints();
+
+    if (m_context == NULL) {
+        fprintf(stderr, "TextureStreamer: failed to create shared context, textures load synchronously\n");
+        return;
+    }
+    m_worker = std::thread(&TextureStreamer::run, this);
+}
+
+TextureStreamer::~TextureStreamer() {
+    if (m_context) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wakeup.notify_all();
+        m_worker.join();
+        glfwDestroyWindow(m_context);
+    }
+
+    // Release everything that was loaded but never handed out
+    for (auto& upload : m_uploads) {
+        if (upload.fence) glDeleteSync(upload.fence);
+        if (upload.textureID) glDeleteTextures(1, &upload.textureID);
+    }
+    for (auto& ready : m_ready)
+        glDeleteTextures(1, &ready.second);
+}
+
+int TextureStreamer::requestTexture(const std::string& filename) {
+    int id = m_nextID++;
+    m_states[id] = State::PENDING;
+
+    if (!m_context) {
+        // No worker: fall back to loading on the calling thread
+        GLuint textureID = TextureLoader::load(filename);
+        m_states[id] = textureID ? State::READY : State::FAILED;
+        if (textureID) m_ready[id] = textureID;
+        return id;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back({ id, filename });
+    }
+    m_wakeup.notify_one();
+    return id;
+}
+
+void TextureStreamer::update() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (!m_uploads.empty()) {
+        Upload& upload = m_uploads.front();
+        if (upload.fence) {
+            // Poll only, never wait on the render thread
+            GLenum status = glClientWaitSync(upload.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                break;
+            glDeleteSync(upload.fence);
+        }
+        if (upload.textureID) {
+            m_ready[upload.id] = upload.textureID;
+            m_states[upload.id] = State::READY;
+        } else {
+            m_states[upload.id] = State::FAILED;
+        }
+        m_uploads.pop_front();
+    }
+}
+
+TextureStreamer::State TextureStreamer::getState(int requestID) {
+    auto it = m_states.find(requestID);
+    return it == m_states.end() ? State::UNKNOWN : it->second;
+}
+
+Texture* TextureStreamer::takeTexture(int requestID) {
+    auto it = m_ready.find(requestID);
+    if (it == m_ready.end())
+        return nullptr;
+    Texture* texture = new Texture(it->second);
+    m_ready.erase(it);
+    m_states.erase(requestID);
+    return texture;
+}
+
+void TextureStreamer::run() {
+    glfwMakeContextCurrent(m_context);
+
+    while (true) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+            if (m_stop)
+                break;
+            request = m_requests.front();
+            m_requests.pop_front();
+        }
+
+        GLuint textureID = TextureLoader::load(request.filename);
+        GLsync fence = nullptr;
+        if (textureID) {
+            glBindTexture(GL_TEXTURE_2D, 0);
+            fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            // Make sure the commands reach the GPU so the render thread sees the fence signal
+            glFlush();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_uploads.push_back({ request.id, textureID, fence });
+    }
+
+    glfwMakeContextCurrent(NULL);
+}
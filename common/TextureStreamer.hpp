@@ -0,0 +1,88 @@
+/*
+ * TextureStreamer.hpp
+ *
+ *  Background texture loading. A worker thread owns a hidden GLFW window whose
+ *  context shares objects with the render context, loads files through
+ *  TextureLoader and hands finished textures back guarded by a GL fence.
+ *
+ */
+#ifndef TEXTURESTREAMER_HPP
+#define TEXTURESTREAMER_HPP
+
+#include <string>
+#include <map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+
+#include "Texture.hpp"
+
+//!  TextureStreamer.
+/*!
+ Loads textures on a worker thread with a shared GL context so file I/O and uploads never block frames.
+ Must be created, updated and destroyed on the render thread.
+ */
+class TextureStreamer {
+public:
+    //! Request state as seen by the render thread
+    enum class State { PENDING, READY, FAILED, UNKNOWN };
+
+    //! Constructor
+    /*! Creates the hidden shared context and starts the worker. Call after the render context is current. */
+    TextureStreamer(GLFWwindow* renderWindow);
+    //! Destructor
+    /*! Stops the worker and releases textures that were never taken. */
+    ~TextureStreamer();
+
+    //! isRunning
+    /*! False if the shared context could not be created. */
+    bool isRunning() const { return m_context != nullptr; }
+
+    //! requestTexture
+    /*! Queues a .bmp/.dds file for loading. Returns a request id. */
+    int requestTexture(const std::string& filename);
+
+    //! update
+    /*! Checks the fences of finished uploads without blocking. Call once per frame. */
+    void update();
+
+    //! getState
+    /*! State of a request after the last update(). */
+    State getState(int requestID);
+
+    //! takeTexture
+    /*! Returns the finished texture (caller owns it) or nullptr if it is not ready yet. */
+    Texture* takeTexture(int requestID);
+
+private:
+    struct Request {
+        int id;
+        std::string filename;
+    };
+    struct Upload {
+        int id;
+        GLuint textureID;   //!< 0 if loading failed
+        GLsync fence;       //!< signalled once the upload has completed on the GPU
+    };
+
+    //! Worker thread main loop
+    void run();
+
+    GLFWwindow* m_context;              //!< hidden window owning the shared context
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stop;
+
+    std::deque<Request> m_requests;     //!< waiting for the worker
+    std::deque<Upload> m_uploads;       //!< uploaded by the worker, fence not yet checked
+    std::map<int, State> m_states;      //!< render thread view of every request
+    std::map<int, GLuint> m_ready;      //!< fenced textures ready to be taken
+    int m_nextID;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "TileChangeDetector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Each tile is summarised by TILE_CELLS x TILE_CELLS cell means
+static const int TILE_CELLS = 4;
+
+TileChangeDetector::TileChangeDetector(int tileSize, float tolerance)
+    : m_tileSize(std::max(1, tileSize)), m_tolerance(tolerance), m_valid(false),
+      m_frameType(-1), m_tilesX(0), m_tilesY(0), m_dirtyTiles(0) {
+}
+
+void TileChangeDetector::setTileSize(int tileSize) {
+    tileSize = std::max(1, tileSize);
+    if (tileSize == m_tileSize)
+        return;
+    m_tileSize = tileSize;
+    m_valid = false;
+}
+
+float TileChangeDetector::getDirtyFraction() const {
+    int tiles = m_tilesX * m_tilesY;
+    return tiles > 0 ? (float)m_dirtyTiles / tiles : 0.0f;
+}
+
+void TileChangeDetector::computeSignatures(const cv::Mat& frame, std::vector<float>& signatures) const {
+    const int channels = frame.channels();
+    const int cellsPerTile = TILE_CELLS * TILE_CELLS;
+    // Every other row is enough to see motion, small tiles use all rows so no cell is left empty
+    const int rowStep = m_tileSize >= 16 ? 2 : 1;
+    signatures.resize((size_t)m_tilesX * m_tilesY * cellsPerTile);
+
+    // Byte offset where each cell column starts, edge tiles are narrower
+    std::vector<int> cellStart(m_tilesX * TILE_CELLS + 1);
+    for (int tx = 0; tx < m_tilesX; tx++) {
+        int x0 = tx * m_tileSize;
+        int w = std::min(m_tileSize, frame.cols - x0);
+        for (int cx = 0; cx < TILE_CELLS; cx++)
+            cellStart[tx * TILE_CELLS + cx] = (x0 + w * cx / TILE_CELLS) * channels;
+    }
+    cellStart[m_tilesX * TILE_CELLS] = frame.cols * channels;
+
+    cv::parallel_for_(cv::Range(0, m_tilesY), [&](const cv::Range& range) {
+        std::vector<unsigned int> sums(m_tilesX * cellsPerTile);
+        std::vector<unsigned int> counts(m_tilesX * cellsPerTile);
+        for (int ty = range.start; ty < range.end; ty++) {
+            int y0 = ty * m_tileSize;
+            int h = std::min(m_tileSize, frame.rows - y0);
+            std::fill(sums.begin(), sums.end(), 0u);
+            std::fill(counts.begin(), counts.end(), 0u);
+
+            for (int k = 0; k < h; k += rowStep) {
+                const uchar* row = frame.ptr<uchar>(y0 + k);
+                int cy = k * TILE_CELLS / h;
+                for (int cell = 0; cell < m_tilesX * TILE_CELLS; cell++) {
+                    int begin = cellStart[cell];
+                    int end = cellStart[cell + 1];
+                    unsigned int sum = 0;
+                    for (int i = begin; i < end; i++)
+                        sum += row[i];
+                    int index = (cell / TILE_CELLS) * cellsPerTile + cy * TILE_CELLS + cell % TILE_CELLS;
+                    sums[index] += sum;
+                    counts[index] += end - begin;
+                }
+            }
+
+            float* out = &signatures[(size_t)ty * m_tilesX * cellsPerTile];
+            for (int i = 0; i < m_tilesX * cellsPerTile; i++)
+                out[i] = counts[i] > 0 ? (float)sums[i] / counts[i] : 0.0f;
+        }
+    });
+}
+
+const std::vector<cv::Rect>& TileChangeDetector::detect(const cv::Mat& frame) {
+    m_dirty.clear();
+    if (frame.empty() || frame.depth() != CV_8U) {
+        m_valid = false;
+        m_tilesX = m_tilesY = m_dirtyTiles = 0;
+        if (!frame.empty())
+            m_dirty.push_back(cv::Rect(0, 0, frame.cols, frame.rows));
+        return m_dirty;
+    }
+
+    int tilesX = (frame.cols + m_tileSize - 1) / m_tileSize;
+    int tilesY = (frame.rows + m_tileSize - 1) / m_tileSize;
+    if (frame.size() != m_frameSize || frame.type() != m_frameType || tilesX != m_tilesX || tilesY != m_tilesY)
+        m_valid = false;
+    m_frameSize = frame.size();
+    m_frameType = frame.type();
+    m_tilesX = tilesX;
+    m_tilesY = tilesY;
+
+    computeSignatures(frame, m_current);
+
+    if (!m_valid) {
+        // Nothing to compare against, everything is new
+        m_signatures.swap(m_current);
+        m_valid = true;
+        m_dirtyTiles = m_tilesX * m_tilesY;
+        m_dirty.push_back(cv::Rect(0, 0, frame.cols, frame.rows));
+        return m_dirty;
+    }
+
+    const int cellsPerTile = TILE_CELLS * TILE_CELLS;
+    m_dirtyTiles = 0;
+    for (int ty = 0; ty < m_tilesY; ty++) {
+        int runStart = -1;
+        for (int tx = 0; tx <= m_tilesX; tx++) {
+            bool changed = false;
+            if (tx < m_tilesX) {
+                size_t base = ((size_t)ty * m_tilesX + tx) * cellsPerTile;
+                for (int i = 0; i < cellsPerTile && !changed; i++)
+                    changed = std::fabs(m_current[base + i] - m_signatures[base + i]) > m_tolerance;
+                if (changed) {
+                    // Only changed tiles take the new signature, slow drift still adds up past the tolerance
+                    std::copy(m_current.begin() + base, m_current.begin() + base + cellsPerTile,
+                              m_signatures.begin() + base);
+                    m_dirtyTiles++;
+                }
+            }
+            if (changed && runStart < 0) {
+                runStart = tx;
+            } else if (!changed && runStart >= 0) {
+                cv::Rect run(runStart * m_tileSize, ty * m_tileSize, (tx - runStart) * m_tileSize, m_tileSize);
+                m_dirty.push_back(run & cv::Rect(0, 0, frame.cols, frame.rows));
+                runStart = -1;
+            }
+        }
+    }
+    return m_dirty;
+}
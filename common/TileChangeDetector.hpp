@@ -0,0 +1,68 @@
+#ifndef TILECHANGEDETECTOR_HPP
+#define TILECHANGEDETECTOR_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * TileChangeDetector - Finds the parts of a frame that changed since the previous one.
+ *
+ * The frame is split into square tiles. Each tile is summarised by a small grid of cell
+ * means taken from every other row, and a tile counts as changed when any cell mean moved
+ * by more than the tolerance. Averaging keeps sensor noise below the tolerance while real
+ * motion still shows up. Changed tiles are merged into horizontal runs so callers get a
+ * few rectangles to filter and upload instead of one per tile.
+ */
+class TileChangeDetector {
+public:
+    /**
+     * Create a detector
+     * @param tileSize Tile edge in pixels; use a multiple of the pixelation block size so tiles line up with blocks
+     * @param tolerance Largest change of a cell mean (0-255) still treated as noise
+     */
+    TileChangeDetector(int tileSize = 32, float tolerance = 2.0f);
+
+    /**
+     * Change the tile size; the next detect() reports the whole frame
+     */
+    void setTileSize(int tileSize);
+    int getTileSize() const { return m_tileSize; }
+
+    void setTolerance(float tolerance) { m_tolerance = tolerance; }
+    float getTolerance() const { return m_tolerance; }
+
+    /**
+     * Forget the previous frame, e.g. after filter parameters changed
+     */
+    void invalidate() { m_valid = false; }
+
+    /**
+     * Compare a frame against the previous one and remember it for the next call
+     * @param frame 8-bit frame with 1 to 4 channels
+     * @return Changed regions, merged per tile row; the whole frame if nothing can be compared
+     */
+    const std::vector<cv::Rect>& detect(const cv::Mat& frame);
+
+    /**
+     * Fraction of tiles reported changed by the last detect()
+     */
+    float getDirtyFraction() const;
+
+private:
+    void computeSignatures(const cv::Mat& frame, std::vector<float>& signatures) const;
+
+    int m_tileSize;
+    float m_tolerance;
+    bool m_valid;
+    cv::Size m_frameSize;
+    int m_frameType;
+    int m_tilesX;
+    int m_tilesY;
+    int m_dirtyTiles;
+
+    std::vector<float> m_signatures;    //!< cell means of the previous frame
+    std::vector<float> m_current;
+    std::vector<cv::Rect> m_dirty;
+};
+
+#endif // TILECHANGEDETECTOR_HPP
@@ -1,4 +1,5 @@
 #include "Transformation.hpp"
+#include "FrameFormat.hpp"
 #include <cmath>
 
 void Transformation::applyTranslation(const cv::Mat& input, cv::Mat& output, 
@@ -73,11 +74,114 @@ void Transformation::applyCombinedTransform(const cv::Mat& input, cv::Mat& outpu
     cv::Mat transformMat = buildTransformMatrix(tx, ty, angleDegrees, scale, 
                                                 centerX, centerY);
     
+    // BGRA frames keep their aligned rows, warpAffine writes into the existing buffer
+    if (input.channels() == 4)
+        FrameFormat::allocateAligned(input.size(), input.type(), output);
+    
     // Apply affine transformation with linear interpolation
     cv::warpAffine(input, output, transformMat, input.size(), 
                    cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
 }
 
+void Transformation::applyCombinedTransform(const cv::Mat& input, cv::Mat& output,
+                                            const std::vector<cv::Rect>& regions,
+                                            std::vector<cv::Rect>& outputRegions,
+                                            float tx, float ty,
+                                            float angleDegrees, float scale) {
+    outputRegions.clear();
+    if (input.empty()) {
+        return;
+    }
+    output.create(input.size(), input.type());
+
+    cv::Mat transformMat = buildTransformMatrix(tx, ty, angleDegrees, scale,
+                                                input.cols / 2.0f, input.rows / 2.0f);
+    const cv::Rect bounds(0, 0, input.cols, input.rows);
+
+    for (const cv::Rect& region : regions) {
+        // Output pixels sample their bilinear neighbours, so the ring of source pixels around the
+        // region also changes them; map that grown rect and pad one output pixel for rounding
+        const cv::Rect grown(region.x - 1, region.y - 1, region.width + 2, region.height + 2);
+        std::vector<cv::Point2f> corners = {
+            cv::Point2f((float)grown.x, (float)grown.y),
+            cv::Point2f((float)grown.br().x, (float)grown.y),
+            cv::Point2f((float)grown.x, (float)grown.br().y),
+            cv::Point2f((float)grown.br().x, (float)grown.br().y)
+        };
+        cv::transform(corners, corners, transformMat);
+        cv::Rect target = cv::boundingRect(corners);
+        target = cv::Rect(target.x - 1, target.y - 1, target.width + 2, target.height + 2) & bounds;
+        if (target.empty())
+            continue;
+
+        // Same mapping, shifted so the target's top left corner is the origin of the ROI
+        cv::Mat shifted = transformMat.clone();
+        shifted.at<float>(0, 2) -= target.x;
+        shifted.at<float>(1, 2) -= target.y;
+        cv::Mat targetView = output(target);
+        cv::warpAffine(input, targetView, shifted, target.size(),
+                       cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+        outputRegions.push_back(target);
+    }
+}
+
+void Transformation::applyCombinedTransform(const cv::Mat& input, cv::Mat& output,
+                                            const cv::Rect& inputRect, cv::Size frameSize,
+                                            float tx, float ty,
+                                            float angleDegrees, float scale) {
+    if (input.empty()) {
+        output = cv::Mat::zeros(frameSize, input.type());
+        return;
+    }
+
+    cv::Mat transformMat = buildTransformMatrix(tx, ty, angleDegrees, scale,
+                                                frameSize.width / 2.0f, frameSize.height / 2.0f);
+
+    // Input pixel (0, 0) is frame pixel inputRect.tl(), fold that offset into the translation
+    transformMat.at<float>(0, 2) += transformMat.at<float>(0, 0) * inputRect.x + transformMat.at<float>(0, 1) * inputRect.y;
+    transformMat.at<float>(1, 2) += transformMat.at<float>(1, 0) * inputRect.x + transformMat.at<float>(1, 1) * inputRect.y;
+
+    cv::warpAffine(input, output, transformMat, frameSize,
+                   cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+}
+
+cv::Rect Transformation::visibleSourceRect(cv::Size frameSize, float tx, float ty,
+                                           float angleDegrees, float scale, int blockSize) {
+    const cv::Rect bounds(0, 0, frameSize.width, frameSize.height);
+    if (scale == 0.0f || frameSize.width <= 0 || frameSize.height <= 0)
+        return bounds;
+
+    cv::Mat transformMat = buildTransformMatrix(tx, ty, angleDegrees, scale,
+                                                frameSize.width / 2.0f, frameSize.height / 2.0f);
+    cv::Mat inverseMat;
+    cv::invertAffineTransform(transformMat, inverseMat);
+
+    // Output corners mapped back into the source
+    std::vector<cv::Point2f> corners = {
+        cv::Point2f(0.0f, 0.0f),
+        cv::Point2f((float)frameSize.width, 0.0f),
+        cv::Point2f(0.0f, (float)frameSize.height),
+        cv::Point2f((float)frameSize.width, (float)frameSize.height)
+    };
+    cv::transform(corners, corners, inverseMat);
+    cv::Rect visible = cv::boundingRect(corners);
+
+    // One extra pixel on each side for the bilinear neighbours
+    visible = cv::Rect(visible.x - 1, visible.y - 1, visible.width + 2, visible.height + 2) & bounds;
+    if (visible.empty())
+        return visible;
+
+    // Snap outwards to the block grid so blocks are cut exactly as in a full frame pass
+    if (blockSize > 1) {
+        int x0 = (visible.x / blockSize) * blockSize;
+        int y0 = (visible.y / blockSize) * blockSize;
+        int x1 = ((visible.br().x + blockSize - 1) / blockSize) * blockSize;
+        int y1 = ((visible.br().y + blockSize - 1) / blockSize) * blockSize;
+        visible = cv::Rect(x0, y0, x1 - x0, y1 - y0) & bounds;
+    }
+    return visible;
+}
+
 cv::Mat Transformation::buildTransformMatrix(float tx, float ty, 
                                              float angleDegrees, float scale,
                                              float centerX, float centerY) {
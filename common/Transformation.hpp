@@ -3,6 +3,7 @@
 
 #include <opencv2/opencv.hpp>
 #include <glm/glm.hpp>
+#include <vector>
 
 /**
  * Transformation class - Handles CPU-based geometric transformations
@@ -51,6 +52,52 @@ public:
                                        float tx, float ty, 
                                        float angleDegrees, float scale);
     
+    /**
+     * Apply the combined transformation only where changed input regions land in the output
+     * @param input Input image, complete (unchanged parts are still sampled)
+     * @param output Output image from the previous call, allocated to the input size if it is not already
+     * @param regions Changed regions of the input
+     * @param outputRegions Receives the output regions that were rewritten
+     * @param tx Translation in x direction
+     * @param ty Translation in y direction
+     * @param angleDegrees Rotation angle in degrees
+     * @param scale Scale factor
+     */
+    static void applyCombinedTransform(const cv::Mat& input, cv::Mat& output,
+                                       const std::vector<cv::Rect>& regions,
+                                       std::vector<cv::Rect>& outputRegions,
+                                       float tx, float ty,
+                                       float angleDegrees, float scale);
+
+    /**
+     * Apply the combined transformation to a cropped part of the frame
+     * @param input Pixels of inputRect only, e.g. a filtered ROI
+     * @param output Output transformed image of frameSize, areas mapped from outside inputRect are black
+     * @param inputRect Where input sits in the full frame
+     * @param frameSize Size of the full frame, defines the center and the output size
+     * @param tx Translation in x direction
+     * @param ty Translation in y direction
+     * @param angleDegrees Rotation angle in degrees
+     * @param scale Scale factor
+     */
+    static void applyCombinedTransform(const cv::Mat& input, cv::Mat& output,
+                                       const cv::Rect& inputRect, cv::Size frameSize,
+                                       float tx, float ty,
+                                       float angleDegrees, float scale);
+
+    /**
+     * Find the part of the frame that the combined transformation maps into the output
+     * @param frameSize Size of input and output frame
+     * @param tx Translation in x direction
+     * @param ty Translation in y direction
+     * @param angleDegrees Rotation angle in degrees
+     * @param scale Scale factor
+     * @param blockSize Grid the rectangle is snapped outwards to (e.g. the pixelation block size), 1 for none
+     * @return Source rectangle covering every pixel the warp samples, clipped to the frame
+     */
+    static cv::Rect visibleSourceRect(cv::Size frameSize, float tx, float ty,
+                                      float angleDegrees, float scale, int blockSize = 1);
+
     /**
      * Build a combined affine transformation matrix
      * @param tx Translation in x
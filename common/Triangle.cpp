@@ -25,7 +25,7 @@ void Triangle::render(Camera* camera){
     bindShaders();
     // Build the model matrix -get from object
     glm::mat4 ModelMatrix = this->getTransform();
-    glm::mat4 MVP = camera->getViewProjectionMatrix() * ModelMatrix;
+    glm::mat4 MVP = getMVP(camera);
     glm::mat4 V = camera->getViewMatrix();
     glm::mat4 P = camera->getProjectionMatrix();
     // Send our transformation to the currently bound shader,
@@ -51,4 +51,20 @@ void Triangle::render(Camera* camera){
     glDisableVertexAttribArray(0);
 }
 
-    
+GLuint Triangle::getGeometryID(){
+    return vertexbuffer;
+}
+
+void Triangle::bindGeometry(){
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+}
+
+void Triangle::drawGeometry(GLsizei instanceCount){
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 3, instanceCount);
+}
+
+void Triangle::unbindGeometry(){
+    glDisableVertexAttribArray(0);
+}
@@ -28,6 +28,18 @@ class Triangle:  public Object{
         //! render
         /*! Render default quad. */
         void render(Camera* camera);
+        //! getGeometryID
+        /*! Vertex buffer of the triangle, shared key for instanced batching. */
+        GLuint getGeometryID();
+        //! bindGeometry
+        /*! Bind the position attribute (location 0). */
+        void bindGeometry();
+        //! drawGeometry
+        /*! Draw instanceCount copies of the triangle. */
+        void drawGeometry(GLsizei instanceCount);
+        //! unbindGeometry
+        /*! Disable the position attribute. */
+        void unbindGeometry();
 
     private:
     
@@ -0,0 +1,23 @@
+#include "UndistortShader.hpp"
+#include <stdio.h>
+
+UndistortShader::UndistortShader(std::string vertexShaderName, std::string fragmentShaderName)
+    : TextureShader(vertexShaderName, fragmentShaderName), mapTextureID(0) {
+    mapSamplerLocation = glGetUniformLocation(programID, "distortionMap");
+
+    if (mapSamplerLocation == -1) {
+        printf("Warning: Could not find 'distortionMap' uniform in undistort shader\n");
+    }
+}
+
+void UndistortShader::setMapTexture(GLuint textureID) {
+    mapTextureID = textureID;
+}
+
+void UndistortShader::bind() {
+    TextureShader::bind();
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, mapTextureID);
+    glActiveTexture(GL_TEXTURE0);
+    glUniform1i(mapSamplerLocation, 1);
+}
@@ -0,0 +1,27 @@
+#ifndef UNDISTORT_SHADER_HPP
+#define UNDISTORT_SHADER_HPP
+
+#include "TextureShader.hpp"
+#include <string>
+
+//!  UndistortShader.
+/*!
+ Lens correction as one gather (undistort.frag): the video texture is sampled at the pixel's UV
+ plus the displacement read from a GL_RG16F map texture on unit 1.
+ */
+class UndistortShader : public TextureShader {
+private:
+    GLint mapSamplerLocation;
+    GLuint mapTextureID;
+
+public:
+    UndistortShader(std::string vertexShaderName, std::string fragmentShaderName);
+
+    //! setMapTexture
+    /*! Displacement texture, not owned. */
+    void setMapTexture(GLuint textureID);
+
+    void bind() override;
+};
+
+#endif // UNDISTORT_SHADER_HPP
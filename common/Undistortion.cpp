@@ -0,0 +1,170 @@
+#include <stdio.h>
+
+#include "Undistortion.hpp"
+#include "FrameFormat.hpp"
+
+cv::Point2d Undistortion::Model::distort(double x, double y) const {
+    // OpenCV's rational + thin prism model on normalized camera coordinates
+    double xn = (x - cx) / fx;
+    double yn = (y - cy) / fy;
+    double r2 = xn * xn + yn * yn;
+    double r4 = r2 * r2;
+    double r6 = r4 * r2;
+    double radial = (1.0 + k[0] * r2 + k[1] * r4 + k[4] * r6) / (1.0 + k[5] * r2 + k[6] * r4 + k[7] * r6);
+    double xd = xn * radial + 2.0 * k[2] * xn * yn + k[3] * (r2 + 2.0 * xn * xn) + k[8] * r2 + k[9] * r4;
+    double yd = yn * radial + k[2] * (r2 + 2.0 * yn * yn) + 2.0 * k[3] * xn * yn + k[10] * r2 + k[11] * r4;
+    return cv::Point2d(fx * xd + cx, fy * yd + cy);
+}
+
+Undistortion::Undistortion()
+    : m_calibrated(false), m_flipped(false), m_revision(0), m_rebuildCount(0), m_mapRevision(-1), m_offsetRevision(-1) {
+    for (int i = 0; i < 4; i++)
+        m_camera[i] = 0.0;
+    for (int i = 0; i < 12; i++)
+        m_coefficients[i] = 0.0;
+}
+
+bool Undistortion::load(const std::string& filename) {
+    cv::FileStorage storage;
+    try {
+        storage.open(filename, cv::FileStorage::READ);
+    } catch (const cv::Exception& e) {
+        fprintf(stderr, "Undistortion: cannot parse %s: %s\n", filename.c_str(), e.what());
+        return false;
+    }
+    if (!storage.isOpened()) {
+        fprintf(stderr, "Undistortion: cannot open %s\n", filename.c_str());
+        return false;
+    }
+    cv::Mat cameraMatrix, distCoeffs;
+    int width = 0, height = 0;
+    storage["camera_matrix"] >> cameraMatrix;
+    storage["distortion_coefficients"] >> distCoeffs;
+    storage["image_width"] >> width;
+    storage["image_height"] >> height;
+    if (cameraMatrix.empty() || distCoeffs.empty()) {
+        fprintf(stderr, "Undistortion: %s has no camera_matrix / distortion_coefficients\n", filename.c_str());
+        return false;
+    }
+    return setCalibration(cameraMatrix, distCoeffs, cv::Size(width, height));
+}
+
+bool Undistortion::setCalibration(const cv::Mat& cameraMatrix, const cv::Mat& distCoeffs, cv::Size calibrationSize) {
+    size_t count = distCoeffs.total();
+    if (cameraMatrix.rows != 3 || cameraMatrix.cols != 3 ||
+        (count != 4 && count != 5 && count != 8 && count != 12)) {
+        fprintf(stderr, "Undistortion: expected a 3x3 camera matrix and 4, 5, 8 or 12 coefficients\n");
+        return false;
+    }
+    cv::Mat camera, coefficients;
+    cameraMatrix.convertTo(camera, CV_64F);
+    distCoeffs.reshape(1, 1).convertTo(coefficients, CV_64F);
+    m_camera[0] = camera.at<double>(0, 0);
+    m_camera[1] = camera.at<double>(1, 1);
+    m_camera[2] = camera.at<double>(0, 2);
+    m_camera[3] = camera.at<double>(1, 2);
+    if (m_camera[0] <= 0.0 || m_camera[1] <= 0.0) {
+        fprintf(stderr, "Undistortion: focal lengths must be positive\n");
+        return false;
+    }
+    for (int i = 0; i < 12; i++)
+        m_coefficients[i] = i < (int)count ? coefficients.at<double>(0, i) : 0.0;
+    m_calibrationSize = calibrationSize;
+    m_calibrated = true;
+    m_revision++;
+    return true;
+}
+
+void Undistortion::setFlipped(bool flipped) {
+    if (flipped == m_flipped)
+        return;
+    m_flipped = flipped;
+    m_revision++;
+}
+
+Undistortion::Model Undistortion::model(cv::Size frameSize) const {
+    Model result;
+    double scaleX = 1.0, scaleY = 1.0;
+    if (m_calibrationSize.width > 0 && m_calibrationSize.height > 0) {
+        scaleX = (double)frameSize.width / m_calibrationSize.width;
+        scaleY = (double)frameSize.height / m_calibrationSize.height;
+    }
+    // Scaled about pixel corners, OpenCV puts pixel centres at integer coordinates
+    result.fx = m_camera[0] * scaleX;
+    result.fy = m_camera[1] * scaleY;
+    result.cx = (m_camera[2] + 0.5) * scaleX - 0.5;
+    result.cy = (m_camera[3] + 0.5) * scaleY - 0.5;
+    for (int i = 0; i < 12; i++)
+        result.k[i] = m_coefficients[i];
+    if (m_flipped) {
+        // y -> -y in normalized coordinates: only the terms odd in y change sign
+        result.cy = frameSize.height - 1 - result.cy;
+        result.k[2] = -result.k[2];
+        result.k[10] = -result.k[10];
+        result.k[11] = -result.k[11];
+    }
+    return result;
+}
+
+void Undistortion::buildFloatMap(cv::Size frameSize, cv::Mat& map) const {
+    Model lens = model(frameSize);
+    double cameraValues[9] = { lens.fx, 0.0, lens.cx,
+                               0.0, lens.fy, lens.cy,
+                               0.0, 0.0, 1.0 };
+    cv::Mat camera(3, 3, CV_64F, cameraValues);
+    cv::Mat coefficients(1, 12, CV_64F, lens.k);
+    cv::Mat unused;
+    cv::initUndistortRectifyMap(camera, coefficients, cv::Mat(), camera, frameSize, CV_32FC2, map, unused);
+}
+
+void Undistortion::prepareMaps(cv::Size frameSize) {
+    if (m_mapRevision == m_revision && m_mapSize == frameSize)
+        return;
+    cv::Mat floatMap;
+    buildFloatMap(frameSize, floatMap);
+    // Fixed point: integer coordinates plus an index into OpenCV's bilinear weight table
+    cv::convertMaps(floatMap, cv::Mat(), m_fixedXY, m_fixedTable, CV_16SC2);
+    m_mapSize = frameSize;
+    m_mapRevision = m_revision;
+    m_rebuildCount++;
+}
+
+void Undistortion::apply(const cv::Mat& input, cv::Mat& output) {
+    apply(input, output, cv::Rect(0, 0, input.cols, input.rows));
+}
+
+void Undistortion::apply(const cv::Mat& input, cv::Mat& output, const cv::Rect& region) {
+    if (input.empty() || !m_calibrated) {
+        output = input(region).clone();
+        return;
+    }
+    prepareMaps(input.size());
+    // BGRA frames keep their aligned rows, remap writes into the existing buffer
+    if (input.channels() == 4)
+        FrameFormat::allocateAligned(region.size(), input.type(), output);
+    // The map rows of the region still address the whole input, remap splits the rows over threads
+    cv::remap(input, output, m_fixedXY(region), m_fixedTable(region), cv::INTER_LINEAR,
+              cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+}
+
+const cv::Mat& Undistortion::getOffsetMap(cv::Size frameSize) {
+    if (m_offsetRevision == m_revision && m_offsetSize == frameSize)
+        return m_offsets;
+    cv::Mat floatMap;
+    buildFloatMap(frameSize, floatMap);
+    m_offsets.create(frameSize, CV_32FC2);
+    const float invWidth = 1.0f / frameSize.width;
+    const float invHeight = 1.0f / frameSize.height;
+    cv::parallel_for_(cv::Range(0, frameSize.height), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; y++) {
+            const cv::Vec2f* source = floatMap.ptr<cv::Vec2f>(y);
+            cv::Vec2f* offset = m_offsets.ptr<cv::Vec2f>(y);
+            for (int x = 0; x < frameSize.width; x++)
+                offset[x] = cv::Vec2f((source[x][0] - x) * invWidth, (source[x][1] - y) * invHeight);
+        }
+    });
+    m_offsetSize = frameSize;
+    m_offsetRevision = m_revision;
+    m_rebuildCount++;
+    return m_offsets;
+}
@@ -0,0 +1,120 @@
+#ifndef UNDISTORTION_HPP
+#define UNDISTORTION_HPP
+
+#include <opencv2/opencv.hpp>
+#include <string>
+
+/**
+ * Undistortion - Lens distortion correction from a camera calibration.
+ *
+ * Remap tables are built with cv::initUndistortRectifyMap when the calibration or the frame
+ * size changes and kept in OpenCV's fixed-point format, so a frame costs one cv::remap gather.
+ * The calibration is scaled to the frame size, e.g. a 1080p calibration used at 720p.
+ * The corrected image keeps the camera matrix, so its centre and scale match the input.
+ */
+class Undistortion {
+public:
+    /**
+     * Calibration at one frame size, in the (possibly flipped) frame coordinates
+     */
+    struct Model {
+        double fx, fy, cx, cy;
+        double k[12];   //!< k1 k2 p1 p2 k3 k4 k5 k6 s1 s2 s3 s4, missing ones are 0
+
+        /**
+         * Where an undistorted pixel position lies in the distorted frame
+         * @param x Column in the corrected image
+         * @param y Row in the corrected image
+         * @return Position in the input frame
+         */
+        cv::Point2d distort(double x, double y) const;
+    };
+
+    Undistortion();
+
+    /**
+     * Load a calibration in the layout written by OpenCV's calibration sample
+     * (camera_matrix, distortion_coefficients and optionally image_width / image_height)
+     * @param filename YAML, XML or JSON file
+     * @return False if the file could not be read or the calibration is invalid
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * Set the calibration, maps are rebuilt on the next use
+     * @param cameraMatrix 3x3 intrinsics (skew is ignored)
+     * @param distCoeffs 4, 5, 8 or 12 coefficients (the tilted model is not supported)
+     * @param calibrationSize Image size the calibration was made at, empty to use it at any size unscaled
+     * @return False if the matrices have the wrong layout
+     */
+    bool setCalibration(const cv::Mat& cameraMatrix, const cv::Mat& distCoeffs, cv::Size calibrationSize);
+
+    /**
+     * Frames are processed bottom row first (flipped for OpenGL), the calibration is mirrored to match
+     * @param flipped True if frame row 0 is the bottom of the camera image
+     */
+    void setFlipped(bool flipped);
+
+    bool isCalibrated() const { return m_calibrated; }
+
+    /**
+     * Calibration scaled to a frame size and mirrored if flipped
+     * @param frameSize Size of the distorted input frames
+     */
+    Model model(cv::Size frameSize) const;
+
+    /**
+     * Correct a frame, pixels mapped from outside the input are black
+     * @param input Distorted frame (BGR or BGRA)
+     * @param output Corrected frame of the same size
+     */
+    void apply(const cv::Mat& input, cv::Mat& output);
+
+    /**
+     * Correct only a region of the frame, e.g. the part a later warp shows
+     * @param input Full distorted frame
+     * @param output Corrected pixels of region, region.size()
+     * @param region Rectangle of the corrected frame to produce
+     */
+    void apply(const cv::Mat& input, cv::Mat& output, const cv::Rect& region);
+
+    /**
+     * Per pixel displacement for the GPU path: source UV minus pixel UV, CV_32FC2
+     * @param frameSize Size of the frames
+     * @return Offsets in texture coordinates, rebuilt only if calibration or size changed
+     */
+    const cv::Mat& getOffsetMap(cv::Size frameSize);
+
+    /**
+     * Incremented whenever the calibration or the flip changes, lets users of model() cache
+     */
+    int getRevision() const { return m_revision; }
+
+    /**
+     * Number of times the remap tables were rebuilt, for statistics
+     */
+    int getRebuildCount() const { return m_rebuildCount; }
+
+private:
+    void buildFloatMap(cv::Size frameSize, cv::Mat& map) const;
+    void prepareMaps(cv::Size frameSize);
+
+    bool m_calibrated;
+    bool m_flipped;
+    int m_revision;
+    int m_rebuildCount;
+    double m_camera[4];         //!< fx, fy, cx, cy at m_calibrationSize
+    double m_coefficients[12];
+    cv::Size m_calibrationSize;
+
+    cv::Mat m_fixedXY;          //!< CV_16SC2 integer source coordinates
+    cv::Mat m_fixedTable;       //!< CV_16UC1 interpolation table indices
+    cv::Size m_mapSize;
+    int m_mapRevision;          //!< -1 if no maps were built yet
+
+    cv::Mat m_offsets;          //!< GPU displacement map
+    cv::Size m_offsetSize;
+    int m_offsetRevision;
+};
+
+#endif // UNDISTORTION_HPP
@@ -0,0 +1,205 @@
+#include "V4L2FrameSource.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <linux/videodev2.h>
+
+V4L2FrameSource::V4L2FrameSource(const std::string& device, int width, int height, double fps,
+                                 int bufferCount, unsigned int pixelFormat)
+    : m_fd(-1), m_streaming(false), m_heldIndex(-1), m_width(0), m_height(0),
+      m_bytesPerLine(0), m_pixelFormat(0), m_timestamp(-1.0) {
+    if (!open(device, width, height, fps, bufferCount, pixelFormat))
+        release();
+}
+
+V4L2FrameSource::~V4L2FrameSource() {
+    release();
+}
+
+int V4L2FrameSource::xioctl(unsigned long request, void* arg) {
+    int result;
+    do {
+        result = ioctl(m_fd, request, arg);
+    } while (result == -1 && errno == EINTR);
+    return result;
+}
+
+bool V4L2FrameSource::setFormat(unsigned int fourcc, int width, int height) {
+    struct v4l2_format fmt;
+    memset(&fmt, 0, sizeof(fmt));
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.fmt.pix.width = width;
+    fmt.fmt.pix.height = height;
+    fmt.fmt.pix.pixelformat = fourcc;
+    fmt.fmt.pix.field = V4L2_FIELD_NONE;
+    if (xioctl(VIDIOC_S_FMT, &fmt) == -1 || fmt.fmt.pix.pixelformat != fourcc)
+        return false;
+
+    m_width = fmt.fmt.pix.width;
+    m_height = fmt.fmt.pix.height;
+    m_bytesPerLine = fmt.fmt.pix.bytesperline;
+    m_pixelFormat = fmt.fmt.pix.pixelformat;
+    return true;
+}
+
+bool V4L2FrameSource::open(const std::string& device, int width, int height, double fps,
+                           int bufferCount, unsigned int pixelFormat) {
+    m_fd = ::open(device.c_str(), O_RDWR | O_NONBLOCK);
+    if (m_fd < 0) {
+        fprintf(stderr, "V4L2: cannot open %s: %s\n", device.c_str(), strerror(errno));
+        return false;
+    }
+
+    struct v4l2_capability cap;
+    memset(&cap, 0, sizeof(cap));
+    if (xioctl(VIDIOC_QUERYCAP, &cap) == -1 ||
+        !(cap.device_caps & V4L2_CAP_VIDEO_CAPTURE) || !(cap.device_caps & V4L2_CAP_STREAMING)) {
+        fprintf(stderr, "V4L2: %s is not a streaming capture device\n", device.c_str());
+        return false;
+    }
+
+    // Prefer formats the render loop can use without conversion
+    const unsigned int preferred[] = { V4L2_PIX_FMT_BGR24, V4L2_PIX_FMT_YUYV, V4L2_PIX_FMT_NV12, V4L2_PIX_FMT_MJPEG };
+    bool formatSet = pixelFormat != 0 && setFormat(pixelFormat, width, height);
+    for (size_t i = 0; !formatSet && i < sizeof(preferred) / sizeof(preferred[0]); i++)
+        formatSet = setFormat(preferred[i], width, height);
+    if (!formatSet) {
+        fprintf(stderr, "V4L2: %s offers none of BGR24, YUYV, NV12, MJPEG\n", device.c_str());
+        return false;
+    }
+
+    if (fps > 0.0) {
+        struct v4l2_streamparm parm;
+        memset(&parm, 0, sizeof(parm));
+        parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        parm.parm.capture.timeperframe.numerator = 1000;
+        parm.parm.capture.timeperframe.denominator = (unsigned int)(fps * 1000.0);
+        xioctl(VIDIOC_S_PARM, &parm); // best effort
+    }
+
+    struct v4l2_requestbuffers req;
+    memset(&req, 0, sizeof(req));
+    req.count = bufferCount;
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(VIDIOC_REQBUFS, &req) == -1 || req.count < 2) {
+        fprintf(stderr, "V4L2: not enough mmap buffers on %s\n", device.c_str());
+        return false;
+    }
+
+    for (unsigned int i = 0; i < req.count; i++) {
+        struct v4l2_buffer buf;
+        memset(&buf, 0, sizeof(buf));
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index = i;
+        if (xioctl(VIDIOC_QUERYBUF, &buf) == -1)
+            return false;
+
+        Buffer mapped;
+        mapped.length = buf.length;
+        mapped.start = mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, buf.m.offset);
+        if (mapped.start == MAP_FAILED) {
+            fprintf(stderr, "V4L2: mmap failed: %s\n", strerror(errno));
+            return false;
+        }
+        m_buffers.push_back(mapped);
+
+        if (xioctl(VIDIOC_QBUF, &buf) == -1)
+            return false;
+    }
+
+    enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(VIDIOC_STREAMON, &type) == -1) {
+        fprintf(stderr, "V4L2: STREAMON failed: %s\n", strerror(errno));
+        return false;
+    }
+    m_streaming = true;
+
+    printf("V4L2: %s streaming %dx%d %.4s with %zu buffers\n", device.c_str(), m_width, m_height,
+           (const char*)&m_pixelFormat, m_buffers.size());
+    return true;
+}
+
+bool V4L2FrameSource::read(cv::Mat& frame) {
+    if (!m_streaming)
+        return false;
+
+    // The caller is done with the previous frame once it asks for the next one
+    releaseFrame();
+
+    struct v4l2_buffer buf;
+    memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+
+    while (xioctl(VIDIOC_DQBUF, &buf) == -1) {
+        if (errno != EAGAIN) {
+            fprintf(stderr, "V4L2: DQBUF failed: %s\n", strerror(errno));
+            return false;
+        }
+        struct pollfd pfd = { m_fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 1000) <= 0)
+            return false; // timeout or error
+    }
+
+    m_heldIndex = buf.index;
+    // Kernel timestamps are CLOCK_MONOTONIC for V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC buffers
+    if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+        m_timestamp = buf.timestamp.tv_sec + buf.timestamp.tv_usec * 1e-6;
+    else
+        m_timestamp = -1.0;
+
+    unsigned char* data = static_cast<unsigned char*>(m_buffers[buf.index].start);
+    switch (m_pixelFormat) {
+        case V4L2_PIX_FMT_BGR24:
+            frame = cv::Mat(m_height, m_width, CV_8UC3, data, m_bytesPerLine);
+            break;
+        case V4L2_PIX_FMT_YUYV:
+            frame = cv::Mat(m_height, m_width, CV_8UC2, data, m_bytesPerLine);
+            break;
+        case V4L2_PIX_FMT_NV12:
+            frame = cv::Mat(m_height * 3 / 2, m_width, CV_8UC1, data, m_bytesPerLine);
+            break;
+        default: // MJPEG: compressed bitstream
+            frame = cv::Mat(1, (int)buf.bytesused, CV_8UC1, data);
+            break;
+    }
+    return true;
+}
+
+void V4L2FrameSource::releaseFrame() {
+    if (m_heldIndex < 0)
+        return;
+
+    struct v4l2_buffer buf;
+    memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = m_heldIndex;
+    if (xioctl(VIDIOC_QBUF, &buf) == -1)
+        fprintf(stderr, "V4L2: QBUF failed: %s\n", strerror(errno));
+    m_heldIndex = -1;
+}
+
+void V4L2FrameSource::release() {
+    if (m_streaming) {
+        enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        xioctl(VIDIOC_STREAMOFF, &type);
+        m_streaming = false;
+    }
+    m_heldIndex = -1;
+    for (size_t i = 0; i < m_buffers.size(); i++)
+        munmap(m_buffers[i].start, m_buffers[i].length);
+    m_buffers.clear();
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef V4L2FRAMESOURCE_HPP
+#define V4L2FRAMESOURCE_HPP
+
+#include "FrameSource.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * V4L2FrameSource - Native Linux capture using V4L2 mmap streaming.
+ *
+ * Several driver buffers are kept queued. read() dequeues one and wraps it in a
+ * non-owning cv::Mat header without copying; the buffer goes back to the driver
+ * on releaseFrame() (or the next read()). Frames carry the kernel capture timestamp.
+ *
+ * Frame layout depends on the negotiated pixel format:
+ *   BGR24 -> CV_8UC3 (height x width)
+ *   YUYV  -> CV_8UC2 (height x width)
+ *   NV12  -> CV_8UC1 (height * 3/2 x width)
+ *   MJPEG -> CV_8UC1 (1 x compressed size)
+ *
+ * Works with the vivid test driver (modprobe vivid) and v4l2loopback, no camera needed.
+ */
+class V4L2FrameSource : public FrameSource {
+public:
+    /**
+     * Open a device and start streaming
+     * @param device Device node, e.g. /dev/video0
+     * @param width Requested width (the driver may adjust it)
+     * @param height Requested height (the driver may adjust it)
+     * @param fps Requested frame rate, 0 keeps the driver default
+     * @param bufferCount Number of mmap buffers to queue
+     * @param pixelFormat Preferred V4L2 fourcc, 0 tries BGR24, YUYV, NV12 and MJPEG in that order
+     */
+    V4L2FrameSource(const std::string& device, int width, int height, double fps = 0.0,
+                    int bufferCount = 4, unsigned int pixelFormat = 0);
+    ~V4L2FrameSource();
+
+    bool isOpened() const override { return m_streaming; }
+    bool read(cv::Mat& frame) override;
+    void releaseFrame() override;
+    double getTimestamp() const override { return m_timestamp; }
+    int getWidth() const override { return m_width; }
+    int getHeight() const override { return m_height; }
+    void release() override;
+
+    /**
+     * Negotiated V4L2 pixel format (fourcc)
+     */
+    unsigned int getPixelFormat() const { return m_pixelFormat; }
+
+private:
+    struct Buffer {
+        void* start;
+        size_t length;
+    };
+
+    bool open(const std::string& device, int width, int height, double fps, int bufferCount,
+              unsigned int pixelFormat);
+    bool setFormat(unsigned int fourcc, int width, int height);
+    int xioctl(unsigned long request, void* arg);
+
+    int m_fd;
+    bool m_streaming;
+    std::vector<Buffer> m_buffers;
+    int m_heldIndex;            //!< buffer currently handed out by read(), -1 if none
+    int m_width;
+    int m_height;
+    int m_bytesPerLine;
+    unsigned int m_pixelFormat;
+    double m_timestamp;
+};
+
+#endif // V4L2FRAMESOURCE_HPP
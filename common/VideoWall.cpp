@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <math.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "VideoWall.hpp"
+#include "VideoWallShader.hpp"
+
+VideoWall::VideoWall(int tileWidth, int tileHeight, int tileCount) : m_tilesDirty(true) {
+    if (tileCount > VIDEOWALL_MAX_TILES) {
+        fprintf(stderr, "VideoWall: %d tiles requested, limited to %d\n", tileCount, VIDEOWALL_MAX_TILES);
+        tileCount = VIDEOWALL_MAX_TILES;
+    }
+    m_tileCount = tileCount;
+    m_textures = new TextureArray(tileWidth, tileHeight, tileCount);
+
+    // The uniform block always holds VIDEOWALL_MAX_TILES entries, unused ones stay zero
+    m_tiles.resize(VIDEOWALL_MAX_TILES);
+    for (TileParams& tile : m_tiles) {
+        tile.transform = glm::mat4(1.0f);
+        tile.params = glm::vec4(VideoWallShader::PASSTHROUGH, 10.0f, 0.0f, 0.0f);
+    }
+    glGenBuffers(1, &m_tileBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_tileBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(TileParams) * m_tiles.size(), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Unit quad, UVs are derived from the position in the vertex shader
+    const GLfloat vertices[18] = {
+        -1.0f, -1.0f, 0.0f,   1.0f, -1.0f, 0.0f,  -1.0f,  1.0f, 0.0f,
+        -1.0f,  1.0f, 0.0f,   1.0f, -1.0f, 0.0f,   1.0f,  1.0f, 0.0f
+    };
+    glGenBuffers(1, &m_vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    layoutGrid();
+}
+
+VideoWall::~VideoWall() {
+    glDeleteBuffers(1, &m_vertexBuffer);
+    glDeleteBuffers(1, &m_tileBuffer);
+    delete m_textures;
+}
+
+void VideoWall::layoutGrid() {
+    if (m_tileCount == 0)
+        return;
+    int cols = (int)ceil(sqrt((double)m_tileCount));
+    int rows = (m_tileCount + cols - 1) / cols;
+    float tileAspect = (float)m_textures->getWidth() / (float)m_textures->getHeight();
+
+    // The wall spans y in [-1, 1] like a single video quad, tiles keep the video aspect ratio
+    float halfHeight = 1.0f / rows;
+    float halfWidth = tileAspect * halfHeight;
+    float wallHalfWidth = cols * halfWidth;
+    const float gap = 0.98f; // leave a thin border between tiles
+
+    for (int i = 0; i < m_tileCount; i++) {
+        int col = i % cols;
+        int row = i / cols;
+        glm::vec3 center(-wallHalfWidth + halfWidth * (2 * col + 1), 1.0f - halfHeight * (2 * row + 1), 0.0f);
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), center);
+        transform = glm::scale(transform, glm::vec3(halfWidth * gap, halfHeight * gap, 1.0f));
+        setTileTransform(i, transform);
+    }
+}
+
+void VideoWall::setTileTransform(int tile, glm::mat4 transform) {
+    if (tile < 0 || tile >= m_tileCount)
+        return;
+    m_tiles[tile].transform = transform;
+    m_tilesDirty = true;
+}
+
+void VideoWall::setTileFilter(int tile, int filterMode, float pixelSize) {
+    if (tile < 0 || tile >= m_tileCount)
+        return;
+    glm::vec4 params((float)filterMode, pixelSize, 0.0f, 0.0f);
+    if (params == m_tiles[tile].params)
+        return;
+    m_tiles[tile].params = params;
+    m_tilesDirty = true;
+}
+
+void VideoWall::updateTile(int tile, const unsigned char* data) {
+    if (tile < 0 || tile >= m_tileCount)
+        return;
+    m_textures->updateLayer(tile, data);
+}
+
+void VideoWall::render(Camera* camera) {
+    bindShaders();
+    shader->updateMVP(getMVP(camera));
+    directRender();
+}
+
+void VideoWall::directRender() {
+    if (m_tilesDirty) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_tileBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(TileParams) * m_tiles.size(), m_tiles.data());
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        m_tilesDirty = false;
+    }
+    glBindBufferBase(GL_UNIFORM_BUFFER, VideoWallShader::TILE_BLOCK_BINDING, m_tileBuffer);
+    m_textures->bindTexture(0);
+
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
+
+    // One draw for the whole wall, gl_InstanceID selects tile parameters and texture layer
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, m_tileCount);
+    glDisableVertexAttribArray(0);
+}
@@ -0,0 +1,75 @@
+/*
+ * VideoWall.hpp
+ *
+ *  Grid of video tiles drawn with one instanced draw call. Each tile samples its own layer of a
+ *  TextureArray; tile transforms and filter settings live in a std140 uniform buffer.
+ *
+ */
+#ifndef VIDEOWALL_HPP
+#define VIDEOWALL_HPP
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Object.hpp"
+#include "TextureArray.hpp"
+
+//! Maximum number of tiles, must match the TileBlock array size in videoWall.vert/.frag
+#define VIDEOWALL_MAX_TILES 16
+
+//!  VideoWall.
+/*!
+ Draws tileCount unit quads instanced; instance i is placed by tile i's transform and shows layer i.
+ The object transform moves the whole wall.
+ */
+class VideoWall : public Object {
+public:
+    //! Constructor
+    /*! Allocates the texture array (one layer per tile), the quad and the tile uniform buffer. */
+    VideoWall(int tileWidth, int tileHeight, int tileCount);
+    //! Destructor
+    /*! Deletes the buffers and the texture array. */
+    ~VideoWall();
+
+    //! layoutGrid
+    /*! Arranges the tiles in a near-square grid with unit height, keeping the video aspect ratio. */
+    void layoutGrid();
+
+    //! setTileTransform
+    /*! Places a tile; the transform maps the unit quad [-1,1]^2 into wall space. */
+    void setTileTransform(int tile, glm::mat4 transform);
+
+    //! setTileFilter
+    /*! Selects the filter (VideoWallShader::FilterMode) and pixel size of one tile. */
+    void setTileFilter(int tile, int filterMode, float pixelSize);
+
+    //! updateTile
+    /*! Uploads a BGR frame of tile size into the tile's layer. */
+    void updateTile(int tile, const unsigned char* data);
+
+    int getTileCount() const { return m_tileCount; }
+
+    //! render
+    /*! Binds the wall's shader and draws all tiles. */
+    void render(Camera* camera);
+    //! directRender
+    /*! Draws all tiles with the currently bound shader. */
+    void directRender();
+
+private:
+    //! Per tile data, laid out to match the std140 TileBlock
+    struct TileParams {
+        glm::mat4 transform;
+        glm::vec4 params;   //!< x: filter mode, y: pixel size in texels
+    };
+
+    TextureArray* m_textures;
+    int m_tileCount;
+    std::vector<TileParams> m_tiles;
+    bool m_tilesDirty;      //!< uniform buffer needs re-uploading
+    GLuint m_tileBuffer;
+    GLuint m_vertexBuffer;
+};
+
+#endif
@@ -0,0 +1,19 @@
+#include "VideoWallShader.hpp"
+#include <stdio.h>
+
+VideoWallShader::VideoWallShader(std::string vertexShaderName, std::string fragmentShaderName)
+    : Shader(vertexShaderName, fragmentShaderName) {
+    samplerLocation = glGetUniformLocation(programID, "videoArraySampler");
+    tileBlockIndex = glGetUniformBlockIndex(programID, "TileBlock");
+
+    if (tileBlockIndex == GL_INVALID_INDEX) {
+        printf("Warning: Could not find 'TileBlock' uniform block in video wall shader\n");
+    } else {
+        glUniformBlockBinding(programID, tileBlockIndex, TILE_BLOCK_BINDING);
+    }
+}
+
+void VideoWallShader::bind() {
+    glUseProgram(programID);
+    glUniform1i(samplerLocation, 0);
+}
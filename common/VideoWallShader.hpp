@@ -0,0 +1,29 @@
+#ifndef VIDEO_WALL_SHADER_HPP
+#define VIDEO_WALL_SHADER_HPP
+
+#include "Shader.hpp"
+#include <string>
+
+//!  VideoWallShader.
+/*!
+ Shader for VideoWall: samples one layer of a texture array per instance and applies that tile's
+ filter. Per-tile parameters come from the TileBlock uniform buffer.
+ */
+class VideoWallShader : public Shader {
+private:
+    GLint samplerLocation;
+    GLuint tileBlockIndex;
+
+public:
+    //! Filter modes, values match the filter parameter read in videoWall.frag
+    enum FilterMode { PASSTHROUGH = 0, SINCITY = 1, PIXELATION = 2 };
+
+    //! Uniform buffer binding point of the TileBlock
+    static const GLuint TILE_BLOCK_BINDING = 0;
+
+    VideoWallShader(std::string vertexShaderName, std::string fragmentShaderName);
+
+    void bind() override;
+};
+
+#endif // VIDEO_WALL_SHADER_HPP
@@ -0,0 +1,123 @@
+#include <stdio.h>
+
+#include "WarpEngine.hpp"
+#include "FrameFormat.hpp"
+#include "Undistortion.hpp"
+
+WarpEngine::WarpEngine()
+    : m_hasTransform(false), m_dirty(true), m_rebuildCount(0), m_lens(nullptr), m_lensRevision(-1) {
+    for (int i = 0; i < 9; i++)
+        m_homography[i] = (i % 4 == 0) ? 1.0 : 0.0;
+}
+
+void WarpEngine::setAffine(const cv::Mat& transformMat, cv::Size outputSize, cv::Point inputOffset) {
+    if (transformMat.rows != 2 || transformMat.cols != 3) {
+        fprintf(stderr, "WarpEngine: affine transform must be 2x3\n");
+        return;
+    }
+    cv::Mat affine;
+    transformMat.convertTo(affine, CV_64F);
+    double homography[9] = {
+        affine.at<double>(0, 0), affine.at<double>(0, 1), affine.at<double>(0, 2),
+        affine.at<double>(1, 0), affine.at<double>(1, 1), affine.at<double>(1, 2),
+        0.0, 0.0, 1.0
+    };
+    setMatrix(homography, outputSize, inputOffset);
+}
+
+void WarpEngine::setPerspective(const cv::Mat& homography, cv::Size outputSize, cv::Point inputOffset) {
+    if (homography.rows != 3 || homography.cols != 3) {
+        fprintf(stderr, "WarpEngine: perspective transform must be 3x3\n");
+        return;
+    }
+    cv::Mat matrix;
+    homography.convertTo(matrix, CV_64F);
+    double values[9];
+    for (int i = 0; i < 9; i++)
+        values[i] = matrix.at<double>(i / 3, i % 3);
+    setMatrix(values, outputSize, inputOffset);
+}
+
+void WarpEngine::setLens(const Undistortion* lens, cv::Size frameSize) {
+    int revision = lens != nullptr ? lens->getRevision() : -1;
+    if (lens == m_lens && revision == m_lensRevision && (lens == nullptr || frameSize == m_lensFrameSize))
+        return;
+    m_lens = lens;
+    m_lensFrameSize = frameSize;
+    m_lensRevision = revision;
+    m_dirty = true;
+}
+
+void WarpEngine::setMatrix(const double* homography, cv::Size outputSize, cv::Point inputOffset) {
+    // Scroll events change the transform rarely, identical parameters keep the maps
+    bool changed = !m_hasTransform || outputSize != m_outputSize || inputOffset != m_inputOffset;
+    for (int i = 0; i < 9 && !changed; i++)
+        changed = homography[i] != m_homography[i];
+    if (!changed)
+        return;
+
+    for (int i = 0; i < 9; i++)
+        m_homography[i] = homography[i];
+    m_outputSize = outputSize;
+    m_inputOffset = inputOffset;
+    m_hasTransform = true;
+    m_dirty = true;
+}
+
+void WarpEngine::rebuildMaps() {
+    // Output pixel -> frame coordinate is the inverse transform
+    cv::Mat forward(3, 3, CV_64F, m_homography);
+    cv::Mat inverse = forward.inv();
+    double h[9];
+    for (int i = 0; i < 9; i++)
+        h[i] = inverse.at<double>(i / 3, i % 3);
+    const double offsetX = m_inputOffset.x;
+    const double offsetY = m_inputOffset.y;
+
+    // With a lens the transformed position is in the undistorted frame, distort it to read the input
+    const bool lens = m_lens != nullptr && m_lens->isCalibrated();
+    Undistortion::Model model;
+    if (lens)
+        model = m_lens->model(m_lensFrameSize);
+
+    m_mapX.create(m_outputSize, CV_32FC1);
+    m_mapY.create(m_outputSize, CV_32FC1);
+    cv::parallel_for_(cv::Range(0, m_outputSize.height), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; y++) {
+            float* mapX = m_mapX.ptr<float>(y);
+            float* mapY = m_mapY.ptr<float>(y);
+            for (int x = 0; x < m_outputSize.width; x++) {
+                double w = h[6] * x + h[7] * y + h[8];
+                w = w != 0.0 ? 1.0 / w : 0.0;
+                double frameX = (h[0] * x + h[1] * y + h[2]) * w;
+                double frameY = (h[3] * x + h[4] * y + h[5]) * w;
+                if (lens) {
+                    cv::Point2d distorted = model.distort(frameX, frameY);
+                    frameX = distorted.x;
+                    frameY = distorted.y;
+                }
+                mapX[x] = (float)(frameX - offsetX);
+                mapY[x] = (float)(frameY - offsetY);
+            }
+        }
+    });
+
+    // Fixed point: integer coordinates plus an index into OpenCV's bilinear weight table
+    cv::convertMaps(m_mapX, m_mapY, m_fixedXY, m_fixedTable, CV_16SC2);
+    m_dirty = false;
+    m_rebuildCount++;
+}
+
+void WarpEngine::apply(const cv::Mat& input, cv::Mat& output) {
+    if (input.empty() || !m_hasTransform) {
+        output = input.clone();
+        return;
+    }
+    if (m_dirty)
+        rebuildMaps();
+    // BGRA frames keep their aligned rows, remap writes into the existing buffer
+    if (input.channels() == 4)
+        FrameFormat::allocateAligned(m_outputSize, input.type(), output);
+    cv::remap(input, output, m_fixedXY, m_fixedTable, cv::INTER_LINEAR,
+              cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+}
@@ -0,0 +1,77 @@
+#ifndef WARPENGINE_HPP
+#define WARPENGINE_HPP
+
+#include <opencv2/opencv.hpp>
+
+class Undistortion;
+
+/**
+ * WarpEngine - Geometric warp driven by precomputed remap tables.
+ *
+ * The source coordinate of every output pixel is only computed when the transform, the
+ * sizes or the input offset change. The maps are stored in OpenCV's fixed-point format
+ * (CV_16SC2 integer coordinates plus a CV_16UC1 interpolation table index), so a steady
+ * state frame costs one cv::remap gather. Affine and perspective transforms share the path.
+ * A lens correction can be folded into the same tables, so undistortion and warp cost one gather.
+ */
+class WarpEngine {
+public:
+    WarpEngine();
+
+    /**
+     * Set an affine transform, maps are rebuilt on the next apply() if anything changed
+     * @param transformMat 2x3 matrix mapping frame coordinates to output coordinates
+     * @param outputSize Size of the output image
+     * @param inputOffset Frame position of the input's top left pixel when the input is a crop
+     */
+    void setAffine(const cv::Mat& transformMat, cv::Size outputSize, cv::Point inputOffset = cv::Point());
+
+    /**
+     * Set a perspective transform, maps are rebuilt on the next apply() if anything changed
+     * @param homography 3x3 matrix mapping frame coordinates to output coordinates
+     * @param outputSize Size of the output image
+     * @param inputOffset Frame position of the input's top left pixel when the input is a crop
+     */
+    void setPerspective(const cv::Mat& homography, cv::Size outputSize, cv::Point inputOffset = cv::Point());
+
+    /**
+     * Fold a lens correction into the maps: the transform then applies to the undistorted frame
+     * while apply() reads the distorted one. Only exact for filters that work per pixel.
+     * @param lens Calibration, not owned, nullptr for none
+     * @param frameSize Size of the distorted frames, the input offset is relative to them
+     */
+    void setLens(const Undistortion* lens, cv::Size frameSize = cv::Size());
+
+    /**
+     * Warp a frame with the current transform, pixels mapped from outside the input are black
+     * @param input Input image (the crop if an input offset was set)
+     * @param output Output image of the configured size
+     */
+    void apply(const cv::Mat& input, cv::Mat& output);
+
+    /**
+     * Number of times the maps were rebuilt, for statistics
+     */
+    int getRebuildCount() const { return m_rebuildCount; }
+
+private:
+    void setMatrix(const double* homography, cv::Size outputSize, cv::Point inputOffset);
+    void rebuildMaps();
+
+    double m_homography[9];     //!< frame -> output, row major
+    cv::Size m_outputSize;
+    cv::Point m_inputOffset;
+    bool m_hasTransform;
+    bool m_dirty;
+    int m_rebuildCount;
+    const Undistortion* m_lens;
+    cv::Size m_lensFrameSize;
+    int m_lensRevision;         //!< Undistortion::getRevision() the maps were built with
+
+    cv::Mat m_mapX;             //!< float maps, only used while rebuilding
+    cv::Mat m_mapY;
+    cv::Mat m_fixedXY;          //!< CV_16SC2 integer source coordinates
+    cv::Mat m_fixedTable;       //!< CV_16UC1 interpolation table indices
+};
+
+#endif // WARPENGINE_HPP
@@ -0,0 +1,40 @@
+#include "YuvShader.hpp"
+#include <stdio.h>
+
+YuvShader::YuvShader(std::string vertexShaderName, std::string fragmentShaderName)
+    : Shader(vertexShaderName, fragmentShaderName), m_texture(nullptr),
+      currentFilterMode(PASSTHROUGH), currentPixelSize(10.0f) {
+    lumaSamplerLocation = glGetUniformLocation(programID, "lumaSampler");
+    chromaSamplerLocation = glGetUniformLocation(programID, "chromaSampler");
+    layoutLocation = glGetUniformLocation(programID, "yuvLayout");
+    filterModeLocation = glGetUniformLocation(programID, "filterMode");
+    pixelSizeLocation = glGetUniformLocation(programID, "pixelSize");
+
+    if (lumaSamplerLocation == -1) {
+        printf("Warning: Could not find 'lumaSampler' uniform in YUV shader\n");
+    }
+}
+
+void YuvShader::setTexture(YuvTexture* texture) {
+    m_texture = texture;
+}
+
+void YuvShader::setFilterMode(int mode) {
+    currentFilterMode = mode;
+}
+
+void YuvShader::setPixelSize(float size) {
+    currentPixelSize = size;
+}
+
+void YuvShader::bind() {
+    glUseProgram(programID);
+    if (m_texture) {
+        m_texture->bindTexture();
+        glUniform1i(layoutLocation, (int)m_texture->getLayout());
+    }
+    glUniform1i(lumaSamplerLocation, 0);
+    glUniform1i(chromaSamplerLocation, 1);
+    glUniform1i(filterModeLocation, currentFilterMode);
+    glUniform1f(pixelSizeLocation, currentPixelSize);
+}
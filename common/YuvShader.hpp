@@ -0,0 +1,37 @@
+#ifndef YUV_SHADER_HPP
+#define YUV_SHADER_HPP
+
+#include "Shader.hpp"
+#include "YuvTexture.hpp"
+#include <string>
+
+//!  YuvShader.
+/*!
+ Samples a YuvTexture, converts to RGB, flips the image vertically and applies the selected filter,
+ all in one fragment shader pass.
+ */
+class YuvShader : public Shader {
+private:
+    YuvTexture* m_texture;
+    GLint lumaSamplerLocation;
+    GLint chromaSamplerLocation;
+    GLint layoutLocation;
+    GLint filterModeLocation;
+    GLint pixelSizeLocation;
+    int currentFilterMode;
+    float currentPixelSize;
+
+public:
+    //! Filter modes, values match the filterMode uniform in yuvVideo.frag
+    enum FilterMode { PASSTHROUGH = 0, SINCITY = 1, PIXELATION = 2 };
+
+    YuvShader(std::string vertexShaderName, std::string fragmentShaderName);
+
+    void setTexture(YuvTexture* texture);
+    void setFilterMode(int mode);
+    void setPixelSize(float size);
+
+    void bind() override;
+};
+
+#endif // YUV_SHADER_HPP
@@ -0,0 +1,65 @@
+#include <stddef.h>
+
+#include "YuvTexture.hpp"
+
+static void setupPlane(GLuint textureID, GLenum internalFormat, GLenum format, int width, int height) {
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+}
+
+YuvTexture::YuvTexture() : m_width(0), m_height(0), m_layout(NV12) {
+    glGenTextures(1, &m_lumaID);
+    glGenTextures(1, &m_chromaID);
+}
+
+YuvTexture::~YuvTexture() {
+    glDeleteTextures(1, &m_lumaID);
+    glDeleteTextures(1, &m_chromaID);
+}
+
+void YuvTexture::update(const unsigned char* data, int width, int height, int stride, Layout layout) {
+    if (width != m_width || height != m_height || layout != m_layout) {
+        if (layout == NV12) {
+            setupPlane(m_lumaID, GL_R8, GL_RED, width, height);
+            setupPlane(m_chromaID, GL_RG8, GL_RG, width / 2, height / 2);
+        } else {
+            // Chroma pairs are fetched per texel in the shader, filtering would mix U and V
+            setupPlane(m_lumaID, GL_RG8, GL_RG, width, height);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        }
+        m_width = width;
+        m_height = height;
+        m_layout = layout;
+    }
+
+    // Single byte rows need not be 4-byte aligned, padded rows are skipped through the row length
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, m_lumaID);
+    if (layout == NV12) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, stride);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED, GL_UNSIGNED_BYTE, data);
+        // The UV plane directly follows the Y plane, its rows hold stride / 2 UV pairs
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / 2);
+        glBindTexture(GL_TEXTURE_2D, m_chromaID);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width / 2, height / 2, GL_RG, GL_UNSIGNED_BYTE,
+                        data + (size_t)stride * height);
+    } else {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / 2);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RG, GL_UNSIGNED_BYTE, data);
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void YuvTexture::bindTexture() {
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_lumaID);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_layout == NV12 ? m_chromaID : 0);
+    glActiveTexture(GL_TEXTURE0);
+}
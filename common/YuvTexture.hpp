@@ -0,0 +1,46 @@
+/*
+ * YuvTexture.hpp
+ *
+ *  Texture pair holding a raw camera frame in its native YUV layout.
+ *  Colour conversion happens in the fragment shader (see yuvVideo.frag).
+ *
+ */
+#ifndef YUVTEXTURE_HPP
+#define YUVTEXTURE_HPP
+
+#include <glad/gl.h>
+
+//!  YuvTexture.
+/*!
+ NV12 is uploaded as a GL_R8 luma plane plus a half-resolution GL_RG8 interleaved chroma plane.
+ Packed YUYV (4:2:2) is uploaded as a single GL_RG8 texture: R holds Y, G alternates U and V.
+ */
+class YuvTexture {
+public:
+    //! Supported raw layouts, values match the yuvLayout uniform
+    enum Layout { NV12 = 0, YUYV = 1 };
+
+    YuvTexture();
+    ~YuvTexture();
+
+    //! update
+    /*! Uploads a raw frame whose rows (and NV12 chroma rows) are stride bytes apart, the chroma
+        plane following the stride * height luma bytes. Storage is reallocated when size or layout change. */
+    void update(const unsigned char* data, int width, int height, int stride, Layout layout);
+    //! bindTexture
+    /*! Binds luma to texture unit 0 and chroma to unit 1. */
+    void bindTexture();
+
+    Layout getLayout() const { return m_layout; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+private:
+    GLuint m_lumaID;    //!< Y plane (NV12) or packed YUYV
+    GLuint m_chromaID;  //!< interleaved UV plane (NV12 only)
+    int m_width;
+    int m_height;
+    Layout m_layout;
+};
+
+#endif
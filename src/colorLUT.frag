@@ -0,0 +1,14 @@
+#version 330 core
+in vec2 UV;
+out vec4 FragColor;
+
+uniform sampler2D myTextureSampler;
+uniform sampler3D colorTable;   // r along width, g along height, b along depth
+uniform float lutSize;          // entries per axis
+
+void main() {
+    vec4 color = texture(myTextureSampler, UV);
+    // 0 and 1 have to land on the centres of the first and last entries
+    vec3 coord = clamp(color.rgb, 0.0, 1.0) * ((lutSize - 1.0) / lutSize) + 0.5 / lutSize;
+    FragColor = vec4(texture(colorTable, coord).rgb, 1.0);
+}
@@ -0,0 +1,434 @@
+/*
+ * filtersBench.cpp
+ *
+ *  Microbenchmarks for the CPU side of the pipeline: Filters, Transformation,
+ *  WarpEngine, Undistortion, FrameFormat and the VBO indexer. Every case runs for each input
+ *  resolution and OpenCV thread count, results are printed as a table and can be
+ *  written as JSON (Google Benchmark layout, so its compare.py can diff two runs).
+ *
+ *  Usage: VC_2_bench [--json results.json] [--filter substring] [--min-time seconds]
+ *                    [--threads 1,2,4] [--resolutions 480p,720p,1080p,4k]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <ctime>
+#include <algorithm>
+#include <functional>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include <glm/glm.hpp>
+#include <opencv2/opencv.hpp>
+
+#include <common/Filters.hpp>
+#include <common/ColorLUT.hpp>
+#include <common/TemporalFilter.hpp>
+#include <common/Transformation.hpp>
+#include <common/WarpEngine.hpp>
+#include <common/Undistortion.hpp>
+#include <common/FrameFormat.hpp>
+#include <common/vboindexer.hpp>
+
+using namespace std;
+
+struct Resolution {
+    string name;
+    int width;
+    int height;
+};
+
+struct Result {
+    string name;
+    int threads;
+    int iterations;
+    double medianMs;
+    double meanMs;
+    double minMs;
+    double cpuMs;       // process CPU time per iteration, all threads
+    double itemsPerSecond;
+    double bytesPerSecond;
+};
+
+// One case: the function runs once per iteration, items and bytes describe that one iteration
+struct Case {
+    string name;
+    double items;       // pixels, or vertices for the indexer
+    double bytes;       // bytes read + written
+    bool threaded;      // false: the code never calls into OpenCV's thread pool, one thread count is enough
+    function<void()> run;
+};
+
+static vector<string> split(const string& text, char separator) {
+    vector<string> parts;
+    stringstream stream(text);
+    string part;
+    while (getline(stream, part, separator))
+        if (!part.empty()) parts.push_back(part);
+    return parts;
+}
+
+// CPU time of the whole process, so work on OpenCV's worker threads is included
+static double processCpuSeconds() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel.dwLowDateTime; k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime; u.HighPart = user.dwHighDateTime;
+    return (k.QuadPart + u.QuadPart) * 1e-7;
+#else
+    timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+static Result measure(const Case& c, int threads, double minTime) {
+    // Untimed warm-up: allocates outputs and fills caches
+    c.run();
+
+    vector<double> times;
+    double cpuStart = processCpuSeconds();
+    auto start = chrono::steady_clock::now();
+    while (times.size() < 3 ||
+           chrono::duration<double>(chrono::steady_clock::now() - start).count() < minTime) {
+        auto t0 = chrono::steady_clock::now();
+        c.run();
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count());
+    }
+    double cpuSeconds = processCpuSeconds() - cpuStart;
+
+    Result r;
+    r.name = c.name + "/threads:" + to_string(threads);
+    r.threads = threads;
+    r.iterations = (int)times.size();
+    vector<double> sorted = times;
+    sort(sorted.begin(), sorted.end());
+    r.medianMs = sorted[sorted.size() / 2];
+    r.minMs = sorted.front();
+    double total = 0.0;
+    for (double t : times) total += t;
+    r.meanMs = total / times.size();
+    r.cpuMs = cpuSeconds * 1000.0 / times.size();
+    r.itemsPerSecond = c.items / (r.medianMs / 1000.0);
+    r.bytesPerSecond = c.bytes / (r.medianMs / 1000.0);
+    return r;
+}
+
+// Triangle soup of a w x h grid, every inner vertex is shared by up to six corners
+static void makeGrid(int w, int h, vector<glm::vec3>& vertices, vector<glm::vec2>& uvs, vector<glm::vec3>& normals) {
+    vertices.clear();
+    uvs.clear();
+    normals.clear();
+    const int corner[6][2] = { {0, 0}, {1, 0}, {0, 1}, {0, 1}, {1, 0}, {1, 1} };
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            for (int k = 0; k < 6; k++) {
+                float px = (float)(x + corner[k][0]);
+                float py = (float)(y + corner[k][1]);
+                vertices.push_back(glm::vec3(px, py, 0.0f));
+                uvs.push_back(glm::vec2(px / w, py / h));
+                normals.push_back(glm::vec3(0.0f, 0.0f, 1.0f));
+            }
+        }
+    }
+}
+
+static void writeJSON(const string& path, const vector<Result>& results) {
+    ofstream file(path.c_str());
+    if (!file.is_open()) {
+        cerr << "Could not write " << path << endl;
+        return;
+    }
+    time_t now = time(nullptr);
+    char date[64];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    file << "{\n  \"context\": {\n"
+         << "    \"date\": \"" << date << "\",\n"
+         << "    \"num_cpus\": " << cv::getNumberOfCPUs() << ",\n"
+         << "    \"opencv_version\": \"" << CV_VERSION << "\",\n"
+         << "    \"library_build_type\": \"" <<
+#ifdef NDEBUG
+            "release"
+#else
+            "debug"
+#endif
+         << "\"\n  },\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        file << "    {\n"
+             << "      \"name\": \"" << r.name << "\",\n"
+             << "      \"run_type\": \"iteration\",\n"
+             << "      \"threads\": " << r.threads << ",\n"
+             << "      \"iterations\": " << r.iterations << ",\n"
+             << "      \"real_time\": " << r.medianMs << ",\n"
+             << "      \"cpu_time\": " << r.cpuMs << ",\n"
+             << "      \"mean_time\": " << r.meanMs << ",\n"
+             << "      \"min_time\": " << r.minMs << ",\n"
+             << "      \"time_unit\": \"ms\",\n"
+             << "      \"items_per_second\": " << r.itemsPerSecond << ",\n"
+             << "      \"bytes_per_second\": " << r.bytesPerSecond << "\n"
+             << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    cout << "Results written to " << path << endl;
+}
+
+int main(int argc, char** argv) {
+    string jsonPath;
+    string filter;
+    double minTime = 0.25;
+    vector<int> threadCounts;
+    vector<Resolution> resolutions;
+    const Resolution allResolutions[] = {
+        { "480p", 640, 480 }, { "720p", 1280, 720 }, { "1080p", 1920, 1080 }, { "4k", 3840, 2160 }
+    };
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = atof(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            for (const string& t : split(argv[++i], ','))
+                threadCounts.push_back(max(1, atoi(t.c_str())));
+        } else if (arg == "--resolutions" && i + 1 < argc) {
+            for (const string& name : split(argv[++i], ','))
+                for (const Resolution& r : allResolutions)
+                    if (r.name == name) resolutions.push_back(r);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--json results.json] [--filter substring] [--min-time seconds]"
+                 << " [--threads 1,2,4] [--resolutions 480p,720p,1080p,4k]" << endl;
+            return -1;
+        }
+    }
+    if (threadCounts.empty()) {
+        int cpus = cv::getNumberOfCPUs();
+        for (int t = 1; t < cpus; t *= 2) threadCounts.push_back(t);
+        threadCounts.push_back(cpus);
+    }
+    if (resolutions.empty())
+        resolutions.assign(begin(allResolutions), end(allResolutions));
+
+    // --- Cases ---------------------------------------------------------------
+    // Inputs are deterministic noise, the worst case for branches in the filters
+    vector<Case> cases;
+    vector<cv::Mat*> buffers;   // outputs stay alive across iterations like in the app
+    vector<WarpEngine*> engines;
+    vector<Undistortion*> lenses;
+    vector<TemporalFilter*> temporalFilters;
+    const ColorLUT sinCity33 = ColorLUT::sinCity(33);
+    const ColorLUT sinCity65 = ColorLUT::sinCity(65);
+    auto output = [&buffers]() { buffers.push_back(new cv::Mat()); return buffers.back(); };
+    vector<cv::Mat> inputs;
+    inputs.reserve(2 * resolutions.size());   // cases keep references into it
+
+    for (const Resolution& res : resolutions) {
+        cv::RNG rng(12345);
+        inputs.push_back(cv::Mat(res.height, res.width, CV_8UC3));
+        cv::Mat& bgr = inputs.back();
+        rng.fill(bgr, cv::RNG::UNIFORM, 0, 256);
+        inputs.push_back(cv::Mat());
+        cv::Mat& bgra = inputs.back();
+        FrameFormat::bgrToBGRA(bgr, bgra);
+
+        const double pixels = (double)res.width * res.height;
+        const double bgrBytes = pixels * 3.0 * 2.0;   // read + write
+        const double bgraBytes = pixels * 4.0 * 2.0;
+        const string suffix = "/" + res.name;
+        const float tx = res.width * 0.05f, ty = res.height * 0.05f;
+
+        cv::Mat* out = output();
+        cases.push_back({ "Filters::applySinCity/bgr" + suffix, pixels, bgrBytes, false,
+                          [&bgr, out]() { Filters::applySinCity(bgr, *out); } });
+        out = output();
+        cases.push_back({ "Filters::applySinCity/bgra" + suffix, pixels, bgraBytes, false,
+                          [&bgra, out]() { Filters::applySinCity(bgra, *out); } });
+        // Table lookup against the float math it replaces
+        for (const ColorLUT* table : { &sinCity33, &sinCity65 }) {
+            string name = "Filters::applyColorLUT/size:" + to_string(table->getSize());
+            out = output();
+            cases.push_back({ name + "/bgr" + suffix, pixels, bgrBytes, true,
+                              [&bgr, out, table]() { Filters::applyColorLUT(bgr, *out, *table); } });
+            out = output();
+            cases.push_back({ name + "/bgra" + suffix, pixels, bgraBytes, true,
+                              [&bgra, out, table]() { Filters::applyColorLUT(bgra, *out, *table); } });
+        }
+        for (int block : { 4, 10, 32 }) {
+            out = output();
+            cases.push_back({ "Filters::applyPixelation/block:" + to_string(block) + "/bgr" + suffix, pixels, bgrBytes, false,
+                              [&bgr, out, block]() { Filters::applyPixelation(bgr, *out, block); } });
+            out = output();
+            cases.push_back({ "Filters::applyPixelation/block:" + to_string(block) + "/bgra" + suffix, pixels, bgraBytes, false,
+                              [&bgra, out, block]() { Filters::applyPixelation(bgra, *out, block); } });
+        }
+        // Both should stay flat across radius / sigma
+        for (int radius : { 2, 16, 64 }) {
+            out = output();
+            cases.push_back({ "Filters::applyBoxBlur/radius:" + to_string(radius) + "/bgra" + suffix, pixels, bgraBytes, true,
+                              [&bgra, out, radius]() { Filters::applyBoxBlur(bgra, *out, radius); } });
+        }
+        for (int sigma : { 2, 8, 32 }) {
+            out = output();
+            cases.push_back({ "Filters::applyGaussianBlur/sigma:" + to_string(sigma) + "/bgra" + suffix, pixels, bgraBytes, true,
+                              [&bgra, out, sigma]() { Filters::applyGaussianBlur(bgra, *out, (float)sigma); } });
+        }
+
+        // Running averages: the cost must not depend on the history length
+        for (int length : { 2, 16 }) {
+            TemporalFilter* filter = new TemporalFilter();
+            temporalFilters.push_back(filter);
+            filter->setHistoryLength(length);
+            out = output();
+            cases.push_back({ "TemporalFilter::apply/denoise/length:" + to_string(length) + "/bgra" + suffix, pixels, bgraBytes, true,
+                              [&bgra, out, filter]() { filter->apply(bgra, *out, TemporalFilter::DENOISE); } });
+        }
+        TemporalFilter* motion = new TemporalFilter();
+        temporalFilters.push_back(motion);
+        out = output();
+        cases.push_back({ "TemporalFilter::apply/motion/bgra" + suffix, pixels, bgraBytes, true,
+                          [&bgra, out, motion]() { motion->apply(bgra, *out, TemporalFilter::MOTION); } });
+
+        cv::Mat affine = Transformation::buildTransformMatrix(tx, ty, 15.0f, 1.2f, res.width / 2.0f, res.height / 2.0f);
+        out = output();
+        cases.push_back({ "Filters::applyAffineTransform" + suffix, pixels, bgrBytes, true,
+                          [&bgr, out, affine]() { Filters::applyAffineTransform(bgr, *out, affine); } });
+        out = output();
+        cases.push_back({ "Transformation::applyTranslation" + suffix, pixels, bgrBytes, true,
+                          [&bgr, out, tx, ty]() { Transformation::applyTranslation(bgr, *out, tx, ty); } });
+        out = output();
+        cases.push_back({ "Transformation::applyRotation" + suffix, pixels, bgrBytes, true,
+                          [&bgr, out]() { Transformation::applyRotation(bgr, *out, 15.0f); } });
+        out = output();
+        cases.push_back({ "Transformation::applyScaling" + suffix, pixels, bgrBytes, true,
+                          [&bgr, out]() { Transformation::applyScaling(bgr, *out, 1.2f); } });
+        out = output();
+        cases.push_back({ "Transformation::applyCombinedTransform" + suffix, pixels, bgrBytes, true,
+                          [&bgr, out, tx, ty]() { Transformation::applyCombinedTransform(bgr, *out, tx, ty, 15.0f, 1.2f); } });
+        out = output();
+        cases.push_back({ "Transformation::applyCombinedTransform/bgra" + suffix, pixels, bgraBytes, true,
+                          [&bgra, out, tx, ty]() { Transformation::applyCombinedTransform(bgra, *out, tx, ty, 15.0f, 1.2f); } });
+
+        // Zoomed in 4x: the visible crop is warped to the full frame
+        cv::Rect visible = Transformation::visibleSourceRect(bgr.size(), 0.0f, 0.0f, 0.0f, 4.0f);
+        cv::Mat crop = bgr(visible);
+        out = output();
+        cv::Size frameSize = bgr.size();
+        cases.push_back({ "Transformation::applyCombinedTransform/crop/zoom:4" + suffix, pixels, bgrBytes, true,
+                          [crop, visible, frameSize, out]() {
+                              Transformation::applyCombinedTransform(crop, *out, visible, frameSize, 0.0f, 0.0f, 0.0f, 4.0f);
+                          } });
+
+        // Incremental mode: a tenth of the tiles changed
+        vector<cv::Rect> dirty;
+        for (int y = 0; y < res.height; y += 320)
+            for (int x = 0; x < res.width; x += 320)
+                dirty.push_back(cv::Rect(x, y, 32, 32) & cv::Rect(0, 0, res.width, res.height));
+        double dirtyPixels = 0.0;
+        for (const cv::Rect& r : dirty) dirtyPixels += r.area();
+        out = output();
+        cases.push_back({ "Transformation::applyCombinedTransform/regions" + suffix, dirtyPixels, dirtyPixels * 6.0, true,
+                          [&bgr, out, dirty, tx, ty]() {
+                              vector<cv::Rect> written;
+                              Transformation::applyCombinedTransform(bgr, *out, dirty, written, tx, ty, 15.0f, 1.2f);
+                          } });
+
+        // Same warp from cached remap tables
+        WarpEngine* engine = new WarpEngine();
+        engines.push_back(engine);
+        engine->setAffine(affine, bgr.size());
+        out = output();
+        cases.push_back({ "WarpEngine::apply" + suffix, pixels, bgrBytes, true,
+                          [&bgr, out, engine]() { engine->apply(bgr, *out); } });
+
+        // Lens correction alone, and folded into the warp (should cost the same as the warp)
+        Undistortion* lens = new Undistortion();
+        lenses.push_back(lens);
+        double camera[9] = { 0.8 * res.width, 0.0, res.width / 2.0, 0.0, 0.8 * res.width, res.height / 2.0, 0.0, 0.0, 1.0 };
+        double coefficients[5] = { -0.25, 0.08, 0.001, -0.0005, 0.0 };
+        lens->setCalibration(cv::Mat(3, 3, CV_64F, camera), cv::Mat(1, 5, CV_64F, coefficients), bgr.size());
+        out = output();
+        cases.push_back({ "Undistortion::apply" + suffix, pixels, bgrBytes, true,
+                          [&bgr, out, lens]() { lens->apply(bgr, *out); } });
+        WarpEngine* fused = new WarpEngine();
+        engines.push_back(fused);
+        fused->setAffine(affine, bgr.size());
+        fused->setLens(lens, bgr.size());
+        out = output();
+        cases.push_back({ "WarpEngine::apply/lens" + suffix, pixels, bgrBytes, true,
+                          [&bgr, out, fused]() { fused->apply(bgr, *out); } });
+
+        out = output();
+        cases.push_back({ "FrameFormat::bgrToBGRA" + suffix, pixels, pixels * 7.0, true,
+                          [&bgr, out]() { FrameFormat::bgrToBGRA(bgr, *out, true); } });
+    }
+
+    // VBO indexer: soups of a grid, the slow reference only on a small one (it is quadratic)
+    vector<glm::vec3> gridVertices, smallVertices, gridNormals, smallNormals;
+    vector<glm::vec2> gridUVs, smallUVs;
+    makeGrid(100, 100, gridVertices, gridUVs, gridNormals);
+    makeGrid(24, 24, smallVertices, smallUVs, smallNormals);
+    vector<glm::vec3> gridTangents(gridVertices.size(), glm::vec3(1, 0, 0));
+    vector<glm::vec3> gridBitangents(gridVertices.size(), glm::vec3(0, 1, 0));
+    const double vertexBytes = sizeof(glm::vec3) * 2 + sizeof(glm::vec2);
+    cases.push_back({ "indexVBO/grid:100", (double)gridVertices.size(), gridVertices.size() * vertexBytes, false, [&]() {
+        vector<unsigned short> indices; vector<glm::vec3> v, n; vector<glm::vec2> uv;
+        indexVBO(gridVertices, gridUVs, gridNormals, indices, v, uv, n);
+    } });
+    cases.push_back({ "indexVBO_TBN/grid:100", (double)gridVertices.size(),
+                      gridVertices.size() * (vertexBytes + 2 * sizeof(glm::vec3)), false, [&]() {
+        vector<unsigned short> indices; vector<glm::vec3> v, n, t, b; vector<glm::vec2> uv;
+        indexVBO_TBN(gridVertices, gridUVs, gridNormals, gridTangents, gridBitangents, indices, v, uv, n, t, b);
+    } });
+    cases.push_back({ "indexVBO_slow/grid:24", (double)smallVertices.size(), smallVertices.size() * vertexBytes, false, [&]() {
+        vector<unsigned short> indices; vector<glm::vec3> v, n; vector<glm::vec2> uv;
+        indexVBO_slow(smallVertices, smallUVs, smallNormals, indices, v, uv, n);
+    } });
+
+    // --- Run -----------------------------------------------------------------
+    vector<Result> results;
+    printf("%-72s %8s %10s %10s %10s %12s %12s\n", "Benchmark", "Threads", "Median ms", "Min ms", "CPU ms",
+           "MPixel/s", "MB/s");
+    for (const Case& c : cases) {
+        if (!filter.empty() && c.name.find(filter) == string::npos)
+            continue;
+        for (size_t t = 0; t < threadCounts.size(); t++) {
+            if (!c.threaded && t > 0)
+                break;
+            int threads = c.threaded ? threadCounts[t] : 1;
+            cv::setNumThreads(threads);
+            Result r = measure(c, threads, minTime);
+            printf("%-72s %8d %10.3f %10.3f %10.3f %12.1f %12.1f\n", c.name.c_str(), threads, r.medianMs, r.minMs,
+                   r.cpuMs, r.itemsPerSecond / 1e6, r.bytesPerSecond / 1e6);
+            fflush(stdout);
+            results.push_back(r);
+        }
+    }
+
+    if (!jsonPath.empty())
+        writeJSON(jsonPath, results);
+
+    for (cv::Mat* buffer : buffers)
+        delete buffer;
+    for (WarpEngine* engine : engines)
+        delete engine;
+    for (Undistortion* lens : lenses)
+        delete lens;
+    for (TemporalFilter* filter : temporalFilters)
+        delete filter;
+    return 0;
+}
@@ -0,0 +1,9 @@
+#version 330 core
+out vec2 UV;
+
+// One triangle that covers the viewport, generated from gl_VertexID without a vertex buffer
+void main() {
+    vec2 position = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    UV = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,18 @@
+#version 330 core
+in vec2 UV;
+out vec4 FragColor;
+
+uniform sampler2D myTextureSampler;
+uniform vec2 texelStep;         // one texel along the blur direction, in UV units
+uniform int tapCount;           // centre tap plus merged pairs per side
+uniform float tapOffsets[16];   // in texels, between the two texels of a pair
+uniform float tapWeights[16];   // combined weight of both texels of a pair
+
+void main() {
+    vec4 sum = texture(myTextureSampler, UV) * tapWeights[0];
+    for (int i = 1; i < tapCount; i++) {
+        vec2 offset = texelStep * tapOffsets[i];
+        sum += (texture(myTextureSampler, UV + offset) + texture(myTextureSampler, UV - offset)) * tapWeights[i];
+    }
+    FragColor = sum;
+}
@@ -0,0 +1,15 @@
+#version 330 core
+layout (location = 0) in vec3 vertexPosition_modelspace;
+layout (location = 3) in mat4 instanceModel; // per instance, streamed by RenderQueue (locations 3-6)
+
+out vec2 UV;
+
+uniform mat4 VP;
+const float aspectRatio=1.777; // same UV mapping as videoTextureShader.vert
+
+void main() {
+    gl_Position = VP * instanceModel * vec4(vertexPosition_modelspace, 1.0);
+
+    vec2 normalized_pos = vec2(vertexPosition_modelspace.x / aspectRatio, vertexPosition_modelspace.y);
+    UV = normalized_pos * 0.5 + 0.5;
+}
@@ -0,0 +1,138 @@
+/*
+ * meshConverter.cpp
+ *
+ *  Offline converter from Wavefront OBJ to the binary .vcmesh container.
+ *  Runs the VBO indexer once here so the application can upload the result
+ *  straight from a memory mapping at startup.
+ *
+ *  Usage: VC_2_meshconv input.obj output.vcmesh
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include <glm/glm.hpp>
+
+#include <common/vboindexer.hpp>
+#include <common/MeshFile.hpp>
+
+using namespace std;
+
+// Parses one "v/vt/vn" face corner, missing entries are returned as 0 (OBJ indices are 1-based)
+static void parseCorner(const string& token, int& v, int& vt, int& vn) {
+    v = vt = vn = 0;
+    size_t first = token.find('/');
+    v = atoi(token.substr(0, first).c_str());
+    if (first == string::npos) return;
+    size_t second = token.find('/', first + 1);
+    string uvPart = token.substr(first + 1, second == string::npos ? string::npos : second - first - 1);
+    if (!uvPart.empty()) vt = atoi(uvPart.c_str());
+    if (second != string::npos) vn = atoi(token.substr(second + 1).c_str());
+}
+
+// Resolves a (possibly negative, relative) OBJ index into a 0-based index, -1 if absent
+static int resolveIndex(int index, size_t count) {
+    if (index > 0) return index - 1;
+    if (index < 0) return (int)count + index;
+    return -1;
+}
+
+static bool loadOBJ(const char* path,
+                    vector<glm::vec3>& out_vertices,
+                    vector<glm::vec2>& out_uvs,
+                    vector<glm::vec3>& out_normals) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        printf("%s could not be opened.\n", path);
+        return false;
+    }
+
+    vector<glm::vec3> positions;
+    vector<glm::vec2> uvs;
+    vector<glm::vec3> normals;
+
+    string line;
+    while (getline(file, line)) {
+        istringstream stream(line);
+        string type;
+        stream >> type;
+        if (type == "v") {
+            glm::vec3 p;
+            stream >> p.x >> p.y >> p.z;
+            positions.push_back(p);
+        } else if (type == "vt") {
+            glm::vec2 uv;
+            stream >> uv.x >> uv.y;
+            uvs.push_back(uv);
+        } else if (type == "vn") {
+            glm::vec3 n;
+            stream >> n.x >> n.y >> n.z;
+            normals.push_back(n);
+        } else if (type == "f") {
+            vector<string> corners;
+            string token;
+            while (stream >> token) corners.push_back(token);
+
+            // Triangulate polygons as a fan around the first corner
+            for (size_t i = 1; i + 1 < corners.size(); i++) {
+                const string* tri[3] = { &corners[0], &corners[i], &corners[i + 1] };
+                for (int c = 0; c < 3; c++) {
+                    int v, vt, vn;
+                    parseCorner(*tri[c], v, vt, vn);
+                    int pi = resolveIndex(v, positions.size());
+                    int ti = resolveIndex(vt, uvs.size());
+                    int ni = resolveIndex(vn, normals.size());
+                    if (pi < 0 || pi >= (int)positions.size()) {
+                        printf("Invalid face in %s\n", path);
+                        return false;
+                    }
+                    out_vertices.push_back(positions[pi]);
+                    out_uvs.push_back(ti >= 0 && ti < (int)uvs.size() ? uvs[ti] : glm::vec2(0.0f));
+                    out_normals.push_back(ni >= 0 && ni < (int)normals.size() ? normals[ni] : glm::vec3(0.0f));
+                }
+            }
+        }
+    }
+    return !out_vertices.empty();
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        cerr << "Usage: " << argv[0] << " input.obj output.vcmesh" << endl;
+        return -1;
+    }
+
+    vector<glm::vec3> vertices;
+    vector<glm::vec2> uvs;
+    vector<glm::vec3> normals;
+    if (!loadOBJ(argv[1], vertices, uvs, normals)) {
+        cerr << "Error: no geometry read from " << argv[1] << endl;
+        return -1;
+    }
+
+    vector<unsigned int> indices;
+    vector<glm::vec3> indexed_vertices;
+    vector<glm::vec2> indexed_uvs;
+    vector<glm::vec3> indexed_normals;
+    indexVBO(vertices, uvs, normals, indices, indexed_vertices, indexed_uvs, indexed_normals);
+
+    // 16 bit indices while they reach every vertex, they halve the index blob
+    bool wide = indexed_vertices.size() > 65536;
+    bool written;
+    if (wide) {
+        written = MeshFile::write(argv[2], indices, indexed_vertices, indexed_uvs, indexed_normals);
+    } else {
+        vector<unsigned short> narrow(indices.begin(), indices.end());
+        written = MeshFile::write(argv[2], narrow, indexed_vertices, indexed_uvs, indexed_normals);
+    }
+    if (!written)
+        return -1;
+
+    cout << "Wrote " << argv[2] << ": " << indexed_vertices.size() << " vertices, "
+         << indices.size() / 3 << " triangles, " << (wide ? 32 : 16) << " bit indices" << endl;
+    return 0;
+}
@@ -0,0 +1,14 @@
+#version 330 core
+layout (location = 0) in vec3 vertexPosition_modelspace;
+layout (location = 1) in vec2 vertexUV;
+
+out vec2 UV;
+
+uniform mat4 MVP;
+
+void main() {
+    gl_Position = MVP * vec4(vertexPosition_modelspace, 1.0);
+
+    // Meshes carry their own texture coordinates (e.g. from a projector calibration)
+    UV = vertexUV;
+}
@@ -0,0 +1,541 @@
+/*
+ * pipelineBench.cpp
+ *
+ *  End-to-end benchmark of the render loop without a visible window: capture -> filter ->
+ *  transform -> upload -> draw (-> readback) into an offscreen framebuffer. Scripted scenarios
+ *  cover every filter in both processing modes, zoom and rotation sweeps, rapid filter switching
+ *  and resolution changes. Per-stage and total frame-time percentiles, CPU utilisation and peak
+ *  RSS are printed and optionally written as JSON. The exit code is non-zero if a GL error
+ *  occurred or a scenario's p99 frame time exceeds --max-p99, so it can gate a deployment.
+ *
+ *  Usage: VC_2_pipeline_bench [--source synthetic|video file|recording.000.vcraw] [--frames N] [--output WxH]
+ *                             [--readback] [--scenario substring] [--json results.json]
+ *                             [--max-p99 ms]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <ctime>
+#include <algorithm>
+#include <functional>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Expand the glad loader implementation exactly once, later includes only see the declarations
+#define GLAD_GL_IMPLEMENTATION
+#include <glad/gl.h>
+#undef GLAD_GL_IMPLEMENTATION
+
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <opencv2/opencv.hpp>
+
+#include <common/Camera.hpp>
+#include <common/Quad.hpp>
+#include <common/Texture.hpp>
+#include <common/TextureShader.hpp>
+#include <common/PixelationShader.hpp>
+#include <common/RenderTarget.hpp>
+#include <common/GpuTimer.hpp>
+#include <common/Filters.hpp>
+#include <common/Transformation.hpp>
+#include <common/WarpEngine.hpp>
+#include <common/FrameSource.hpp>
+#include <common/OpenCVFrameSource.hpp>
+#include <common/SyntheticFrameSource.hpp>
+#include <common/RawFrameReplayer.hpp>
+
+using namespace std;
+
+enum class FilterType { NONE, SINCITY, PIXELATION };
+
+// Everything a scenario can change per frame, mirrors the interactive controls of VC_2_app
+struct PipelineState {
+    FilterType filter;
+    bool cpu;
+    int pixelSize;
+    float translateX;
+    float translateY;
+    float rotateZ;
+    float scale;
+    cv::Size resolution;
+};
+
+struct Scenario {
+    string name;
+    function<void(int frame, int frames, PipelineState& state)> step;
+};
+
+enum Stage { CAPTURE, FILTER, TRANSFORM, UPLOAD, DRAW, READBACK, GPU, TOTAL, STAGE_COUNT };
+static const char* stageNames[STAGE_COUNT] = { "capture", "filter", "transform", "upload", "draw", "readback", "gpu", "total" };
+
+struct StageStats {
+    double mean, p50, p90, p99, max;
+};
+
+struct ScenarioResult {
+    string name;
+    int frames;
+    StageStats stages[STAGE_COUNT];
+    double wallSeconds;
+    double cpuUtilization;  // process CPU time / wall time, > 1 when worker threads are busy
+    long peakRssKB;
+    int glErrors;
+};
+
+static double cpuSeconds() {
+#ifndef _WIN32
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+#else
+    return -1.0;
+#endif
+}
+
+static long peakRssKB() {
+#ifndef _WIN32
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+static StageStats summarize(vector<double> samples) {
+    StageStats stats = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+    if (samples.empty())
+        return stats;
+    sort(samples.begin(), samples.end());
+    double total = 0.0;
+    for (double s : samples) total += s;
+    stats.mean = total / samples.size();
+    // Nearest rank percentiles
+    auto rank = [&samples](double p) {
+        size_t index = (size_t)(p * samples.size() + 0.999999);
+        return samples[min(samples.size() - 1, index > 0 ? index - 1 : 0)];
+    };
+    stats.p50 = rank(0.50);
+    stats.p90 = rank(0.90);
+    stats.p99 = rank(0.99);
+    stats.max = samples.back();
+    return stats;
+}
+
+static vector<Scenario> buildScenarios() {
+    vector<Scenario> scenarios;
+    const char* filterNames[3] = { "none", "sincity", "pixelation" };
+    for (int mode = 0; mode < 2; mode++) {
+        bool cpu = mode == 1;
+        string modeName = cpu ? "cpu" : "gpu";
+        for (int f = 0; f < 3; f++) {
+            scenarios.push_back({ string("filter/") + filterNames[f] + "/" + modeName,
+                                  [cpu, f](int, int, PipelineState& s) { s.cpu = cpu; s.filter = (FilterType)f; } });
+        }
+        // Zoom from 0.5x to 4x, the CPU path then only filters the visible part of the frame
+        scenarios.push_back({ "zoom_sweep/" + modeName, [cpu](int frame, int frames, PipelineState& s) {
+            s.cpu = cpu;
+            s.filter = FilterType::PIXELATION;
+            s.scale = 0.5f + 3.5f * frame / max(1, frames - 1);
+        } });
+        // Full turn, every frame needs new remap tables on the CPU
+        scenarios.push_back({ "rotate_sweep/" + modeName, [cpu](int frame, int frames, PipelineState& s) {
+            s.cpu = cpu;
+            s.filter = FilterType::SINCITY;
+            s.rotateZ = 360.0f * frame / max(1, frames);
+            s.scale = 1.2f;
+            s.translateX = 0.1f;
+        } });
+        // Source resolution changes every 20 frames, textures and buffers are reallocated
+        scenarios.push_back({ "resolution_change/" + modeName, [cpu](int frame, int, PipelineState& s) {
+            const cv::Size sizes[3] = { cv::Size(640, 480), cv::Size(1280, 720), cv::Size(1920, 1080) };
+            s.cpu = cpu;
+            s.filter = FilterType::SINCITY;
+            s.resolution = sizes[(frame / 20) % 3];
+        } });
+    }
+    // A new filter every frame and a mode switch every 10 frames
+    scenarios.push_back({ "filter_switching", [](int frame, int, PipelineState& s) {
+        s.filter = (FilterType)(frame % 3);
+        s.cpu = (frame / 10) % 2 == 1;
+        s.pixelSize = 4 + 4 * (frame % 4);
+    } });
+    return scenarios;
+}
+
+static void writeJSON(const string& path, const vector<ScenarioResult>& results, const string& renderer,
+                      const string& source, cv::Size output, bool readback) {
+    ofstream file(path.c_str());
+    if (!file.is_open()) {
+        cerr << "Could not write " << path << endl;
+        return;
+    }
+    time_t now = time(nullptr);
+    char date[64];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    file << "{\n  \"context\": {\n"
+         << "    \"date\": \"" << date << "\",\n"
+         << "    \"renderer\": \"" << renderer << "\",\n"
+         << "    \"source\": \"" << source << "\",\n"
+         << "    \"output\": \"" << output.width << "x" << output.height << "\",\n"
+         << "    \"readback\": " << (readback ? "true" : "false") << ",\n"
+         << "    \"num_cpus\": " << cv::getNumberOfCPUs() << ",\n"
+         << "    \"peak_rss_kb\": " << peakRssKB() << "\n"
+         << "  },\n  \"scenarios\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const ScenarioResult& r = results[i];
+        file << "    {\n"
+             << "      \"name\": \"" << r.name << "\",\n"
+             << "      \"frames\": " << r.frames << ",\n"
+             << "      \"wall_s\": " << r.wallSeconds << ",\n"
+             << "      \"cpu_utilization\": " << r.cpuUtilization << ",\n"
+             << "      \"peak_rss_kb\": " << r.peakRssKB << ",\n"
+             << "      \"gl_errors\": " << r.glErrors << ",\n"
+             << "      \"stages_ms\": {\n";
+        for (int s = 0; s < STAGE_COUNT; s++) {
+            const StageStats& st = r.stages[s];
+            file << "        \"" << stageNames[s] << "\": { \"mean\": " << st.mean << ", \"p50\": " << st.p50
+                 << ", \"p90\": " << st.p90 << ", \"p99\": " << st.p99 << ", \"max\": " << st.max << " }"
+                 << (s + 1 < STAGE_COUNT ? "," : "") << "\n";
+        }
+        file << "      }\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    cout << "Results written to " << path << endl;
+}
+
+int main(int argc, char** argv) {
+    string sourceName = "synthetic";
+    int framesPerScenario = 240;
+    cv::Size outputSize(1920, 1080);
+    bool readback = false;
+    string scenarioFilter;
+    string jsonPath;
+    double maxP99 = -1.0;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--source" && i + 1 < argc) {
+            sourceName = argv[++i];
+        } else if (arg == "--frames" && i + 1 < argc) {
+            framesPerScenario = max(1, atoi(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &outputSize.width, &outputSize.height) != 2) {
+                cerr << "Output size must look like 1920x1080" << endl;
+                return -1;
+            }
+        } else if (arg == "--readback") {
+            readback = true;
+        } else if (arg == "--scenario" && i + 1 < argc) {
+            scenarioFilter = argv[++i];
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (arg == "--max-p99" && i + 1 < argc) {
+            maxP99 = atof(argv[++i]);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--source synthetic|video file|recording.000.vcraw] [--frames N] [--output WxH]"
+                 << " [--readback] [--scenario substring] [--json results.json] [--max-p99 ms]" << endl;
+            return -1;
+        }
+    }
+
+    // --- Source ---
+    FrameSource* source = nullptr;
+    SyntheticFrameSource* synthetic = nullptr;
+    OpenCVFrameSource* fileSource = nullptr;
+    RawFrameReplayer* replaySource = nullptr;
+    const string rawExtension = RAWFRAME_EXTENSION;
+    if (sourceName == "synthetic") {
+        synthetic = new SyntheticFrameSource(1280, 720);
+        source = synthetic;
+    } else if (sourceName.size() > rawExtension.size() &&
+               sourceName.compare(sourceName.size() - rawExtension.size(), rawExtension.size(), rawExtension) == 0) {
+        // Recorded camera input, replayed from the mapping without decoding
+        replaySource = new RawFrameReplayer(sourceName);
+        source = replaySource;
+    } else {
+        fileSource = new OpenCVFrameSource(sourceName);
+        source = fileSource;
+    }
+    if (!source->isOpened()) {
+        cerr << "Error: could not open source " << sourceName << endl;
+        delete source;
+        return -1;
+    }
+
+    // --- Hidden window, only needed for the GL context ---
+    if (!glfwInit()) {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        delete source;
+        return -1;
+    }
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    GLFWwindow* window = glfwCreateWindow(64, 64, "VC_2_pipeline_bench", NULL, NULL);
+    if (window == NULL) {
+        fprintf(stderr, "Failed to open GLFW window.\n");
+        glfwTerminate();
+        delete source;
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    int version = gladLoadGL(glfwGetProcAddress);
+    if (version == 0) {
+        fprintf(stderr, "Failed to initialize OpenGL context (GLAD)\n");
+        glfwTerminate();
+        delete source;
+        return -1;
+    }
+    string renderer = (const char*)glGetString(GL_RENDERER);
+    cout << "Renderer: " << renderer << ", OpenGL " << GLAD_VERSION_MAJOR(version) << "." << GLAD_VERSION_MINOR(version) << endl;
+
+    RenderTarget* target = new RenderTarget(outputSize.width, outputSize.height);
+    if (!target->isComplete()) {
+        fprintf(stderr, "Offscreen framebuffer is incomplete\n");
+        delete target;
+        glfwTerminate();
+        delete source;
+        return -1;
+    }
+    glClearColor(0.1f, 0.1f, 0.2f, 0.0f);
+    glEnable(GL_DEPTH_TEST);
+
+    GLuint VertexArrayID;
+    glGenVertexArrays(1, &VertexArrayID);
+    glBindVertexArray(VertexArrayID);
+
+    // --- Same scene setup as VC_2_app ---
+    Camera* renderingCamera = new Camera();
+    renderingCamera->setPosition(glm::vec3(0, 0, -2.5));
+    Quad* videoSurface = new Quad((float)source->getWidth() / (float)source->getHeight());
+    TextureShader* passthroughShader = new TextureShader("videoTextureShader.vert", "videoTextureShader.frag");
+    TextureShader* sinCityShader = new TextureShader("videoTextureShader.vert", "sinCity.frag");
+    PixelationShader* pixelationShader = new PixelationShader("videoTextureShader.vert", "pixelation.frag");
+    videoSurface->setSharedShader(passthroughShader);
+    Texture* videoTexture = new Texture(source->getWidth(), source->getHeight());
+    passthroughShader->setTexture(videoTexture);
+    sinCityShader->setTexture(videoTexture);
+    pixelationShader->setTexture(videoTexture);
+    GpuTimer* gpuTimer = new GpuTimer(4);
+
+    cv::Mat capturedFrame;
+    cv::Mat resizedFrame;
+    cv::Mat flippedFrame;
+    cv::Mat processedFrame;
+    cv::Mat transformedFrame;
+    cv::Mat readbackFrame;
+    WarpEngine warpEngine;
+
+    vector<ScenarioResult> results;
+    vector<Scenario> scenarios = buildScenarios();
+    int totalGLErrors = 0;
+    bool budgetExceeded = false;
+
+    printf("%-28s %7s %9s %9s %9s %9s %9s %9s %9s %7s %10s\n", "Scenario", "Frames", "Capture", "Filter", "Transform",
+           "Upload", "Draw", "GPU", "p99 Total", "CPU", "Peak RSS");
+    for (const Scenario& scenario : scenarios) {
+        if (!scenarioFilter.empty() && scenario.name.find(scenarioFilter) == string::npos)
+            continue;
+
+        vector<double> samples[STAGE_COUNT];
+        for (int s = 0; s < STAGE_COUNT; s++)
+            samples[s].reserve(framesPerScenario);
+        int glErrors = 0;
+        double cpuStart = cpuSeconds();
+        auto wallStart = chrono::steady_clock::now();
+
+        for (int frameIndex = 0; frameIndex < framesPerScenario; frameIndex++) {
+            PipelineState state = { FilterType::NONE, false, 10, 0.0f, 0.0f, 0.0f, 1.0f, cv::Size(1280, 720) };
+            scenario.step(frameIndex, framesPerScenario, state);
+            double times[STAGE_COUNT] = { 0.0 };
+            auto frameStart = chrono::steady_clock::now();
+            auto stageStart = frameStart;
+            auto lap = [&stageStart](double& slot) {
+                auto now = chrono::steady_clock::now();
+                slot = chrono::duration<double, milli>(now - stageStart).count();
+                stageStart = now;
+            };
+
+            // --- Capture ---
+            cv::Mat frame;
+            if (synthetic != nullptr) {
+                if (synthetic->getWidth() != state.resolution.width || synthetic->getHeight() != state.resolution.height)
+                    synthetic->setSize(state.resolution.width, state.resolution.height);
+                synthetic->read(capturedFrame);
+                frame = capturedFrame;
+            } else {
+                if (replaySource != nullptr) {
+                    replaySource->read(capturedFrame);  // loops by itself
+                } else if (!fileSource->read(capturedFrame)) {
+                    // Loop the file, scenarios are longer than short clips
+                    fileSource->getCapture().set(cv::CAP_PROP_POS_FRAMES, 0);
+                    fileSource->read(capturedFrame);
+                }
+                frame = capturedFrame;
+                if (!frame.empty() && frame.size() != state.resolution) {
+                    cv::resize(frame, resizedFrame, state.resolution, 0, 0, cv::INTER_AREA);
+                    frame = resizedFrame;
+                }
+            }
+            if (frame.empty()) {
+                cerr << "Source delivered no frame, stopping" << endl;
+                break;
+            }
+            cv::flip(frame, flippedFrame, 0); // Flip for OpenGL coordinate system
+            frame = flippedFrame;
+            lap(times[CAPTURE]);
+
+            bool timed = gpuTimer->begin(frameIndex);
+            bool transformed = state.translateX != 0.0f || state.translateY != 0.0f ||
+                               state.rotateZ != 0.0f || state.scale != 1.0f;
+            if (state.cpu) {
+                // --- Filter, restricted to the part the warp maps on screen ---
+                float txPixels = state.translateX * frame.cols / 2.0f;
+                float tyPixels = -state.translateY * frame.rows / 2.0f;
+                cv::Rect visibleRect(0, 0, frame.cols, frame.rows);
+                if (transformed)
+                    visibleRect = Transformation::visibleSourceRect(frame.size(), txPixels, tyPixels, state.rotateZ, state.scale,
+                                                                    state.filter == FilterType::PIXELATION ? state.pixelSize : 1);
+                cv::Mat visibleFrame = frame(visibleRect);
+                switch (state.filter) {
+                    case FilterType::SINCITY:
+                        Filters::applySinCity(visibleFrame, processedFrame);
+                        break;
+                    case FilterType::PIXELATION:
+                        Filters::applyPixelation(visibleFrame, processedFrame, state.pixelSize);
+                        break;
+                    case FilterType::NONE:
+                    default:
+                        processedFrame = visibleFrame.clone();
+                        break;
+                }
+                lap(times[FILTER]);
+
+                // --- Transform ---
+                if (transformed) {
+                    cv::Mat transformMat = Transformation::buildTransformMatrix(txPixels, tyPixels, state.rotateZ, state.scale,
+                                                                                frame.cols / 2.0f, frame.rows / 2.0f);
+                    warpEngine.setAffine(transformMat, frame.size(), visibleRect.tl());
+                    warpEngine.apply(processedFrame, transformedFrame);
+                    frame = transformedFrame;
+                } else {
+                    frame = processedFrame;
+                }
+                lap(times[TRANSFORM]);
+            }
+
+            // --- Upload ---
+            videoTexture->update(frame.data, frame.cols, frame.rows, true);
+            lap(times[UPLOAD]);
+
+            // --- Draw, finished on the GPU before the stage ends ---
+            target->bind();
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            Shader* shader = passthroughShader;
+            if (!state.cpu) {
+                if (state.filter == FilterType::SINCITY) {
+                    shader = sinCityShader;
+                } else if (state.filter == FilterType::PIXELATION) {
+                    pixelationShader->setPixelSize((float)state.pixelSize);
+                    shader = pixelationShader;
+                }
+                videoSurface->setTranslate(glm::vec3(state.translateX, state.translateY, 0.0f));
+                videoSurface->setRotate(state.rotateZ);
+                videoSurface->setScale(state.scale);
+            } else {
+                videoSurface->setTranslate(glm::vec3(0.0f, 0.0f, 0.0f));
+                videoSurface->setRotate(0.0f);
+                videoSurface->setScale(1.0f);
+            }
+            shader->bind();
+            shader->updateMVP(videoSurface->getMVP(renderingCamera));
+            videoSurface->directRender();
+            if (timed)
+                gpuTimer->end();
+            glFinish();
+            lap(times[DRAW]);
+
+            // --- Readback ---
+            if (readback) {
+                readbackFrame.create(target->getHeight(), target->getWidth(), CV_8UC4);
+                target->readPixels(readbackFrame.data);
+                lap(times[READBACK]);
+            }
+            RenderTarget::unbind();
+            times[TOTAL] = chrono::duration<double, milli>(chrono::steady_clock::now() - frameStart).count();
+
+            // glFinish above makes the query result available right away
+            int tag;
+            double gpuMs;
+            while (gpuTimer->poll(tag, gpuMs))
+                samples[GPU].push_back(gpuMs);
+            for (int s = 0; s < STAGE_COUNT; s++)
+                if (s != GPU)
+                    samples[s].push_back(times[s]);
+
+            while (glGetError() != GL_NO_ERROR)
+                glErrors++;
+        }
+
+        ScenarioResult result;
+        result.name = scenario.name;
+        result.frames = (int)samples[TOTAL].size();
+        for (int s = 0; s < STAGE_COUNT; s++)
+            result.stages[s] = summarize(samples[s]);
+        result.wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+        double cpuUsed = cpuSeconds() - cpuStart;
+        result.cpuUtilization = cpuStart >= 0.0 && result.wallSeconds > 0.0 ? cpuUsed / result.wallSeconds : -1.0;
+        result.peakRssKB = peakRssKB();
+        result.glErrors = glErrors;
+        results.push_back(result);
+        totalGLErrors += glErrors;
+
+        printf("%-28s %7d %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %6.0f%% %8ld KB%s\n", result.name.c_str(), result.frames,
+               result.stages[CAPTURE].p50, result.stages[FILTER].p50, result.stages[TRANSFORM].p50,
+               result.stages[UPLOAD].p50, result.stages[DRAW].p50, result.stages[GPU].p50, result.stages[TOTAL].p99,
+               100.0 * result.cpuUtilization, result.peakRssKB, glErrors > 0 ? "  GL ERRORS" : "");
+        fflush(stdout);
+        if (maxP99 > 0.0 && result.stages[TOTAL].p99 > maxP99) {
+            cerr << scenario.name << ": p99 frame time " << result.stages[TOTAL].p99 << " ms exceeds " << maxP99 << " ms" << endl;
+            budgetExceeded = true;
+        }
+    }
+    cout << "Stage columns are medians in ms" << endl;
+
+    if (!jsonPath.empty())
+        writeJSON(jsonPath, results, renderer, sourceName, outputSize, readback);
+
+    // --- Cleanup ---
+    delete gpuTimer;
+    delete videoSurface;
+    delete passthroughShader;
+    delete sinCityShader;
+    delete pixelationShader;
+    delete videoTexture;
+    delete renderingCamera;
+    delete target;
+    glDeleteVertexArrays(1, &VertexArrayID);
+    glfwTerminate();
+    source->release();
+    delete source;
+
+    if (totalGLErrors > 0) {
+        cerr << totalGLErrors << " GL errors during the run" << endl;
+        return 2;
+    }
+    return budgetExceeded ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * shmConsumer.cpp
+ *
+ *  Sample consumer of the shared memory frame ring published by VC_2_app --shm name.
+ *  Works on every frame in place (a brightness mean over a sparse grid), then checks
+ *  that the writer did not overwrite the frame meanwhile. Any number of consumers can
+ *  attach to the same ring at once.
+ *
+ *  Usage: VC_2_shm_consumer name [frames]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <string>
+#include <chrono>
+#include <iostream>
+
+#include <common/SharedFrameReader.hpp>
+
+using namespace std;
+
+// Mean of the green channel (close to luma) over every 8th pixel of every 8th row
+static double sampleBrightness(const SharedFrameReader::Frame& frame) {
+    const int channels = (frame.type >> 3) + 1;    // OpenCV type code: depth in the low 3 bits
+    const int green = channels >= 3 ? 1 : 0;
+    unsigned long long sum = 0;
+    unsigned long long count = 0;
+    for (int y = 0; y < frame.height; y += 8) {
+        const unsigned char* row = frame.data + (size_t)y * frame.stride;
+        for (int x = 0; x < frame.width; x += 8) {
+            sum += row[x * channels + green];
+            count++;
+        }
+    }
+    return count > 0 ? (double)sum / count : 0.0;
+}
+
+static double steadySeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        cerr << "Usage: " << argv[0] << " name [frames]" << endl;
+        return -1;
+    }
+    const long long frameLimit = argc == 3 ? atoll(argv[2]) : 0;
+
+    SharedFrameReader reader;
+    if (!reader.open(argv[1]))
+        return -1;
+    cout << "Attached to " << sharedFrameObjectName(argv[1]) << " (writer pid " << reader.getWriterPid() << ")" << endl;
+
+    long long frames = 0;
+    long long torn = 0;
+    int intervalFrames = 0;
+    double intervalLatency = 0.0;
+    double brightness = 0.0;
+    double intervalStart = steadySeconds();
+    while (frameLimit <= 0 || frames < frameLimit) {
+        SharedFrameReader::Frame frame;
+        if (!reader.acquire(frame, 1000)) {
+            if (kill(reader.getWriterPid(), 0) != 0) {
+                cout << "Writer has exited" << endl;
+                break;
+            }
+            cout << "Waiting for frames..." << endl;
+            continue;
+        }
+        double value = sampleBrightness(frame);
+        if (!reader.isValid(frame)) {
+            // The writer lapped us while we were reading, the result is discarded
+            torn++;
+            continue;
+        }
+        brightness = value;
+        frames++;
+        intervalFrames++;
+        intervalLatency += steadySeconds() - frame.timestamp;
+
+        double now = steadySeconds();
+        if (now - intervalStart >= 1.0) {
+            cout << "Frame " << frame.number << ": " << frame.width << "x" << frame.height
+                 << (frame.flags & SHAREDFRAME_BOTTOM_UP ? " (bottom-up)" : "")
+                 << " | FPS: " << (int)(intervalFrames / (now - intervalStart))
+                 << " | Latency: " << 1000.0 * intervalLatency / intervalFrames << " ms"
+                 << " | Brightness: " << (int)brightness
+                 << " | Skipped: " << reader.getSkipped() << " | Torn: " << torn << endl;
+            intervalStart = now;
+            intervalFrames = 0;
+            intervalLatency = 0.0;
+        }
+    }
+    cout << frames << " frames read, " << reader.getSkipped() << " skipped, " << torn << " torn" << endl;
+    return 0;
+}
@@ -0,0 +1,58 @@
+#version 330 core
+in vec2 UV;
+out vec4 FragColor;
+
+uniform sampler2DArray historySampler;
+uniform int newestLayer;        // layer of the current frame
+uniform int frameCount;         // valid layers, at most ringSize
+uniform int ringSize;
+uniform int mode;               // 0 = denoise, 1 = motion, 2 = trails
+uniform float motionThreshold;
+uniform float trailDecay;
+
+// Frame that is age frames old, the ring wraps around
+vec3 frameAt(int age) {
+    int layer = newestLayer - age;
+    if (layer < 0)
+        layer += ringSize;
+    return texture(historySampler, vec3(UV, float(layer))).rgb;
+}
+
+void main() {
+    vec3 current = frameAt(0);
+    if (mode == 0) {
+        // Sensor noise is uncorrelated between frames, the mean keeps the scene
+        vec3 sum = current;
+        for (int age = 1; age < frameCount; age++)
+            sum += frameAt(age);
+        FragColor = vec4(sum / float(frameCount), 1.0);
+    } else if (mode == 1) {
+        // The mean of the older frames is the static background
+        vec3 background = current;
+        if (frameCount > 1) {
+            background = vec3(0.0);
+            for (int age = 1; age < frameCount; age++)
+                background += frameAt(age);
+            background /= float(frameCount - 1);
+        }
+        vec3 difference = abs(current - background);
+        if (max(difference.r, max(difference.g, difference.b)) > motionThreshold) {
+            FragColor = vec4(current, 1.0);
+        } else {
+            float gray = dot(current, vec3(0.299, 0.587, 0.114));
+            gray = step(0.5, clamp((gray - 0.5) * 1.5 + 0.5, 0.0, 1.0));
+            FragColor = vec4(vec3(gray), 1.0);
+        }
+    } else {
+        // Older frames fade out geometrically and leave ghosts behind moving objects
+        vec3 sum = current;
+        float weight = 1.0;
+        float total = 1.0;
+        for (int age = 1; age < frameCount; age++) {
+            weight *= trailDecay;
+            sum += frameAt(age) * weight;
+            total += weight;
+        }
+        FragColor = vec4(sum / total, 1.0);
+    }
+}
@@ -0,0 +1,16 @@
+#version 330 core
+in vec2 UV;
+out vec4 FragColor;
+
+uniform sampler2D myTextureSampler;
+uniform sampler2D distortionMap;    // source UV - pixel UV, precomputed from the calibration
+
+void main() {
+    vec2 source = UV + texture(distortionMap, UV).rg;
+    // Outside the camera image stays black, like the CPU remap border
+    if (any(lessThan(source, vec2(0.0))) || any(greaterThan(source, vec2(1.0)))) {
+        FragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+    FragColor = texture(myTextureSampler, source);
+}
@@ -0,0 +1,897 @@
+/*
+ * validateKernels.cpp
+ *
+ *  Checks the optimised CPU kernels (Filters, Transformation, WarpEngine, Undistortion, FrameFormat, BC1) against
+ *  straightforward scalar reference implementations on a corpus of synthetic frames and,
+ *  optionally, recorded images or videos. For every kernel the maximum absolute error, the PSNR
+ *  and the number of mismatching pixels are reported; each kernel has its own tolerance and the
+ *  exit code is 1 if any of them is exceeded.
+ *
+ *  --gpu additionally renders the GPU filters (Sin City, pixelation, colour LUT, blur, lens
+ *  correction, temporal denoise) offscreen, reads the result back and compares it with the CPU
+ *  path. Where the two compute something different by design (GPU pixelation samples the block
+ *  centre, the GPU denoise averages a window instead of decaying) the GPU is checked against a
+ *  reference of what its shader computes.
+ *
+ *  Usage: VC_2_validate [--gpu] [--input image|video]... [--verbose]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+
+// Expand the glad loader implementation exactly once, later includes only see the declarations
+#define GLAD_GL_IMPLEMENTATION
+#include <glad/gl.h>
+#undef GLAD_GL_IMPLEMENTATION
+
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <opencv2/opencv.hpp>
+
+#include <common/Quad.hpp>
+#include <common/Texture.hpp>
+#include <common/TextureShader.hpp>
+#include <common/PixelationShader.hpp>
+#include <common/LutShader.hpp>
+#include <common/TemporalShader.hpp>
+#include <common/RenderTarget.hpp>
+#include <common/GpuBlur.hpp>
+#include <common/GpuUndistort.hpp>
+#include <common/FrameHistory.hpp>
+#include <common/Filters.hpp>
+#include <common/ColorLUT.hpp>
+#include <common/TemporalFilter.hpp>
+#include <common/Transformation.hpp>
+#include <common/WarpEngine.hpp>
+#include <common/Undistortion.hpp>
+#include <common/FrameFormat.hpp>
+#include <common/BC1Encoder.hpp>
+#include <common/SyntheticFrameSource.hpp>
+
+using namespace std;
+
+struct Tolerance {
+    int pixelTolerance;         // a pixel mismatches if any channel differs by more than this
+    double maxMismatchRatio;    // allowed fraction of mismatching pixels
+    double minPSNR;             // dB, ignored when the images are identical
+};
+
+struct Frame {
+    string name;
+    cv::Mat bgr;
+};
+
+// Worst case of one kernel over the whole corpus
+struct KernelResult {
+    string name;
+    Tolerance tolerance;
+    string note;
+    int maxAbs;
+    double minPSNR;
+    long mismatches;
+    long pixels;
+    string worstFrame;
+    double worstRatio;      // mismatch fraction of worstFrame
+    bool failed;
+};
+
+/* ------------------------------------------------------------------------- */
+/* Scalar references                                                          */
+/* ------------------------------------------------------------------------- */
+
+// Per-pixel Sin City exactly as specified in Filters.hpp, one pixel at a time
+static void referenceSinCity(const cv::Mat& input, cv::Mat& output) {
+    output.create(input.size(), CV_8UC3);
+    for (int y = 0; y < input.rows; y++) {
+        for (int x = 0; x < input.cols; x++) {
+            cv::Vec3b p = input.at<cv::Vec3b>(y, x);
+            float b = p[0] / 255.0f, g = p[1] / 255.0f, r = p[2] / 255.0f;
+            float gray = 0.299f * r + 0.587f * g + 0.114f * b;
+            if (r - std::max(g, b) > 0.2f && r > 0.3f) {
+                output.at<cv::Vec3b>(y, x) = cv::Vec3b(cv::saturate_cast<uchar>(b * 0.3f * 255),
+                                                       cv::saturate_cast<uchar>(g * 0.3f * 255),
+                                                       cv::saturate_cast<uchar>(r * 1.2f * 255));
+            } else {
+                gray = std::max(0.0f, std::min(1.0f, (gray - 0.5f) * 1.5f + 0.5f));
+                uchar v = gray >= 0.5f ? 255 : 0;
+                output.at<cv::Vec3b>(y, x) = cv::Vec3b(v, v, v);
+            }
+        }
+    }
+}
+
+// Block average, blocks anchored at the top left corner, cut blocks at the right and bottom edge
+static void referencePixelation(const cv::Mat& input, cv::Mat& output, int pixelSize) {
+    output.create(input.size(), CV_8UC3);
+    for (int by = 0; by < input.rows; by += pixelSize) {
+        for (int bx = 0; bx < input.cols; bx += pixelSize) {
+            int h = std::min(pixelSize, input.rows - by);
+            int w = std::min(pixelSize, input.cols - bx);
+            double sum[3] = { 0.0, 0.0, 0.0 };
+            for (int y = by; y < by + h; y++)
+                for (int x = bx; x < bx + w; x++)
+                    for (int c = 0; c < 3; c++)
+                        sum[c] += input.at<cv::Vec3b>(y, x)[c];
+            cv::Vec3b mean;
+            for (int c = 0; c < 3; c++)
+                mean[c] = cv::saturate_cast<uchar>(sum[c] / (w * h));
+            for (int y = by; y < by + h; y++)
+                for (int x = bx; x < bx + w; x++)
+                    output.at<cv::Vec3b>(y, x) = mean;
+        }
+    }
+}
+
+// What pixelation.frag computes: blocks anchored at the bottom left (the texture is flipped) and one
+// bilinear sample at the block centre, which for even block sizes falls between two texels.
+// The texture repeats, so centres of cut blocks past the edge wrap around.
+static void referencePixelationCentre(const cv::Mat& input, cv::Mat& output, int pixelSize) {
+    cv::Mat flipped, result(input.size(), CV_8UC3);
+    cv::flip(input, flipped, 0);
+    const int half = pixelSize / 2;
+    for (int y = 0; y < flipped.rows; y++) {
+        int y0 = y / pixelSize * pixelSize + half - 1;
+        int rows[2] = { y0 % flipped.rows, (y0 + 1) % flipped.rows };
+        for (int x = 0; x < flipped.cols; x++) {
+            int x0 = x / pixelSize * pixelSize + half - 1;
+            int cols[2] = { x0 % flipped.cols, (x0 + 1) % flipped.cols };
+            for (int c = 0; c < 3; c++) {
+                int sum = 0;
+                for (int j = 0; j < 2; j++)
+                    for (int i = 0; i < 2; i++)
+                        sum += flipped.at<cv::Vec3b>(rows[j], cols[i])[c];
+                result.at<cv::Vec3b>(y, x)[c] = (uchar)((sum + 2) / 4);
+            }
+        }
+    }
+    cv::flip(result, output, 0);
+}
+
+// Inverse mapping with bilinear interpolation in double precision, black outside the source
+// With a lens the warped position is in the undistorted frame and is distorted before sampling
+static void referenceWarp(const cv::Mat& input, cv::Mat& output, float tx, float ty, float angleDegrees, float scale,
+                          const Undistortion::Model* lens = nullptr) {
+    cv::Mat forward;
+    Transformation::buildTransformMatrix(tx, ty, angleDegrees, scale, input.cols / 2.0f, input.rows / 2.0f)
+        .convertTo(forward, CV_64F);   // built as CV_32F
+    double m[6];
+    for (int i = 0; i < 6; i++)
+        m[i] = forward.at<double>(i / 3, i % 3);
+    double det = m[0] * m[4] - m[1] * m[3];
+    double inv[6] = { m[4] / det, -m[1] / det, 0.0, -m[3] / det, m[0] / det, 0.0 };
+    inv[2] = -(inv[0] * m[2] + inv[1] * m[5]);
+    inv[5] = -(inv[3] * m[2] + inv[4] * m[5]);
+
+    output.create(input.size(), CV_8UC3);
+    for (int y = 0; y < output.rows; y++) {
+        for (int x = 0; x < output.cols; x++) {
+            double sx = inv[0] * x + inv[1] * y + inv[2];
+            double sy = inv[3] * x + inv[4] * y + inv[5];
+            if (lens != nullptr) {
+                cv::Point2d distorted = lens->distort(sx, sy);
+                sx = distorted.x;
+                sy = distorted.y;
+            }
+            int x0 = (int)std::floor(sx), y0 = (int)std::floor(sy);
+            double fx = sx - x0, fy = sy - y0;
+            double value[3] = { 0.0, 0.0, 0.0 };
+            for (int k = 0; k < 4; k++) {
+                int px = x0 + (k & 1), py = y0 + (k >> 1);
+                if (px < 0 || py < 0 || px >= input.cols || py >= input.rows)
+                    continue;
+                double weight = ((k & 1) ? fx : 1.0 - fx) * ((k >> 1) ? fy : 1.0 - fy);
+                cv::Vec3b p = input.at<cv::Vec3b>(py, px);
+                for (int c = 0; c < 3; c++)
+                    value[c] += weight * p[c];
+            }
+            output.at<cv::Vec3b>(y, x) = cv::Vec3b(cv::saturate_cast<uchar>(value[0]), cv::saturate_cast<uchar>(value[1]),
+                                                   cv::saturate_cast<uchar>(value[2]));
+        }
+    }
+}
+
+// Tetrahedral interpolation in double precision on the float table
+static void referenceColorLUT(const cv::Mat& input, cv::Mat& output, const ColorLUT& lut) {
+    const int n = lut.getSize();
+    const vector<float>& table = lut.getTable();
+    output.create(input.size(), CV_8UC3);
+    for (int y = 0; y < input.rows; y++) {
+        for (int x = 0; x < input.cols; x++) {
+            cv::Vec3b p = input.at<cv::Vec3b>(y, x);
+            double position[3] = { p[2] * (n - 1) / 255.0, p[1] * (n - 1) / 255.0, p[0] * (n - 1) / 255.0 };
+            int corner[3];
+            double f[3];
+            for (int a = 0; a < 3; a++) {
+                corner[a] = std::min((int)position[a], n - 2);
+                f[a] = position[a] - corner[a];
+            }
+            // Step along the axes in order of decreasing fraction
+            int order[3] = { 0, 1, 2 };
+            std::sort(order, order + 3, [&f](int a, int b) { return f[a] > f[b]; });
+            double weights[4] = { 1.0 - f[order[0]], f[order[0]] - f[order[1]], f[order[1]] - f[order[2]], f[order[2]] };
+            double value[3] = { 0.0, 0.0, 0.0 };
+            for (int k = 0; k < 4; k++) {
+                if (k > 0)
+                    corner[order[k - 1]]++;
+                size_t index = (((size_t)corner[2] * n + corner[1]) * n + corner[0]) * 3;
+                for (int c = 0; c < 3; c++)
+                    value[c] += weights[k] * std::max(0.0f, std::min(1.0f, table[index + c]));
+            }
+            output.at<cv::Vec3b>(y, x) = cv::Vec3b(cv::saturate_cast<uchar>(value[2] * 255.0),
+                                                   cv::saturate_cast<uchar>(value[1] * 255.0),
+                                                   cv::saturate_cast<uchar>(value[0] * 255.0));
+        }
+    }
+}
+
+// Exponential running average in double precision over a noisy sequence of the frame,
+// weight 1/4 (what TemporalFilter picks for eight frames)
+static void referenceTemporalAverage(const vector<cv::Mat>& sequence, cv::Mat& output) {
+    cv::Mat average;
+    sequence[0].convertTo(average, CV_64F);
+    for (size_t i = 1; i < sequence.size(); i++) {
+        cv::Mat value;
+        sequence[i].convertTo(value, CV_64F);
+        cv::addWeighted(average, 0.75, value, 0.25, 0.0, average);
+    }
+    average.convertTo(output, CV_8U);
+}
+
+// Plain mean of the last frames in double precision, what temporal.frag computes in denoise mode
+static void referenceWindowMean(const vector<cv::Mat>& frames, cv::Mat& output) {
+    cv::Mat sum;
+    frames[0].convertTo(sum, CV_64F);
+    for (size_t i = 1; i < frames.size(); i++) {
+        cv::Mat value;
+        frames[i].convertTo(value, CV_64F);
+        sum += value;
+    }
+    sum.convertTo(output, CV_8U, 1.0 / frames.size());
+}
+
+// The frame with a different noise pattern per step, like sensor noise on a static scene
+static vector<cv::Mat> noisySequence(const cv::Mat& bgr, int length) {
+    vector<cv::Mat> sequence;
+    cv::RNG rng(4711);
+    for (int i = 0; i < length; i++) {
+        cv::Mat noise(bgr.size(), CV_16SC3);
+        rng.fill(noise, cv::RNG::NORMAL, 0, 8);
+        cv::Mat noisy;
+        cv::add(bgr, noise, noisy, cv::Mat(), CV_8U);
+        sequence.push_back(noisy);
+    }
+    return sequence;
+}
+
+// Gamma, lift and channel crosstalk: smooth, so a table reproduces it up to interpolation error
+static cv::Vec3f smoothGrade(float r, float g, float b) {
+    return cv::Vec3f(std::pow(r, 0.8f), 0.9f * g + 0.05f + 0.1f * r * b, 0.7f * b + 0.2f * g);
+}
+
+// Branch of the Sin City math for a colour: 2 = red, 1 = white, 0 = black
+static int sinCityBranch(float r, float g, float b) {
+    if (r - std::max(g, b) > 0.2f && r > 0.3f)
+        return 2;
+    float gray = 0.299f * r + 0.587f * g + 0.114f * b;
+    gray = std::max(0.0f, std::min(1.0f, (gray - 0.5f) * 1.5f + 0.5f));
+    return gray >= 0.5f ? 1 : 0;
+}
+
+// Pixels whose table cell has corners in different Sin City branches: the table can only blend the
+// two sides of the threshold there, everywhere else it must match up to quantisation
+static void sinCityThresholdCells(const cv::Mat& bgr, int size, cv::Mat& mask) {
+    mask.create(bgr.size(), CV_8U);
+    const float step = 1.0f / (size - 1);
+    for (int y = 0; y < bgr.rows; y++) {
+        for (int x = 0; x < bgr.cols; x++) {
+            cv::Vec3b p = bgr.at<cv::Vec3b>(y, x);
+            int cell[3];
+            for (int c = 0; c < 3; c++)
+                cell[c] = std::min(p[2 - c] * (size - 1) / 255, size - 2);
+            int first = -1;
+            bool straddles = false;
+            for (int k = 0; k < 8 && !straddles; k++) {
+                int branch = sinCityBranch((cell[0] + (k & 1)) * step, (cell[1] + ((k >> 1) & 1)) * step,
+                                           (cell[2] + (k >> 2)) * step);
+                if (first < 0)
+                    first = branch;
+                straddles = branch != first;
+            }
+            mask.at<uchar>(y, x) = straddles ? 255 : 0;
+        }
+    }
+}
+
+// Strong barrel distortion of a wide-angle camera, calibrated at the frame size
+static void syntheticLens(cv::Size size, Undistortion& lens) {
+    double camera[9] = { 0.8 * size.width, 0.0, size.width / 2.0,
+                         0.0, 0.8 * size.width, size.height / 2.0,
+                         0.0, 0.0, 1.0 };
+    double coefficients[5] = { -0.25, 0.08, 0.001, -0.0005, 0.0 };
+    lens.setCalibration(cv::Mat(3, 3, CV_64F, camera), cv::Mat(1, 5, CV_64F, coefficients), size);
+}
+
+static void referenceBGRA(const cv::Mat& input, cv::Mat& output, bool flipVertical) {
+    output.create(input.size(), CV_8UC4);
+    for (int y = 0; y < input.rows; y++) {
+        int sy = flipVertical ? input.rows - 1 - y : y;
+        for (int x = 0; x < input.cols; x++) {
+            cv::Vec3b p = input.at<cv::Vec3b>(sy, x);
+            output.at<cv::Vec4b>(y, x) = cv::Vec4b(p[0], p[1], p[2], 255);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Comparison                                                                 */
+/* ------------------------------------------------------------------------- */
+
+static void compare(const cv::Mat& expected, const cv::Mat& actual, const string& frameName, KernelResult& result) {
+    if (expected.size() != actual.size() || expected.type() != actual.type()) {
+        cerr << result.name << " on " << frameName << ": output is " << actual.cols << "x" << actual.rows
+             << " type " << actual.type() << ", expected " << expected.cols << "x" << expected.rows
+             << " type " << expected.type() << endl;
+        result.failed = true;
+        return;
+    }
+    cv::Mat diff;
+    cv::absdiff(expected, actual, diff);
+    // Largest channel difference per pixel
+    vector<cv::Mat> channels;
+    cv::split(diff, channels);
+    cv::Mat pixelDiff = channels[0].clone();
+    for (size_t c = 1; c < channels.size(); c++)
+        cv::max(pixelDiff, channels[c], pixelDiff);
+
+    double maxAbs = 0.0;
+    cv::minMaxLoc(pixelDiff, nullptr, &maxAbs);
+    cv::Mat mismatchMask;
+    cv::compare(pixelDiff, result.tolerance.pixelTolerance, mismatchMask, cv::CMP_GT);
+    long mismatches = (long)cv::countNonZero(mismatchMask);
+    double psnr = maxAbs > 0.0 ? cv::PSNR(expected, actual) : 1.0e9;
+
+    double ratio = (double)mismatches / expected.total();
+    if (ratio > result.worstRatio) {
+        result.worstRatio = ratio;
+        result.worstFrame = frameName;
+    }
+    result.maxAbs = std::max(result.maxAbs, (int)maxAbs);
+    result.minPSNR = std::min(result.minPSNR, psnr);
+    result.mismatches += mismatches;
+    result.pixels += (long)expected.total();
+}
+
+static void finish(KernelResult& result) {
+    double ratio = result.pixels > 0 ? (double)result.mismatches / result.pixels : 0.0;
+    if (ratio > result.tolerance.maxMismatchRatio)
+        result.failed = true;
+    if (result.maxAbs > 0 && result.minPSNR < result.tolerance.minPSNR)
+        result.failed = true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Corpus                                                                     */
+/* ------------------------------------------------------------------------- */
+
+static vector<Frame> buildCorpus(const vector<string>& inputs) {
+    vector<Frame> corpus;
+    const cv::Size sizes[4] = { cv::Size(1280, 720), cv::Size(640, 480), cv::Size(637, 479), cv::Size(1920, 1080) };
+    for (const cv::Size& size : sizes) {
+        SyntheticFrameSource source(size.width, size.height);
+        cv::Mat frame;
+        for (int i = 0; i < 38; i++)
+            source.read(frame);  // a scrolled frame, not the aligned start of the pattern
+        corpus.push_back({ "synthetic_" + to_string(size.width) + "x" + to_string(size.height), frame.clone() });
+    }
+
+    // Uniform noise: every pixel is an edge
+    cv::Mat noise(240, 320, CV_8UC3);
+    cv::RNG rng(4242);
+    rng.fill(noise, cv::RNG::UNIFORM, 0, 256);
+    corpus.push_back({ "noise_320x240", noise });
+
+    // Red against green over the full range, crosses the Sin City red and gray thresholds
+    cv::Mat sweep(256, 256, CV_8UC3);
+    for (int y = 0; y < 256; y++)
+        for (int x = 0; x < 256; x++)
+            sweep.at<cv::Vec3b>(y, x) = cv::Vec3b((uchar)((x + y) / 4), (uchar)y, (uchar)x);
+    corpus.push_back({ "threshold_sweep_256x256", sweep });
+
+    for (const string& path : inputs) {
+        cv::Mat image = cv::imread(path, cv::IMREAD_COLOR);
+        if (!image.empty()) {
+            corpus.push_back({ path, image });
+            continue;
+        }
+        cv::VideoCapture video(path);
+        if (!video.isOpened()) {
+            cerr << "Could not read " << path << ", skipping" << endl;
+            continue;
+        }
+        // A few frames spread over the first seconds
+        cv::Mat frame;
+        for (int i = 0; i < 5 * 15 && video.read(frame); i++)
+            if (i % 15 == 0)
+                corpus.push_back({ path + "#" + to_string(i), frame.clone() });
+    }
+    return corpus;
+}
+
+// Tiles of the incremental CPU mode, aligned to the pixelation block size
+static vector<cv::Rect> tileGrid(cv::Size size, int tile) {
+    vector<cv::Rect> tiles;
+    for (int y = 0; y < size.height; y += tile)
+        for (int x = 0; x < size.width; x += tile)
+            tiles.push_back(cv::Rect(x, y, tile, tile) & cv::Rect(0, 0, size.width, size.height));
+    return tiles;
+}
+
+/* ------------------------------------------------------------------------- */
+/* GPU readback                                                               */
+/* ------------------------------------------------------------------------- */
+
+struct GpuContext {
+    GLFWwindow* window;
+    GLuint vertexArrayID;
+    Quad* quad;
+    Texture* texture;
+    TextureShader* passthroughShader;
+    TextureShader* sinCityShader;
+    PixelationShader* pixelationShader;
+    LutShader* lutShader;
+    TemporalShader* temporalShader;
+    FrameHistory* history;
+    GpuBlur* blur;
+    GpuUndistort* undistort;
+    RenderTarget* target;
+};
+
+static bool initGpu(GpuContext& gpu) {
+    if (!glfwInit()) {
+        fprintf(stderr, "Failed to initialize GLFW\n");
+        return false;
+    }
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    gpu.window = glfwCreateWindow(64, 64, "VC_2_validate", NULL, NULL);
+    if (gpu.window == NULL) {
+        fprintf(stderr, "Failed to open GLFW window.\n");
+        glfwTerminate();
+        return false;
+    }
+    glfwMakeContextCurrent(gpu.window);
+    if (gladLoadGL(glfwGetProcAddress) == 0) {
+        fprintf(stderr, "Failed to initialize OpenGL context (GLAD)\n");
+        glfwTerminate();
+        return false;
+    }
+    cout << "GPU: " << (const char*)glGetString(GL_RENDERER) << endl;
+    glGenVertexArrays(1, &gpu.vertexArrayID);
+    glBindVertexArray(gpu.vertexArrayID);
+    glDisable(GL_DEPTH_TEST);
+
+    // Same UV mapping as the app (aspect 1.777 in videoTextureShader.vert), scaled to fill the viewport
+    gpu.quad = new Quad(1.777f);
+    gpu.texture = new Texture(16, 16);
+    gpu.passthroughShader = new TextureShader("videoTextureShader.vert", "videoTextureShader.frag");
+    gpu.sinCityShader = new TextureShader("videoTextureShader.vert", "sinCity.frag");
+    gpu.pixelationShader = new PixelationShader("videoTextureShader.vert", "pixelation.frag");
+    gpu.lutShader = new LutShader("videoTextureShader.vert", "colorLUT.frag");
+    gpu.passthroughShader->setTexture(gpu.texture);
+    gpu.sinCityShader->setTexture(gpu.texture);
+    gpu.pixelationShader->setTexture(gpu.texture);
+    gpu.lutShader->setTexture(gpu.texture);
+    gpu.history = new FrameHistory(8);
+    gpu.temporalShader = new TemporalShader("videoTextureShader.vert", "temporal.frag");
+    gpu.temporalShader->setHistory(gpu.history);
+    gpu.temporalShader->setMode(TemporalShader::DENOISE);
+    gpu.blur = new GpuBlur();
+    gpu.undistort = new GpuUndistort();
+    gpu.target = new RenderTarget(16, 16, false);
+    return true;
+}
+
+static void releaseGpu(GpuContext& gpu) {
+    delete gpu.target;
+    delete gpu.passthroughShader;
+    delete gpu.sinCityShader;
+    delete gpu.pixelationShader;
+    delete gpu.lutShader;
+    delete gpu.temporalShader;
+    delete gpu.history;
+    delete gpu.blur;
+    delete gpu.undistort;
+    delete gpu.texture;
+    delete gpu.quad;
+    glDeleteVertexArrays(1, &gpu.vertexArrayID);
+    glfwTerminate();
+}
+
+// Upload like the app: flipped, bottom row first
+static void uploadGpu(GpuContext& gpu, const cv::Mat& bgr) {
+    cv::Mat flipped;
+    cv::flip(bgr, flipped, 0);
+    gpu.texture->update(flipped.data, flipped.cols, flipped.rows, true);
+}
+
+// Draw one fragment per texel of a frame of the given size and read back in image orientation
+static void drawGpu(GpuContext& gpu, Shader* shader, cv::Size size, cv::Mat& output) {
+    cv::Mat readback, bgrFlipped;
+    gpu.target->resize(size.width, size.height);
+    gpu.target->bind();
+    glClear(GL_COLOR_BUFFER_BIT);
+    shader->bind();
+    shader->updateMVP(glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / 1.777f, 1.0f, 1.0f)));
+    gpu.quad->directRender();
+    readback.create(size.height, size.width, CV_8UC4);
+    gpu.target->readPixels(readback.data);
+    RenderTarget::unbind();
+    cv::cvtColor(readback, bgrFlipped, cv::COLOR_BGRA2BGR);
+    cv::flip(bgrFlipped, output, 0);
+}
+
+static void renderGpu(GpuContext& gpu, Shader* shader, const cv::Mat& bgr, cv::Mat& output) {
+    uploadGpu(gpu, bgr);
+    drawGpu(gpu, shader, bgr.size(), output);
+}
+
+/* ------------------------------------------------------------------------- */
+/* main                                                                      */
+/* ------------------------------------------------------------------------- */
+int main(int argc, char** argv) {
+    bool gpuMode = false;
+    bool verbose = false;
+    vector<string> inputs;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--gpu") {
+            gpuMode = true;
+        } else if (arg == "--input" && i + 1 < argc) {
+            inputs.push_back(argv[++i]);
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else {
+            cerr << "Usage: " << argv[0] << " [--gpu] [--input image|video]... [--verbose]" << endl;
+            return -1;
+        }
+    }
+
+    vector<Frame> corpus = buildCorpus(inputs);
+    cout << "Corpus: " << corpus.size() << " frames" << endl;
+
+    // Each check produces expected and actual output for one frame, both CV_8UC3 or both CV_8UC4
+    struct Check {
+        string name;
+        Tolerance tolerance;
+        string note;
+        function<void(const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual)> run;
+    };
+    const Tolerance exact = { 0, 0.0, 0.0 };
+    // Float thresholds may flip for a handful of pixels sitting exactly on them
+    const Tolerance threshold = { 1, 1e-4, 40.0 };
+    // Fixed-point interpolation weights (1/32 steps) against double precision
+    const Tolerance interpolation = { 2, 1e-3, 40.0 };
+    const float tx = 37.5f, ty = -21.25f, angle = 17.0f, scale = 1.35f;
+
+    vector<Check> checks;
+    checks.push_back({ "Filters::applySinCity/bgr", threshold, "", [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        referenceSinCity(bgr, expected);
+        Filters::applySinCity(bgr, actual);
+    } });
+    checks.push_back({ "Filters::applySinCity/bgra", threshold, "", [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        cv::Mat bgra, output;
+        referenceSinCity(bgr, expected);
+        FrameFormat::bgrToBGRA(bgr, bgra);
+        Filters::applySinCity(bgra, output);
+        cv::cvtColor(output, actual, cv::COLOR_BGRA2BGR);
+    } });
+    checks.push_back({ "Filters::applySinCity/regions", threshold, "", [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        referenceSinCity(bgr, expected);
+        Filters::applySinCity(bgr, actual, tileGrid(bgr.size(), 32));
+    } });
+    // A smooth grade at both common table sizes
+    for (int size : { 33, 65 }) {
+        ColorLUT grade;
+        grade.bake(size, smoothGrade);
+        string suffix = "/size:" + to_string(size);
+        // 8-bit table entries and 1/256 weights against double precision
+        checks.push_back({ "Filters::applyColorLUT" + suffix + "/bgr", { 1, 1e-3, 45.0 }, "",
+                           [grade](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            referenceColorLUT(bgr, expected, grade);
+            Filters::applyColorLUT(bgr, actual, grade);
+        } });
+        checks.push_back({ "Filters::applyColorLUT" + suffix + "/bgra", { 1, 1e-3, 45.0 }, "",
+                           [grade](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            cv::Mat bgra, output;
+            referenceColorLUT(bgr, expected, grade);
+            FrameFormat::bgrToBGRA(bgr, bgra);
+            Filters::applyColorLUT(bgra, output, grade);
+            cv::cvtColor(output, actual, cv::COLOR_BGRA2BGR);
+        } });
+    }
+    // Cells across a threshold blend black, white and red by design and are taken from the
+    // reference; everywhere else the table must reproduce the filter up to quantisation
+    checks.push_back({ "ColorLUT::sinCity vs Filters::applySinCity", { 3, 1e-3, 40.0 }, "threshold cells excluded",
+                       [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        static const ColorLUT table = ColorLUT::sinCity();
+        cv::Mat thresholdCells;
+        referenceSinCity(bgr, expected);
+        Filters::applyColorLUT(bgr, actual, table);
+        sinCityThresholdCells(bgr, table.getSize(), thresholdCells);
+        expected.copyTo(actual, thresholdCells);
+    } });
+    // 8.7 fixed point with truncating shifts against double precision
+    checks.push_back({ "TemporalFilter::apply/denoise/bgr", interpolation, "", [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        vector<cv::Mat> sequence = noisySequence(bgr, 12);
+        referenceTemporalAverage(sequence, expected);
+        TemporalFilter filter;
+        filter.setHistoryLength(8);
+        for (const cv::Mat& frame : sequence)
+            filter.apply(frame, actual, TemporalFilter::DENOISE);
+    } });
+    checks.push_back({ "TemporalFilter::apply/denoise/bgra", interpolation, "", [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        vector<cv::Mat> sequence = noisySequence(bgr, 12);
+        referenceTemporalAverage(sequence, expected);
+        TemporalFilter filter;
+        filter.setHistoryLength(8);
+        cv::Mat bgra, output;
+        for (const cv::Mat& frame : sequence) {
+            FrameFormat::bgrToBGRA(frame, bgra);
+            filter.apply(bgra, output, TemporalFilter::DENOISE);
+        }
+        cv::cvtColor(output, actual, cv::COLOR_BGRA2BGR);
+    } });
+    for (int block : { 4, 10, 32 }) {
+        string suffix = "/block:" + to_string(block);
+        checks.push_back({ "Filters::applyPixelation" + suffix + "/bgr", exact, "",
+                           [block](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            referencePixelation(bgr, expected, block);
+            Filters::applyPixelation(bgr, actual, block);
+        } });
+        checks.push_back({ "Filters::applyPixelation" + suffix + "/bgra", exact, "",
+                           [block](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            cv::Mat bgra, output;
+            referencePixelation(bgr, expected, block);
+            FrameFormat::bgrToBGRA(bgr, bgra);
+            Filters::applyPixelation(bgra, output, block);
+            cv::cvtColor(output, actual, cv::COLOR_BGRA2BGR);
+        } });
+        checks.push_back({ "Filters::applyPixelation" + suffix + "/regions", exact, "",
+                           [block](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            referencePixelation(bgr, expected, block);
+            Filters::applyPixelation(bgr, actual, tileGrid(bgr.size(), block * std::max(1, 32 / block)), block);
+        } });
+    }
+    for (int radius : { 1, 7, 40 }) {
+        checks.push_back({ "Filters::applyBoxBlur/radius:" + to_string(radius), { 1, 0.0, 45.0 }, "",
+                           [radius](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            cv::blur(bgr, expected, cv::Size(2 * radius + 1, 2 * radius + 1), cv::Point(-1, -1), cv::BORDER_REPLICATE);
+            Filters::applyBoxBlur(bgr, actual, radius);
+        } });
+    }
+    for (float sigma : { 1.5f, 6.0f }) {
+        checks.push_back({ "Filters::applyGaussianBlur/sigma:" + to_string((int)sigma), { 8, 0.02, 32.0 },
+                           "three-box approximation", [sigma](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            cv::GaussianBlur(bgr, expected, cv::Size(), sigma, sigma, cv::BORDER_REPLICATE);
+            Filters::applyGaussianBlur(bgr, actual, sigma);
+        } });
+    }
+    checks.push_back({ "FrameFormat::bgrToBGRA/flip", exact, "", [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        referenceBGRA(bgr, expected, true);
+        FrameFormat::bgrToBGRA(bgr, actual, true);
+    } });
+    checks.push_back({ "Transformation::applyCombinedTransform", interpolation, "",
+                       [=](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        referenceWarp(bgr, expected, tx, ty, angle, scale);
+        Transformation::applyCombinedTransform(bgr, actual, tx, ty, angle, scale);
+    } });
+    checks.push_back({ "WarpEngine::apply", interpolation, "", [=](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        referenceWarp(bgr, expected, tx, ty, angle, scale);
+        WarpEngine engine;
+        engine.setAffine(Transformation::buildTransformMatrix(tx, ty, angle, scale, bgr.cols / 2.0f, bgr.rows / 2.0f), bgr.size());
+        engine.apply(bgr, actual);
+    } });
+    checks.push_back({ "Undistortion::apply", interpolation, "", [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        Undistortion lens;
+        syntheticLens(bgr.size(), lens);
+        Undistortion::Model model = lens.model(bgr.size());
+        referenceWarp(bgr, expected, 0.0f, 0.0f, 0.0f, 1.0f, &model);
+        lens.apply(bgr, actual);
+    } });
+    // The app corrects frames after the OpenGL flip with a mirrored calibration
+    checks.push_back({ "Undistortion::apply/flipped", interpolation, "", [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        Undistortion lens;
+        syntheticLens(bgr.size(), lens);
+        cv::Mat corrected, flipped;
+        lens.apply(bgr, corrected);
+        cv::flip(corrected, expected, 0);
+        lens.setFlipped(true);
+        cv::flip(bgr, flipped, 0);
+        lens.apply(flipped, actual);
+    } });
+    checks.push_back({ "WarpEngine::apply/lens", interpolation, "", [=](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        Undistortion lens;
+        syntheticLens(bgr.size(), lens);
+        Undistortion::Model model = lens.model(bgr.size());
+        referenceWarp(bgr, expected, tx, ty, angle, scale, &model);
+        WarpEngine engine;
+        engine.setAffine(Transformation::buildTransformMatrix(tx, ty, angle, scale, bgr.cols / 2.0f, bgr.rows / 2.0f), bgr.size());
+        engine.setLens(&lens, bgr.size());
+        engine.apply(bgr, actual);
+    } });
+    // The fast paths of the app against the plain full frame pipeline
+    checks.push_back({ "Undistortion::apply/region", exact, "", [=](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        Undistortion lens;
+        syntheticLens(bgr.size(), lens);
+        cv::Mat corrected;
+        lens.apply(bgr, corrected);
+        cv::Rect visible = Transformation::visibleSourceRect(bgr.size(), tx, ty, angle, 3.0f, 1);
+        expected = corrected(visible).clone();
+        lens.apply(bgr, actual, visible);
+    } });
+    // Incremental update of a zoomed, rotated warp: only a few tiles change between two frames,
+    // and the margin around their footprint must cover every output pixel they influence
+    checks.push_back({ "Transformation::applyCombinedTransform/regions", { 1, 1e-3, 45.0 }, "zoom 4, 45 deg",
+                       [=](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        const float zoom = 4.0f, rotation = 45.0f;
+        vector<cv::Rect> tiles = tileGrid(bgr.size(), 32), changed;
+        cv::Mat previous = bgr.clone();
+        for (size_t i = tiles.size() / 3; i < tiles.size(); i += 7) {
+            cv::Mat tile = previous(tiles[i]);
+            cv::bitwise_not(bgr(tiles[i]), tile);
+            changed.push_back(tiles[i]);
+        }
+        Transformation::applyCombinedTransform(previous, actual, tx / 8, ty / 8, rotation, zoom);
+        vector<cv::Rect> written;
+        Transformation::applyCombinedTransform(bgr, actual, changed, written, tx / 8, ty / 8, rotation, zoom);
+        Transformation::applyCombinedTransform(bgr, expected, tx / 8, ty / 8, rotation, zoom);
+    } });
+    checks.push_back({ "visible region pixelation + warp", { 1, 1e-3, 45.0 }, "",
+                       [=](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        const int block = 10;
+        const float zoom = 3.0f;
+        cv::Mat filtered;
+        Filters::applyPixelation(bgr, filtered, block);
+        Transformation::applyCombinedTransform(filtered, expected, tx, ty, angle, zoom);
+        cv::Rect visible = Transformation::visibleSourceRect(bgr.size(), tx, ty, angle, zoom, block);
+        cv::Mat croppedFiltered;
+        Filters::applyPixelation(bgr(visible), croppedFiltered, block);
+        Transformation::applyCombinedTransform(croppedFiltered, actual, visible, bgr.size(), tx, ty, angle, zoom);
+    } });
+    // Lossy by design, guards against encoder regressions
+    checks.push_back({ "BC1Encoder round trip", { 255, 1.0, 24.0 }, "lossy", [](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+        vector<unsigned char> blocks;
+        BC1Encoder::encode(bgr, blocks);
+        BC1Encoder::decode(blocks, bgr.cols, bgr.rows, actual);
+        expected = bgr;
+    } });
+
+    GpuContext gpu;
+    if (gpuMode) {
+        if (!initGpu(gpu))
+            return -1;
+        checks.push_back({ "GPU passthrough", { 1, 1e-4, 45.0 }, "", [&gpu](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            expected = bgr;
+            renderGpu(gpu, gpu.passthroughShader, bgr, actual);
+        } });
+        checks.push_back({ "GPU sinCity.frag vs CPU", { 1, 1e-3, 35.0 }, "", [&gpu](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            Filters::applySinCity(bgr, expected);
+            renderGpu(gpu, gpu.sinCityShader, bgr, actual);
+        } });
+        // The shader samples the block centre where the CPU averages the block, so it is checked
+        // against its own reference; block average vs centre sample is not a meaningful bound
+        checks.push_back({ "GPU pixelation.frag vs centre sample", { 1, 1e-3, 40.0 }, "",
+                           [&gpu](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            referencePixelationCentre(bgr, expected, 10);
+            gpu.pixelationShader->setPixelSize(10.0f);
+            renderGpu(gpu, gpu.pixelationShader, bgr, actual);
+        } });
+        // Hardware trilinear filtering of a half float table against tetrahedral interpolation
+        ColorLUT grade;
+        grade.bake(33, smoothGrade);
+        checks.push_back({ "GPU colorLUT.frag vs CPU", { 2, 1e-3, 40.0 }, "trilinear vs tetrahedral",
+                           [&gpu, grade](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            Filters::applyColorLUT(bgr, expected, grade);
+            gpu.lutShader->setLut(grade);
+            renderGpu(gpu, gpu.lutShader, bgr, actual);
+        } });
+        // Against the exact kernel the CPU blur is checked with: small sigma blurs at full resolution,
+        // large sigma on a linearly upsampled half size copy
+        checks.push_back({ "GPU gaussianBlur.frag/sigma:2 vs cv::GaussianBlur", { 2, 1e-3, 40.0 }, "8-bit intermediate pass",
+                           [&gpu](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            cv::GaussianBlur(bgr, expected, cv::Size(), 2.0, 2.0, cv::BORDER_REPLICATE);
+            uploadGpu(gpu, bgr);
+            gpu.passthroughShader->setTexture(gpu.blur->apply(gpu.texture, bgr.cols, bgr.rows, 2.0f));
+            drawGpu(gpu, gpu.passthroughShader, bgr.size(), actual);
+            gpu.passthroughShader->setTexture(gpu.texture);
+        } });
+        checks.push_back({ "GPU gaussianBlur.frag/sigma:8 vs cv::GaussianBlur", { 8, 0.02, 32.0 }, "downsampled",
+                           [&gpu](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            cv::GaussianBlur(bgr, expected, cv::Size(), 8.0, 8.0, cv::BORDER_REPLICATE);
+            uploadGpu(gpu, bgr);
+            gpu.passthroughShader->setTexture(gpu.blur->apply(gpu.texture, bgr.cols, bgr.rows, 8.0f));
+            drawGpu(gpu, gpu.passthroughShader, bgr.size(), actual);
+            gpu.passthroughShader->setTexture(gpu.texture);
+        } });
+        // The app corrects the flipped texture with the mirrored calibration, like its CPU path
+        checks.push_back({ "GPU undistort.frag vs CPU", { 4, 0.01, 32.0 }, "half float offsets",
+                           [&gpu](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            Undistortion lens;
+            syntheticLens(bgr.size(), lens);
+            lens.apply(bgr, expected);
+            lens.setFlipped(true);
+            uploadGpu(gpu, bgr);
+            gpu.passthroughShader->setTexture(gpu.undistort->apply(gpu.texture, bgr.cols, bgr.rows, lens));
+            drawGpu(gpu, gpu.passthroughShader, bgr.size(), actual);
+            gpu.passthroughShader->setTexture(gpu.texture);
+        } });
+        checks.push_back({ "GPU temporal.frag denoise vs window mean", { 1, 1e-3, 45.0 }, "",
+                           [&gpu](const cv::Mat& bgr, cv::Mat& expected, cv::Mat& actual) {
+            vector<cv::Mat> sequence = noisySequence(bgr, 12);
+            vector<cv::Mat> window(sequence.end() - gpu.history->getLength(), sequence.end());
+            referenceWindowMean(window, expected);
+            gpu.history->reset();
+            cv::Mat flipped;
+            for (const cv::Mat& frame : sequence) {
+                cv::flip(frame, flipped, 0);
+                gpu.history->push(flipped.data, flipped.cols, flipped.rows, (int)flipped.step, 3);
+            }
+            drawGpu(gpu, gpu.temporalShader, bgr.size(), actual);
+        } });
+    }
+
+    // --- Run ---
+    bool anyFailed = false;
+    printf("%-48s %7s %9s %12s %-6s %s\n", "Kernel", "MaxAbs", "PSNR", "Mismatch", "Result", "Worst frame");
+    for (const Check& check : checks) {
+        KernelResult result;
+        result.name = check.name;
+        result.tolerance = check.tolerance;
+        result.note = check.note;
+        result.maxAbs = 0;
+        result.minPSNR = 1.0e9;
+        result.mismatches = 0;
+        result.pixels = 0;
+        result.worstRatio = 0.0;
+        result.failed = false;
+        for (const Frame& frame : corpus) {
+            cv::Mat expected, actual;
+            check.run(frame.bgr, expected, actual);
+            long before = result.mismatches;
+            compare(expected, actual, frame.name, result);
+            if (verbose)
+                printf("    %-44s %s: %ld mismatching pixels\n", check.name.c_str(), frame.name.c_str(), result.mismatches - before);
+        }
+        finish(result);
+        anyFailed = anyFailed || result.failed;
+
+        char psnr[32];
+        if (result.maxAbs == 0)
+            snprintf(psnr, sizeof(psnr), "exact");
+        else
+            snprintf(psnr, sizeof(psnr), "%.2f", result.minPSNR);
+        printf("%-48s %7d %9s %11.5f%% %-6s %s%s%s\n", result.name.c_str(), result.maxAbs, psnr,
+               result.pixels > 0 ? 100.0 * result.mismatches / result.pixels : 0.0, result.failed ? "FAIL" : "ok",
+               result.mismatches > 0 ? result.worstFrame.c_str() : "-",
+               result.note.empty() ? "" : "  (", result.note.empty() ? "" : (result.note + ")").c_str());
+    }
+
+    if (gpuMode)
+        releaseGpu(gpu);
+
+    if (anyFailed) {
+        cout << "Validation FAILED" << endl;
+        return 1;
+    }
+    cout << "All kernels within tolerance" << endl;
+    return 0;
+}
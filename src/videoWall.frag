@@ -0,0 +1,42 @@
+#version 330 core
+in vec2 UV;
+flat in int layer;
+out vec4 FragColor;
+
+struct Tile {
+    mat4 transform;
+    vec4 params;        // x: filter mode (0 = passthrough, 1 = Sin City, 2 = pixelation), y: pixel size
+};
+layout (std140) uniform TileBlock {
+    Tile tiles[16];
+};
+
+uniform sampler2DArray videoArraySampler;
+
+vec4 sinCity(vec3 color) {
+    float gray = dot(color, vec3(0.299, 0.587, 0.114));
+    float redStrength = color.r - max(color.g, color.b);
+    bool isRed = redStrength > 0.2 && color.r > 0.3;
+
+    gray = clamp((gray - 0.5) * 1.5 + 0.5, 0.0, 1.0);
+    gray = step(0.5, gray);
+
+    if (isRed)
+        return vec4(color.r * 1.2, color.g * 0.3, color.b * 0.3, 1.0);
+    return vec4(gray, gray, gray, 1.0);
+}
+
+void main() {
+    int filterMode = int(tiles[layer].params.x);
+
+    // Layers are uploaded unflipped, the first row is the top of the image
+    vec2 uv = vec2(UV.x, 1.0 - UV.y);
+
+    if (filterMode == 2) {
+        vec2 pixelBlock = vec2(tiles[layer].params.y) / vec2(textureSize(videoArraySampler, 0).xy);
+        uv = floor(uv / pixelBlock) * pixelBlock + pixelBlock * 0.5;
+    }
+
+    vec3 color = texture(videoArraySampler, vec3(uv, float(layer))).rgb;
+    FragColor = filterMode == 1 ? sinCity(color) : vec4(color, 1.0);
+}
@@ -0,0 +1,21 @@
+#version 330 core
+layout (location = 0) in vec3 vertexPosition_modelspace;
+
+out vec2 UV;
+flat out int layer;
+
+struct Tile {
+    mat4 transform;     // unit quad -> wall space
+    vec4 params;        // x: filter mode, y: pixel size
+};
+layout (std140) uniform TileBlock {
+    Tile tiles[16];     // VIDEOWALL_MAX_TILES
+};
+
+uniform mat4 MVP;       // places the whole wall
+
+void main() {
+    gl_Position = MVP * tiles[gl_InstanceID].transform * vec4(vertexPosition_modelspace, 1.0);
+    UV = vertexPosition_modelspace.xy * 0.5 + 0.5;
+    layer = gl_InstanceID;
+}
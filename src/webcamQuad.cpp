@@ -3,9 +3,15 @@
 #include <string>
 #include <iostream>
 #include <chrono>
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <algorithm>
 
-#include <glad/gl.h>
+// Expand the glad loader implementation exactly once, later includes only see the declarations
 #define GLAD_GL_IMPLEMENTATION
+#include <glad/gl.h>
+#undef GLAD_GL_IMPLEMENTATION
 
 #include <GLFW/glfw3.h>
 GLFWwindow* window;
@@ -19,24 +25,92 @@ using namespace glm;
 #include <common/Shader.hpp>
 #include <common/Camera.hpp>
 #include <common/Scene.hpp>
+#include <common/InstancedTextureShader.hpp>
 #include <common/Object.hpp>
 #include <common/TextureShader.hpp>
 #include <common/Quad.hpp>
+#include <common/Mesh.hpp>
 #include <common/Texture.hpp>
+#include <common/TextureStreamer.hpp>
 #include <common/Filters.hpp>
 #include <common/Transformation.hpp>
 #include <common/PixelationShader.hpp>
+#include <common/BC1Encoder.hpp>
+#include <common/YuvTexture.hpp>
+#include <common/YuvShader.hpp>
+#include <common/FrameSource.hpp>
+#include <common/OpenCVFrameSource.hpp>
+#include <common/MjpegFrameSource.hpp>
+#include <common/CaptureThread.hpp>
+#include <common/VideoWall.hpp>
+#include <common/VideoWallShader.hpp>
+#include <common/TileChangeDetector.hpp>
+#include <common/WarpEngine.hpp>
+#include <common/FrameFormat.hpp>
+#include <common/BackendSelector.hpp>
+#include <common/GpuTimer.hpp>
+#include <common/GpuBlur.hpp>
+#include <common/Undistortion.hpp>
+#include <common/GpuUndistort.hpp>
+#include <common/ColorLUT.hpp>
+#include <common/LutShader.hpp>
+#include <common/FrameHistory.hpp>
+#include <common/TemporalShader.hpp>
+#include <common/TemporalFilter.hpp>
+#include <common/FrameRecorder.hpp>
+#include <common/AsyncReadback.hpp>
+#include <common/RawFrameWriter.hpp>
+#include <common/RawFrameReplayer.hpp>
+#ifdef VC_HAVE_V4L2
+#include <common/V4L2FrameSource.hpp>
+#endif
+#ifdef VC_HAVE_SHM
+#include <common/SharedFrameRing.hpp>
+#endif
 
 using namespace std;
 
 // Enums for filter and processing mode selection
-enum class FilterType { NONE, SINCITY, PIXELATION };
+enum class FilterType { NONE, SINCITY, PIXELATION, BLUR, LUT, TEMPORAL };
 enum class ProcessingMode { GPU, CPU };
+// Layout of frames captured with CAP_PROP_CONVERT_RGB disabled
+enum class RawFormat { BGR, YUYV, NV12, MJPEG, UNKNOWN };
+
+// Frame timed for the backend selector, completed once its GPU timer query is available
+struct BackendSample {
+    std::string workload;
+    BackendSelector::Backend backend;
+    double cpuMs;
+};
 
 // Global state variables
 FilterType currentFilter = FilterType::NONE;
 ProcessingMode currentMode = ProcessingMode::GPU;
+bool autoBackend = false;   // currentMode is picked per frame by the BackendSelector
 int pixelSize = 10;
+float blurSigma = 8.0f;     // Gaussian blur standard deviation in pixels
+bool gradeAvailable = false; // a .cube colour grade was loaded with --lut
+bool sinCityLUT = false;    // Sin City through a baked 3D table instead of the per pixel math
+TemporalFilter::Mode temporalMode = TemporalFilter::DENOISE;
+int historyLength = 8;      // frames the temporal filters look back
+
+// BC1 streaming: compress frames on the CPU and upload the compressed blocks
+bool bc1Streaming = false;
+
+// CPU mode: only filter, warp and upload the tiles that changed since the previous frame
+bool incrementalCPU = false;
+
+// Lens correction before filtering, available when a calibration was given with --calib
+bool undistortAvailable = false;
+bool undistortEnabled = false;
+
+// Recording of the window contents, toggled with V and started / stopped by the render loop
+bool recordRequested = false;
+// Raw recording of the camera input for replay with --replay, toggled with X
+bool rawRecordRequested = false;
+
+// Set by the input callbacks, tells the event-driven loop that the output must be redrawn
+bool paramsChanged = true;
 
 // Track current shader to avoid unnecessary changes
 Shader* currentShader = nullptr;
@@ -67,31 +141,182 @@ bool initWindow(std::string windowName);
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
 void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
+void windowRefreshCallback(GLFWwindow* window);
 void printControls();
+RawFormat classifyRawFrame(const cv::Mat& raw, int width, int height, cv::Mat& planes);
+bool rawToBGR(const cv::Mat& raw, RawFormat format, cv::Mat& bgr);
+int runVideoWall(const std::string& cameraList);
 
 /* ------------------------------------------------------------------------- */
 /* main                                                                      */
 /* ------------------------------------------------------------------------- */
-int main(void) {
-    // --- Step 1: Open camera (OpenCV part) -----------
-    cv::VideoCapture cap(0);
-    if (!cap.isOpened()) {
+int main(int argc, char** argv) {
+    // --- Command line options ---
+    std::string meshFile;       // optional .vcmesh used as video surface instead of the quad
+    std::string backgroundFile; // optional .bmp/.dds drawn behind the video, loaded in the background
+    bool yuvCapture = false;    // keep the camera's native YUV and convert in the shader
+    std::string v4l2Device;     // capture through native V4L2 mmap streaming instead of OpenCV
+    int mjpegThreads = -1;      // >= 0: request MJPEG and decode on this many threads (0 = all cores)
+    int decodeScale = 1;        // MJPEG decode scale divisor (1, 2 or 4)
+    std::string cameraList;     // comma separated camera indices / video files shown as a video wall
+    bool eventDriven = false;   // only redraw when a frame arrived or a parameter changed
+    float tileTolerance = 2.0f; // change of a tile cell mean (0-255) ignored as sensor noise
+    bool bgraFrames = false;    // convert to aligned BGRA at ingest, filters and uploads use 32-bit pixels
+    std::string calibrationFile; // camera intrinsics and distortion coefficients for lens correction
+    std::string lutFile;        // .cube colour grade selectable as filter 5
+    std::string recordFile = "recording.avi"; // written while recording (key V)
+    bool recordBlocking = false; // recording waits for the encoder instead of dropping frames
+    std::string rawRecordBase = "capture"; // raw input recording (key X) goes to capture.000.vcraw, ...
+    bool rawCompress = false;   // LZ4 compress raw recordings
+    std::string replayPath;     // replay a raw recording instead of opening the camera
+    std::string sharedName;     // publish the window contents to other processes through this shared memory ring
+    int tileCount = 0;          // thumbnails of the video laid over the bottom of the view, drawn instanced
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--mesh" && i + 1 < argc) {
+            meshFile = argv[++i];
+        } else if (arg == "--background" && i + 1 < argc) {
+            backgroundFile = argv[++i];
+        } else if (arg == "--yuv") {
+            yuvCapture = true;
+        } else if (arg == "--v4l2" && i + 1 < argc) {
+            v4l2Device = argv[++i];
+        } else if (arg == "--mjpeg" && i + 1 < argc) {
+            mjpegThreads = atoi(argv[++i]);
+        } else if (arg == "--decode-scale" && i + 1 < argc) {
+            decodeScale = atoi(argv[++i]);
+        } else if (arg == "--cameras" && i + 1 < argc) {
+            cameraList = argv[++i];
+        } else if (arg == "--event-driven") {
+            eventDriven = true;
+        } else if (arg == "--tile-tolerance" && i + 1 < argc) {
+            tileTolerance = (float)atof(argv[++i]);
+        } else if (arg == "--bgra") {
+            bgraFrames = true;
+        } else if (arg == "--calib" && i + 1 < argc) {
+            calibrationFile = argv[++i];
+        } else if (arg == "--lut" && i + 1 < argc) {
+            lutFile = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordFile = argv[++i];
+        } else if (arg == "--record-block") {
+            recordBlocking = true;
+        } else if (arg == "--raw-record" && i + 1 < argc) {
+            rawRecordBase = argv[++i];
+        } else if (arg == "--raw-lz4") {
+            rawCompress = true;
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--shm" && i + 1 < argc) {
+            sharedName = argv[++i];
+        } else if (arg == "--tiles" && i + 1 < argc) {
+            tileCount = std::max(0, atoi(argv[++i]));
+        } else {
+            cerr << "Usage: " << argv[0] << " [--mesh surface.vcmesh] [--background image.bmp|dds] [--yuv]"
+                 << " [--v4l2 /dev/videoN] [--mjpeg threads] [--decode-scale 1|2|4] [--cameras 0,1,...]"
+                 << " [--event-driven] [--tile-tolerance levels] [--bgra] [--calib camera.yml]"
+                 << " [--lut grade.cube] [--record out.avi|mp4|mkv] [--record-block]"
+                 << " [--raw-record base] [--raw-lz4] [--replay base|base.000.vcraw] [--shm name] [--tiles N]" << endl;
+            return -1;
+        }
+    }
+
+    // Calibration is scaled to whatever resolution the camera delivers, maps are built on first use
+    Undistortion undistortion;
+    if (!calibrationFile.empty()) {
+        if (!undistortion.load(calibrationFile)) {
+            cerr << "Error: couldn't load calibration " << calibrationFile << ". Exiting." << endl;
+            return -1;
+        }
+        undistortion.setFlipped(true); // frames are processed bottom row first
+        undistortAvailable = true;
+        undistortEnabled = true;
+        cout << "Lens correction enabled from " << calibrationFile << endl;
+    }
+
+    // Colour grade for filter 5, and the Sin City math baked into a table for comparison
+    ColorLUT gradeTable;
+    if (!lutFile.empty()) {
+        if (!gradeTable.load(lutFile)) {
+            cerr << "Error: couldn't load colour grade " << lutFile << ". Exiting." << endl;
+            return -1;
+        }
+        gradeAvailable = true;
+        cout << "Colour grade: " << gradeTable.getTitle() << " (" << gradeTable.getSize() << "^3)" << endl;
+    }
+    ColorLUT sinCityTable = ColorLUT::sinCity();
+
+    // Several sources run their own render loop, composited into one instanced draw
+    if (!cameraList.empty())
+        return runVideoWall(cameraList);
+
+    // --- Step 1: Open camera -----------
+    FrameSource* source = nullptr;
+    bool rawCapture = yuvCapture;   // frames may arrive in a native layout, see classifyRawFrame()
+    bool mjpegCapture = mjpegThreads >= 0;
+    // High frame rates at 1080p and above are only offered as MJPEG
+    int requestWidth = mjpegCapture ? 1920 : 1280;
+    int requestHeight = mjpegCapture ? 1080 : 720;
+    if (!replayPath.empty()) {
+        // Recorded input at full speed, frames come straight from the mapped segments
+        RawFrameReplayer* replay = new RawFrameReplayer(replayPath);
+        cout << "Replaying " << replayPath << " (" << replay->getFrameCount() << " frames)" << endl;
+        source = replay;
+        mjpegCapture = false;
+    }
+#ifdef VC_HAVE_V4L2
+    if (source == nullptr && !v4l2Device.empty()) {
+        // Driver buffers are wrapped without copies and handed back after upload
+        unsigned int pixelFormat = mjpegCapture ? (unsigned int)cv::VideoWriter::fourcc('M', 'J', 'P', 'G') : 0;
+        source = new V4L2FrameSource(v4l2Device, requestWidth, requestHeight, 60, 4, pixelFormat);
+        rawCapture = true;
+    }
+#else
+    if (!v4l2Device.empty())
+        cerr << "V4L2 capture is only available on Linux, using OpenCV capture" << endl;
+#endif
+    if (source == nullptr) {
+        OpenCVFrameSource* cvSource = new OpenCVFrameSource(0);
+        cv::VideoCapture& cap = cvSource->getCapture();
+
+        // Optional: Set camera resolution for testing different resolutions
+        if (mjpegCapture)
+            cap.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'));
+        cap.set(cv::CAP_PROP_FPS, 60);
+        cap.set(cv::CAP_PROP_FRAME_WIDTH, requestWidth);
+        cap.set(cv::CAP_PROP_FRAME_HEIGHT, requestHeight);
+        std::cout << "Camera default: " << cap.get(cv::CAP_PROP_FRAME_WIDTH) << "x"
+                  << cap.get(cv::CAP_PROP_FRAME_HEIGHT) << " @ " << cap.get(cv::CAP_PROP_FPS) << " fps" << std::endl;
+
+        // Ask the backend for the driver's native buffers instead of converted BGR
+        if (yuvCapture) {
+            if (!cap.set(cv::CAP_PROP_CONVERT_RGB, 0))
+                cout << "Camera backend ignores CAP_PROP_CONVERT_RGB, frames will arrive as BGR" << endl;
+        }
+        // Hand out the JPEG bitstream instead of decoding inside read()
+        if (mjpegCapture) {
+            if (!cap.set(cv::CAP_PROP_FORMAT, -1))
+                cout << "Camera backend ignores CAP_PROP_FORMAT -1, frames will arrive decoded" << endl;
+        }
+        source = cvSource;
+    }
+    MjpegFrameSource* mjpegSource = nullptr;
+    if (mjpegCapture && source->isOpened()) {
+        // Decoding moves off the render thread, the pool delivers BGR frames
+        mjpegSource = new MjpegFrameSource(source, mjpegThreads, decodeScale);
+        source = mjpegSource;
+        rawCapture = false;
+    }
+    if (!source->isOpened()) {
         cerr << "Error: Could not open camera. Exiting." << endl;
+        delete source;
         return -1;
     }
     cout << "Camera opened successfully." << endl;
 
-    // Optional: Set camera resolution for testing different resolutions
-    cap.set(cv::CAP_PROP_FPS, 60);
-    cap.set(cv::CAP_PROP_FRAME_WIDTH, 1280);
-    cap.set(cv::CAP_PROP_FRAME_HEIGHT, 720);
-
-    double width = cap.get(cv::CAP_PROP_FRAME_WIDTH);
-    double height = cap.get(cv::CAP_PROP_FRAME_HEIGHT);
-    double fps = cap.get(cv::CAP_PROP_FPS);
-
-    std::cout << "Camera default: " << width << "x" << height 
-            << " @ " << fps << " fps" << std::endl;
+    int captureWidth = source->getWidth();
+    int captureHeight = source->getHeight();
+    cv::Mat rawFrame;
 
     // --- Step 2: Initialize OpenGL context (GLFW & GLAD) ---
     if (!initWindow("Real-time Video Processing - Assignment 2")) return -1;
@@ -99,7 +324,7 @@ int main(void) {
     int version = gladLoadGL(glfwGetProcAddress);
     if (version == 0) {
         fprintf(stderr, "Failed to initialize OpenGL context (GLAD)\n");
-        cap.release();
+        source->release();
         return -1;
     }
     cout << "Loaded OpenGL " << GLAD_VERSION_MAJOR(version) << "." << GLAD_VERSION_MINOR(version) << "\n";
@@ -109,6 +334,7 @@ int main(void) {
     glfwSetKeyCallback(window, keyCallback);
     glfwSetMouseButtonCallback(window, mouseButtonCallback);
     glfwSetScrollCallback(window, scrollCallback);
+    glfwSetWindowRefreshCallback(window, windowRefreshCallback);
     glClearColor(0.1f, 0.1f, 0.2f, 0.0f); // A dark blue background
     glEnable(GL_DEPTH_TEST);
 
@@ -119,11 +345,24 @@ int main(void) {
     // --- Step 3: Prepare Scene, Shaders, and Objects ---------------------
     
     // Get one frame from the camera to determine its size.
+    // The capture is kept as read, frames derived from it are written to separate buffers
     cv::Mat frame;
-    cap >> frame;
+    cv::Mat capturedFrame;
+    cv::Mat convertedFrame;
+    cv::Mat flippedFrame;
+    if (rawCapture) {
+        source->read(rawFrame);
+        cv::Mat rawPlanes;
+        RawFormat rawFormat = classifyRawFrame(rawFrame, captureWidth, captureHeight, rawPlanes);
+        rawToBGR(rawPlanes, rawFormat, convertedFrame);
+        frame = convertedFrame;
+    } else {
+        source->read(capturedFrame);
+        frame = capturedFrame;
+    }
     if (frame.empty()) {
         cerr << "Error: couldn't capture an initial frame from camera. Exiting.\n";
-        cap.release();
+        source->release();
         glfwTerminate();
         return -1;
     }
@@ -131,25 +370,49 @@ int main(void) {
     cout << "Captured initial frame: " << frame.cols << "x" << frame.rows << endl;
 
     // Create multiple shaders for different GPU filters
-    TextureShader* passthroughShader = new TextureShader("videoTextureShader.vert", "videoTextureShader.frag");
-    TextureShader* sinCityShader = new TextureShader("videoTextureShader.vert", "sinCity.frag");
-    PixelationShader* pixelationShader = new PixelationShader("videoTextureShader.vert", "pixelation.frag");
+    // Meshes carry their own UVs, the quad derives them from the vertex position
+    std::string vertexShaderName = meshFile.empty() ? "videoTextureShader.vert" : "meshTexture.vert";
+    TextureShader* passthroughShader = new TextureShader(vertexShaderName, "videoTextureShader.frag");
+    TextureShader* sinCityShader = new TextureShader(vertexShaderName, "sinCity.frag");
+    PixelationShader* pixelationShader = new PixelationShader(vertexShaderName, "pixelation.frag");
+    YuvShader* yuvShader = nullptr;
+    YuvTexture* yuvTexture = nullptr;
+    if (rawCapture) {
+        yuvShader = new YuvShader(vertexShaderName, "yuvVideo.frag");
+        yuvTexture = new YuvTexture();
+        yuvShader->setTexture(yuvTexture);
+    }
     
     // Create scene and camera
     Scene* myScene = new Scene();
     Camera* renderingCamera = new Camera();
     renderingCamera->setPosition(glm::vec3(0, 0, -2.5)); // Move camera back to see the quad
 
-    // Calculate aspect ratio and create a quad with the correct dimensions.
-    float videoAspectRatio = (float)frame.cols / (float)frame.rows;
-    Quad* myQuad = new Quad(videoAspectRatio);
-    myQuad->setShader(passthroughShader); // Set initial shader (don't change after this!)
-    myScene->addObject(myQuad);
+    // Calculate aspect ratio and create a quad with the correct dimensions,
+    // or use the supplied mesh as the surface the video is drawn on.
+    Object* videoSurface = nullptr;
+    if (!meshFile.empty()) {
+        Mesh* myMesh = new Mesh();
+        if (!myMesh->loadMeshFile(meshFile)) {
+            cerr << "Error: couldn't load mesh " << meshFile << ". Exiting.\n";
+            delete myMesh;
+            source->release();
+            glfwTerminate();
+            return -1;
+        }
+        videoSurface = myMesh;
+    } else {
+        float videoAspectRatio = (float)frame.cols / (float)frame.rows;
+        videoSurface = new Quad(videoAspectRatio);
+    }
+    // The surface is drawn with whichever filter shader is selected, all of them are owned here
+    videoSurface->setSharedShader(passthroughShader);
+    myScene->addObject(videoSurface);
     
     // Create OpenGL texture for video frames
     Texture* videoTexture = nullptr;
-    cv::flip(frame, frame, 0); // Flip for OpenGL coordinate system
-    videoTexture = new Texture(frame.data, frame.cols, frame.rows, true);
+    cv::flip(frame, flippedFrame, 0); // Flip for OpenGL coordinate system
+    videoTexture = new Texture(flippedFrame.data, flippedFrame.cols, flippedFrame.rows, true);
     
     cout << "Created video texture" << endl;  
     
@@ -158,14 +421,145 @@ int main(void) {
     sinCityShader->setTexture(videoTexture);
     pixelationShader->setTexture(videoTexture);
     pixelationShader->setPixelSize((float)pixelSize);
+
+    // 3D table lookups: the loaded grade and the baked Sin City table
+    LutShader* gradeShader = new LutShader(vertexShaderName, "colorLUT.frag");
+    gradeShader->setTexture(videoTexture);
+    gradeShader->setLut(gradeTable);
+    LutShader* sinCityLutShader = new LutShader(vertexShaderName, "colorLUT.frag");
+    sinCityLutShader->setTexture(videoTexture);
+    sinCityLutShader->setLut(sinCityTable);
+
+    // GPU blur renders into its own targets, the surface then shows the blurred texture
+    GpuBlur* gpuBlur = new GpuBlur();
+    TextureShader* blurDisplayShader = new TextureShader(vertexShaderName, "videoTextureShader.frag");
+    // GPU lens correction renders the corrected frame, the filter shaders then sample it
+    GpuUndistort* gpuUndistort = undistortAvailable ? new GpuUndistort() : nullptr;
+    Texture* filterSource = videoTexture;   // texture the filter shaders currently sample
+    // Temporal filters: GPU mode uploads frames into a ring of texture array layers instead of videoTexture
+    FrameHistory* frameHistory = new FrameHistory(historyLength);
+    TemporalShader* temporalShader = new TemporalShader(vertexShaderName, "temporal.frag");
+    temporalShader->setHistory(frameHistory);
+
+    // Thumbnail tiles share one quad and one instanced shader, the scene draws them with a single call
+    InstancedTextureShader* tileShader = nullptr;
+    if (tileCount > 0) {
+        tileShader = new InstancedTextureShader("videoTextureShader.frag");
+        tileShader->setTexture(videoTexture);
+        const int tileColumns = 16;
+        const float tileScale = 1.0f / tileColumns;
+        const float tileAspect = (float)frame.cols / (float)frame.rows;
+        for (int i = 0; i < tileCount; i++) {
+            Quad* tile = new Quad(tileAspect);
+            tile->setSharedShader(tileShader);
+            tile->setScale(tileScale);
+            // Rows fill upwards from the bottom edge of the video, slightly in front of it
+            tile->setTranslate(glm::vec3(-tileAspect + (2 * (i % tileColumns) + 1) * tileAspect * tileScale,
+                                         -1.0f + (2 * (i / tileColumns) + 1) * tileScale, -0.01f));
+            myScene->addObject(tile);
+        }
+    }
     cout << "Shaders configured successfully" << endl;
 
+    // Background image is streamed in by a worker thread so startup is not blocked by file I/O
+    TextureStreamer* textureStreamer = new TextureStreamer(window);
+    TextureShader* backgroundShader = nullptr;
+    Scene* backgroundScene = new Scene();
+    Texture* backgroundTexture = nullptr;
+    int backgroundRequest = -1;
+    if (!backgroundFile.empty()) {
+        backgroundShader = new TextureShader("videoTextureShader.vert", "videoTextureShader.frag");
+        Quad* backgroundQuad = new Quad(1.777f); // same aspect as the UV mapping in videoTextureShader.vert
+        backgroundQuad->setScale(2.0f);    // fill the view behind the video
+        backgroundQuad->setSharedShader(backgroundShader);
+        backgroundScene->addObject(backgroundQuad);
+        backgroundRequest = textureStreamer->requestTexture(backgroundFile);
+    }
+
+    // Event-driven mode reads on a capture thread so the loop can sleep until a frame arrives
+    CaptureThread* captureThread = nullptr;
+    if (eventDriven) {
+        // The retained frame may point into a driver buffer, keep a copy to redraw from
+        rawFrame = rawFrame.clone();
+        capturedFrame = capturedFrame.clone();
+        source->releaseFrame();
+        captureThread = new CaptureThread(source); // takes ownership, main only reads stats below
+        captureThread->setFrameCallback([]() { glfwPostEmptyEvent(); });
+        cout << "Event-driven rendering: unchanged frames are skipped" << endl;
+    }
+    // Display refreshes that passed without a new image while the loop slept (event-driven mode)
+    int skippedFrames = 0;
+    const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    const double refreshInterval = 1.0 / (videoMode != nullptr && videoMode->refreshRate > 0 ? videoMode->refreshRate : 60);
+    auto lastPresentTime = std::chrono::steady_clock::now();
+
     // Initialize FPS tracking
     lastFPSTime = std::chrono::steady_clock::now();
     
     // Buffers for CPU-processed frames
     cv::Mat processedFrame;
     cv::Mat transformedFrame;
+    cv::Mat undistortedFrame;
+    TemporalFilter temporalFilter;  // running averages for the CPU temporal modes
+    WarpEngine warpEngine;      // remap tables, only rebuilt when the transform or visible region changes
+
+    // Incremental CPU mode: the buffers above are only patched where tiles changed, so they
+    // stay valid only while nothing else wrote the texture and the parameters are unchanged
+    TileChangeDetector changeDetector(32, tileTolerance);
+    std::vector<cv::Rect> visibleRegions;
+    std::vector<cv::Rect> warpedRegions;
+    bool incrementalValid = false;
+    FilterType incrementalFilter = currentFilter;
+    int incrementalPixelSize = pixelSize;
+    bool incrementalSinCityLUT = sinCityLUT;
+    glm::vec4 incrementalTransform(translateX, translateY, rotateZ, scaleFactor);
+    double dirtyFraction = 0.0;
+    int dirtyCount = 0;
+
+    // Auto backend: measured frame costs per workload, persisted per host and renderer
+    BackendSelector backendSelector;
+    std::string backendProfile = BackendSelector::hostProfilePath();
+    backendSelector.load(backendProfile);
+    std::string rendererName = (const char*)glGetString(GL_RENDERER);
+    for (char& c : rendererName)
+        if (c == ' ' || c == '\t') c = '_';
+    GpuTimer* gpuTimer = new GpuTimer(4);
+    std::deque<BackendSample> pendingSamples;
+    int timedFrames = 0;
+
+    // BC1 streaming buffers and per-second statistics
+    std::vector<unsigned char> bc1Data;
+    cv::Mat bc1Decoded;
+    cv::Mat bc1Reference;
+    double encodeTimeMs = 0.0;
+    double uploadTimeMs = 0.0;
+    int uploadCount = 0;
+    double latencyMs = 0.0;     // capture timestamp -> texture upload, for sources that provide timestamps
+    int latencyCount = 0;
+    double bc1PSNR = 0.0;
+    bool measurePSNR = true;
+
+    // Recording: the window is read back through pixel pack buffers and encoded on another thread
+    FrameRecorder recorder(8, recordBlocking ? FrameRecorder::BLOCK : FrameRecorder::DROP);
+    AsyncReadback* readback = nullptr;
+    RawFrameWriter rawWriter;
+
+    // Shared memory output: the same readbacks are published for local consumers (e.g. VC_2_shm_consumer)
+#ifdef VC_HAVE_SHM
+    SharedFrameRing sharedRing;
+    bool sharedRingRejected = false;   // a frame did not fit, reported once
+    if (!sharedName.empty()) {
+        // At least a 4K frame, more if the framebuffer already is larger (HiDPI)
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        size_t capacity = std::max((size_t)3840 * 2160 * 4, (size_t)framebufferWidth * framebufferHeight * 4);
+        if (sharedRing.create(sharedName, 4, capacity))
+            cout << "Publishing frames to shared memory " << sharedFrameObjectName(sharedName) << endl;
+    }
+#else
+    if (!sharedName.empty())
+        cerr << "Shared memory output is only available on Linux" << endl;
+#endif
 
     // Print control instructions
     printControls();
@@ -174,46 +568,272 @@ int main(void) {
 
     // --- Step 4: Main Render Loop ---------------------
     while (!glfwWindowShouldClose(window)) {  
-        // Clear the screen
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
         // Check for ESC key press
         if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
             glfwSetWindowShouldClose(window, true);
 
-        // --- Capture and process new frame ---
-        cap >> frame;
-        if (!frame.empty() && videoTexture != nullptr) {
-            cv::flip(frame, frame, 0); // Flip for OpenGL coordinate system
+        // --- Pick up streamed textures once their upload fence has signalled ---
+        textureStreamer->update();
+        if (backgroundRequest >= 0) {
+            TextureStreamer::State state = textureStreamer->getState(backgroundRequest);
+            if (state == TextureStreamer::State::READY) {
+                backgroundTexture = textureStreamer->takeTexture(backgroundRequest);
+                backgroundShader->setTexture(backgroundTexture);
+                backgroundRequest = -1;
+                paramsChanged = true;
+                cout << "Background loaded: " << backgroundFile << endl;
+            } else if (state == TextureStreamer::State::FAILED) {
+                cerr << "Could not load background " << backgroundFile << endl;
+                backgroundRequest = -1;
+            }
+        }
+
+        // --- Capture new frame ---
+        bool frameArrived;
+        if (captureThread != nullptr) {
+            // Non-blocking, the previous capture is kept when nothing new arrived
+            frameArrived = captureThread->fetch(rawCapture ? rawFrame : capturedFrame);
+        } else {
+            frameArrived = source->read(rawCapture ? rawFrame : capturedFrame);
+            if (!frameArrived) {
+                rawFrame.release();
+                capturedFrame.release();
+            }
+        }
+
+        // Nothing on screen would change: skip upload, draw and swap until an event or frame wakes us
+        if (eventDriven && !frameArrived && !paramsChanged) {
+            glfwWaitEventsTimeout(0.1); // bounded so streamed textures are still picked up
+            continue;
+        }
+        paramsChanged = false;
+        if (eventDriven) {
+            // Every refresh since the last swap but the one this frame replaces showed an old image
+            double refreshes = std::chrono::duration<double>(std::chrono::steady_clock::now() - lastPresentTime).count() / refreshInterval;
+            if (refreshes >= 1.5)
+                skippedFrames += (int)(refreshes + 0.5) - 1;
+        }
+
+        // Clear the screen
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        if (backgroundTexture != nullptr) {
+            // Drawn without depth writes so the video always ends up in front
+            glDepthMask(GL_FALSE);
+            backgroundScene->render(renderingCamera);
+            glDepthMask(GL_TRUE);
+        }
+
+        // --- Auto backend: pick CPU or GPU for this workload and time the frame ---
+        std::string workload;
+        bool frameTimed = false;
+        auto processStart = std::chrono::steady_clock::now();
+        if (autoBackend) {
+            std::ostringstream key;
+            key << rendererName << "/" << (int)currentFilter << "/" << captureWidth << "x" << captureHeight
+                << (translateX != originalX || translateY != originalY || rotateZ != originalZ ||
+                    scaleFactor != originalScale ? "/warp" : "")
+                << (bc1Streaming ? "/bc1" : "") << (bgraFrames ? "/bgra" : "") << (rawCapture ? "/raw" : "")
+                << (undistortEnabled ? "/lens" : "") << (sinCityLUT ? "/lut" : "")
+                << (currentFilter == FilterType::TEMPORAL ? "/" + to_string((int)temporalMode) : "");
+            workload = key.str();
+            currentMode = backendSelector.choose(workload) == BackendSelector::CPU ? ProcessingMode::CPU
+                                                                                   : ProcessingMode::GPU;
+            frameTimed = gpuTimer->begin(timedFrames++);
+        }
+
+        // --- Raw recording starts and stops between frames ---
+        if (rawRecordRequested && !rawWriter.isOpen()) {
+            rawWriter.open(rawRecordBase, rawCompress);
+            cout << "Recording raw input to " << rawFrameSegmentPath(rawRecordBase, 0) << endl;
+        } else if (!rawRecordRequested && rawWriter.isOpen()) {
+            rawWriter.close();  // writes what is queued and the segment index
+            cout << "Raw recording stopped: " << rawWriter.getStatistics().written << " frames written" << endl;
+        }
+        if (rawWriter.hasFailed())
+            rawRecordRequested = false;
+
+        // --- Process the captured frame ---
+        // The histories only stay meaningful while every new frame goes into them
+        bool temporalGpu = currentMode == ProcessingMode::GPU && currentFilter == FilterType::TEMPORAL;
+        if (!temporalGpu)
+            frameHistory->reset();
+        if (currentMode != ProcessingMode::CPU || currentFilter != FilterType::TEMPORAL)
+            temporalFilter.reset();
+        bool yuvUploaded = false;
+        if (rawCapture) {
+            cv::Mat rawPlanes;
+            RawFormat rawFormat = classifyRawFrame(rawFrame, captureWidth, captureHeight, rawPlanes);
+            if ((rawFormat == RawFormat::YUYV || rawFormat == RawFormat::NV12) &&
+                currentMode == ProcessingMode::GPU && !bc1Streaming && currentFilter != FilterType::BLUR &&
+                currentFilter != FilterType::LUT && !temporalGpu && !undistortEnabled) {
+                // Native planes go straight to the GPU, conversion, flip and filter run in yuvVideo.frag
+                auto uploadStart = std::chrono::steady_clock::now();
+                yuvTexture->update(rawPlanes.data, captureWidth, captureHeight, (int)rawPlanes.step,
+                                   rawFormat == RawFormat::NV12 ? YuvTexture::NV12 : YuvTexture::YUYV);
+                uploadTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+                uploadCount++;
+                yuvUploaded = true;
+                incrementalValid = false;
+            } else if (rawToBGR(rawPlanes, rawFormat, convertedFrame)) {
+                frame = convertedFrame;
+            } else {
+                frame.release();
+            }
+        } else {
+            frame = capturedFrame;
+        }
+        // Raw recording keeps each new frame exactly as it enters processing (before the flip);
+        // frames uploaded as native YUV are never converted and so are not recorded
+        if (rawWriter.isOpen() && frameArrived && !yuvUploaded && !frame.empty())
+            rawWriter.write(frame, captureThread != nullptr ? captureThread->getTimestamp() : source->getTimestamp());
+        if (yuvUploaded) {
+            // Nothing left to do on the CPU for this frame
+        } else if (!frame.empty() && videoTexture != nullptr) {
+            // Out of place, the capture stays untouched so it can be redrawn when parameters change
+            if (bgraFrames && frame.type() == CV_8UC3)
+                FrameFormat::bgrToBGRA(frame, flippedFrame, true); // conversion and flip in one pass
+            else
+                cv::flip(frame, flippedFrame, 0); // Flip for OpenGL coordinate system
+            frame = flippedFrame;
             
+            // CPU transform parameters, translateX/Y are in normalized space (-1 to 1 roughly)
+            // so they are scaled to pixel space
+            bool transformed = translateX != originalX || translateY != originalY ||
+                               rotateZ != originalZ || scaleFactor != originalScale;
+            float txPixels = translateX * frame.cols / 2.0f;
+            float tyPixels = -translateY * frame.rows / 2.0f;  // Invert Y for OpenCV
+
+            // Per pixel filters commute with the lens correction, so it can ride along in the warp's
+            // remap tables; the filter then runs on the distorted frame and the frame costs one gather
+            bool fuseLens = currentMode == ProcessingMode::CPU && undistortEnabled && transformed &&
+                            (currentFilter == FilterType::NONE || currentFilter == FilterType::SINCITY ||
+                             currentFilter == FilterType::LUT || currentFilter == FilterType::TEMPORAL);
+
+            // Only the part of the frame that the warp maps on screen needs filtering,
+            // snapped to pixelation blocks so the visible blocks match a full frame pass
+            // (temporal filters keep their history for the whole frame, the view may move)
+            cv::Rect visibleRect(0, 0, frame.cols, frame.rows);
+            if (currentMode == ProcessingMode::CPU && transformed && !fuseLens &&
+                currentFilter != FilterType::TEMPORAL) {
+                visibleRect = Transformation::visibleSourceRect(frame.size(), txPixels, tyPixels, rotateZ, scaleFactor,
+                                                                currentFilter == FilterType::PIXELATION ? pixelSize : 1);
+                if (currentFilter == FilterType::BLUR) {
+                    // Visible pixels near the edge are blurred with neighbours from outside the rectangle
+                    int margin = Filters::gaussianBlurExtent(blurSigma);
+                    visibleRect = cv::Rect(visibleRect.x - margin, visibleRect.y - margin,
+                                           visibleRect.width + 2 * margin, visibleRect.height + 2 * margin) &
+                                  cv::Rect(0, 0, frame.cols, frame.rows);
+                }
+            }
+
+            // Incremental CPU mode works out which tiles changed before any processing
+            // (not for blur, its output tiles depend on pixels outside them, nor for lens correction;
+            // temporal filters change every pixel while their averages settle)
+            bool incremental = currentMode == ProcessingMode::CPU && incrementalCPU && !bc1Streaming &&
+                               currentFilter != FilterType::BLUR && currentFilter != FilterType::TEMPORAL &&
+                               !undistortEnabled;
+            bool incrementalReset = false;  // buffers are rebuilt, the texture gets a full upload
+            const std::vector<cv::Rect>* changedRegions = nullptr;
+            if (incremental) {
+                // Tiles are whole pixelation blocks, so a partial pass gives the same blocks as a full one
+                changeDetector.setTileSize(pixelSize * std::max(1, 32 / pixelSize));
+                glm::vec4 transform(translateX, translateY, rotateZ, scaleFactor);
+                incrementalReset = !incrementalValid || currentFilter != incrementalFilter ||
+                                   pixelSize != incrementalPixelSize || transform != incrementalTransform ||
+                                   sinCityLUT != incrementalSinCityLUT;
+                if (incrementalReset)
+                    changeDetector.invalidate();
+                incrementalFilter = currentFilter;
+                incrementalPixelSize = pixelSize;
+                incrementalSinCityLUT = sinCityLUT;
+                incrementalTransform = transform;
+                changedRegions = &changeDetector.detect(frame);
+                dirtyFraction += changeDetector.getDirtyFraction();
+                dirtyCount++;
+
+                // Changes off screen are skipped, the detector is reset whenever the view moves
+                visibleRegions.clear();
+                for (const cv::Rect& region : *changedRegions) {
+                    cv::Rect clipped = region & visibleRect;
+                    if (!clipped.empty())
+                        visibleRegions.push_back(clipped);
+                }
+                changedRegions = &visibleRegions;
+            }
+
             // Apply CPU processing if in CPU mode
             if (currentMode == ProcessingMode::CPU) {
-                // Step 1: Apply filter on CPU
+                // Step 1: Apply filter on CPU (incremental: changed tiles, otherwise the visible part)
+                cv::Mat visibleFrame = frame(visibleRect);
+                if (undistortEnabled && !fuseLens) {
+                    // Only the visible rectangle of the corrected frame is gathered
+                    undistortion.apply(frame, undistortedFrame, visibleRect);
+                    visibleFrame = undistortedFrame;
+                }
                 switch (currentFilter) {
                     case FilterType::SINCITY:
-                        Filters::applySinCity(frame, processedFrame);
+                        if (sinCityLUT && incremental)
+                            Filters::applyColorLUT(frame, processedFrame, *changedRegions, sinCityTable);
+                        else if (sinCityLUT)
+                            Filters::applyColorLUT(visibleFrame, processedFrame, sinCityTable);
+                        else if (incremental)
+                            Filters::applySinCity(frame, processedFrame, *changedRegions);
+                        else
+                            Filters::applySinCity(visibleFrame, processedFrame);
+                        break;
+                    case FilterType::LUT:
+                        if (incremental)
+                            Filters::applyColorLUT(frame, processedFrame, *changedRegions, gradeTable);
+                        else
+                            Filters::applyColorLUT(visibleFrame, processedFrame, gradeTable);
                         break;
                     case FilterType::PIXELATION:
-                        Filters::applyPixelation(frame, processedFrame, pixelSize);
+                        if (incremental)
+                            Filters::applyPixelation(frame, processedFrame, *changedRegions, pixelSize);
+                        else
+                            Filters::applyPixelation(visibleFrame, processedFrame, pixelSize);
+                        break;
+                    case FilterType::BLUR:
+                        Filters::applyGaussianBlur(visibleFrame, processedFrame, blurSigma);
+                        break;
+                    case FilterType::TEMPORAL:
+                        // Only new frames go into the average, like FrameHistory on the GPU;
+                        // otherwise processedFrame still holds the last result
+                        temporalFilter.setHistoryLength(historyLength);
+                        if (frameArrived || !temporalFilter.hasHistory())
+                            temporalFilter.apply(visibleFrame, processedFrame, temporalMode);
                         break;
                     case FilterType::NONE:
                     default:
-                        processedFrame = frame.clone();
+                        if (incremental) {
+                            processedFrame.create(frame.size(), frame.type());
+                            for (const cv::Rect& region : *changedRegions)
+                                frame(region).copyTo(processedFrame(region));
+                        } else {
+                            processedFrame = visibleFrame.clone();
+                        }
                         break;
                 }
                 
                 // Step 2: Apply geometric transformation on CPU
-                // Convert translation from normalized coordinates to pixels
-                // translateX/Y are in normalized space (-1 to 1 roughly), 
-                // so we scale them to pixel space
-                if (translateX != originalX || translateY != originalY ||
-                    rotateZ != originalZ || scaleFactor != originalScale) {
-                    float txPixels = translateX * frame.cols / 2.0f;
-                    float tyPixels = -translateY * frame.rows / 2.0f;  // Invert Y for OpenCV
-                    
-                    Transformation::applyCombinedTransform(processedFrame, transformedFrame,
-                                                        txPixels, tyPixels, 
-                                                        rotateZ, scaleFactor);
+                if (transformed) {
+                    if (incremental) {
+                        // Changed tiles move with the warp, upload where they land
+                        if (incrementalReset)
+                            transformedFrame = cv::Mat::zeros(frame.size(), frame.type()); // border stays black
+                        Transformation::applyCombinedTransform(processedFrame, transformedFrame,
+                                                               *changedRegions, warpedRegions,
+                                                               txPixels, tyPixels, rotateZ, scaleFactor);
+                        changedRegions = &warpedRegions;
+                    } else {
+                        // processedFrame only holds the visible rectangle
+                        cv::Mat transformMat = Transformation::buildTransformMatrix(txPixels, tyPixels, rotateZ, scaleFactor,
+                                                                                    frame.cols / 2.0f, frame.rows / 2.0f);
+                        warpEngine.setAffine(transformMat, frame.size(), visibleRect.tl());
+                        warpEngine.setLens(fuseLens ? &undistortion : nullptr, frame.size());
+                        warpEngine.apply(processedFrame, transformedFrame);
+                    }
                     frame = transformedFrame;
                 } else {
                     frame = processedFrame;
@@ -221,24 +841,115 @@ int main(void) {
             }
             
             // Update GPU texture with (potentially processed) frame
-            videoTexture->update(frame.data, frame.cols, frame.rows, true);
+            if (temporalGpu) {
+                // Lens correction runs before the history, the shader then reads corrected frames
+                if (undistortEnabled) {
+                    undistortion.apply(frame, undistortedFrame);
+                    frame = undistortedFrame;
+                }
+                // One layer upload, the older frames stay where they are
+                auto uploadStart = std::chrono::steady_clock::now();
+                frameHistory->setLength(historyLength);
+                if (frameArrived || frameHistory->getCount() == 0)
+                    frameHistory->push(frame.data, frame.cols, frame.rows, (int)frame.step, frame.channels());
+                uploadTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+            } else if (bc1Streaming) {
+                auto encodeStart = std::chrono::steady_clock::now();
+                BC1Encoder::encode(frame, bc1Data);
+                auto encodeEnd = std::chrono::steady_clock::now();
+                videoTexture->updateCompressed(bc1Data.data(), frame.cols, frame.rows,
+                                               GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, (GLsizei)bc1Data.size());
+                auto uploadEnd = std::chrono::steady_clock::now();
+                encodeTimeMs += std::chrono::duration<double, std::milli>(encodeEnd - encodeStart).count();
+                uploadTimeMs += std::chrono::duration<double, std::milli>(uploadEnd - encodeEnd).count();
+
+                // Quality is sampled on one frame per status line, decoding every frame would cost too much
+                if (measurePSNR) {
+                    BC1Encoder::decode(bc1Data, frame.cols, frame.rows, bc1Decoded);
+                    if (frame.channels() == 4) {
+                        // The decoder returns BGR, compare colour only
+                        cv::cvtColor(frame, bc1Reference, cv::COLOR_BGRA2BGR);
+                        bc1PSNR = cv::PSNR(bc1Reference, bc1Decoded);
+                    } else {
+                        bc1PSNR = cv::PSNR(frame, bc1Decoded);
+                    }
+                    measurePSNR = false;
+                }
+            } else if (incremental && !incrementalReset) {
+                // Only the changed sub-rectangles, straight out of the frame rows
+                auto uploadStart = std::chrono::steady_clock::now();
+                for (const cv::Rect& region : *changedRegions)
+                    videoTexture->updateRegion(frame.data, (int)frame.step, region.x, region.y,
+                                               region.width, region.height, true);
+                uploadTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+            } else {
+                auto uploadStart = std::chrono::steady_clock::now();
+                if (frame.channels() == 4)
+                    videoTexture->updateBGRA(frame.data, frame.cols, frame.rows, (int)frame.step);
+                else
+                    videoTexture->update(frame.data, frame.cols, frame.rows, true);
+                uploadTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+            }
+            uploadCount++;
+            incrementalValid = incremental;
         } else {
             cout << "[LOOP] Frame empty or texture null!" << endl;
         }
 
+        // The frame is on the GPU now, hand the capture buffer back to the driver
+        double captureTime = captureThread != nullptr ? captureThread->getTimestamp() : source->getTimestamp();
+        if (frameArrived && captureTime >= 0.0) {
+            double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            latencyMs += (now - captureTime) * 1000.0;
+            latencyCount++;
+        }
+        if (captureThread == nullptr)
+            source->releaseFrame();
+
         // --- Select and manually bind the appropriate shader ---
+
+        // GPU lens correction: one gather pass into a render target that the filters sample instead
+        Texture* gpuSource = videoTexture;
+        if (currentMode == ProcessingMode::GPU && undistortEnabled && !yuvUploaded && !temporalGpu && !frame.empty())
+            gpuSource = gpuUndistort->apply(videoTexture, frame.cols, frame.rows, undistortion);
+        if (gpuSource != filterSource) {
+            passthroughShader->setTexture(gpuSource);
+            sinCityShader->setTexture(gpuSource);
+            pixelationShader->setTexture(gpuSource);
+            gradeShader->setTexture(gpuSource);
+            sinCityLutShader->setTexture(gpuSource);
+            filterSource = gpuSource;
+        }
         
         if (currentMode == ProcessingMode::GPU) {
             // GPU mode: use appropriate shader for filtering
             // Transformations are handled by OpenGL matrices below
             switch (currentFilter) {
                 case FilterType::SINCITY:
-                    currentShader = sinCityShader;
+                    currentShader = sinCityLUT ? sinCityLutShader : sinCityShader;
+                    break;
+                case FilterType::LUT:
+                    currentShader = gradeShader;
                     break;
                 case FilterType::PIXELATION:
                     pixelationShader->setPixelSize((float)pixelSize);
                     currentShader = pixelationShader;
                     break;
+                case FilterType::BLUR:
+                    // Two separable passes (on a downsampled copy for large sigma) into offscreen targets
+                    if (!frame.empty()) {
+                        blurDisplayShader->setTexture(gpuBlur->apply(gpuSource, frame.cols, frame.rows, blurSigma));
+                        currentShader = blurDisplayShader;
+                    } else {
+                        currentShader = passthroughShader;
+                    }
+                    break;
+                case FilterType::TEMPORAL:
+                    temporalShader->setMode(temporalMode == TemporalFilter::MOTION ? TemporalShader::MOTION :
+                                            temporalMode == TemporalFilter::TRAILS ? TemporalShader::TRAILS :
+                                            TemporalShader::DENOISE);
+                    currentShader = temporalShader;
+                    break;
                 case FilterType::NONE:
                 default:
                     currentShader = passthroughShader;
@@ -246,38 +957,31 @@ int main(void) {
             }
             
             // Apply GPU transformations via OpenGL matrices
-            if (translateX != originalX || translateY != originalY ||
-                rotateZ != originalZ || scaleFactor != originalScale) {
-                // Reset to identity before applying new transforms
-                myQuad->setTranslate(glm::vec3(0.0f, 0.0f, 0.0f));
-                myQuad->setRotate(0.0f);
-                myQuad->setScale(1.0f);
-
-                myQuad->setTranslate(glm::vec3(translateX, translateY, 0.0f));
-                myQuad->setRotate(rotateZ);  // Now rotates around Z-axis (in-plane)
-                myQuad->setScale(scaleFactor);
+            // (setters are no-ops while nothing changes, the matrix is recomposed lazily)
+            videoSurface->setTranslate(glm::vec3(translateX, translateY, 0.0f));
+            videoSurface->setRotate(rotateZ);  // Now rotates around Z-axis (in-plane)
+            videoSurface->setScale(scaleFactor);
+            if (yuvUploaded) {
+                yuvShader->setFilterMode(currentFilter == FilterType::SINCITY ? YuvShader::SINCITY :
+                                         currentFilter == FilterType::PIXELATION ? YuvShader::PIXELATION :
+                                         YuvShader::PASSTHROUGH);
+                yuvShader->setPixelSize((float)pixelSize);
+                currentShader = yuvShader;
             }
         } else {
             // CPU mode: transformations already applied above
             // Use passthrough shader and reset transformations to identity
             currentShader = passthroughShader;
-            myQuad->setTranslate(glm::vec3(0.0f, 0.0f, 0.0f));
-            myQuad->setRotate(0.0f);
-            myQuad->setScale(1.0f);
+            videoSurface->setTranslate(glm::vec3(0.0f, 0.0f, 0.0f));
+            videoSurface->setRotate(0.0f);
+            videoSurface->setScale(1.0f);
         }
 
         // --- Render with the selected shader ---
         try {
-            // Manually bind the shader we want to use
-            currentShader->bind();
-            
-            // Update matrices
-            glm::mat4 ModelMatrix = myQuad->getTransform();
-            glm::mat4 MVP = renderingCamera->getViewProjectionMatrix() * ModelMatrix;
-            currentShader->updateMVP(MVP);
-            
-            // Render the quad directly (bypassing its internal shader)
-            myQuad->directRender();
+            // The scene's render queue binds each shader once and batches the tiles
+            videoSurface->setSharedShader(currentShader);
+            myScene->render(renderingCamera);
             
         } catch (const std::exception& e) {
             break;
@@ -295,33 +999,340 @@ int main(void) {
             
             // Print current status
             string mode = (currentMode == ProcessingMode::GPU) ? "GPU" : "CPU";
+            if (autoBackend) mode = "Auto (" + mode + ")";
             string filter = "None";
-            if (currentFilter == FilterType::SINCITY) filter = "Sin City";
+            if (currentFilter == FilterType::SINCITY) filter = sinCityLUT ? "Sin City (LUT)" : "Sin City";
             else if (currentFilter == FilterType::PIXELATION) filter = "Pixelation (size: " + to_string(pixelSize) + ")";
+            else if (currentFilter == FilterType::BLUR) filter = "Blur (sigma: " + to_string((int)blurSigma) + ")";
+            else if (currentFilter == FilterType::LUT) filter = "LUT (" + gradeTable.getTitle() + ")";
+            else if (currentFilter == FilterType::TEMPORAL)
+                filter = string(temporalMode == TemporalFilter::MOTION ? "Motion" :
+                                temporalMode == TemporalFilter::TRAILS ? "Trails" : "Denoise") +
+                         " (" + to_string(historyLength) + " frames)";
             
-            cout << "FPS: " << fps << " | Mode: " << mode << " | Filter: " << filter << endl;
+            cout << "FPS: " << fps << " | Mode: " << mode << " | Filter: " << filter;
+            if (uploadCount > 0) {
+                cout << " | Upload: " << uploadTimeMs / uploadCount << " ms";
+                if (bc1Streaming)
+                    cout << " | BC1 encode: " << encodeTimeMs / uploadCount << " ms, PSNR: " << bc1PSNR << " dB";
+            }
+            if (latencyCount > 0)
+                cout << " | Latency: " << latencyMs / latencyCount << " ms";
+            if (mjpegSource != nullptr)
+                cout << " | Decode: " << mjpegSource->takeAverageDecodeMs() << " ms, dropped: "
+                     << mjpegSource->getDroppedCount();
+            if (eventDriven)
+                cout << " | Skipped refreshes: " << skippedFrames;
+            if (dirtyCount > 0)
+                cout << " | Dirty tiles: " << (int)(100.0 * dirtyFraction / dirtyCount) << "%";
+            if (undistortEnabled)
+                cout << " | Lens maps built: " << undistortion.getRebuildCount();
+            if (tileCount > 0)
+                cout << " | Draw calls: " << myScene->getDrawCallCount();
+            if (rawWriter.isOpen()) {
+                RawFrameWriter::Statistics raw = rawWriter.getStatistics();
+                cout << " | Raw: " << raw.written << " frames, " << (int)raw.megabytes << " MB, queue: "
+                     << raw.queueDepth << ", dropped: " << raw.dropped;
+            }
+            if (recorder.isRecording()) {
+                FrameRecorder::Statistics recording = recorder.getStatistics();
+                cout << " | Rec: " << recording.written << " frames, queue: " << recording.queueDepth
+                     << ", encode: " << recording.encodeMs << " ms, dropped: " << recording.dropped;
+            }
+#ifdef VC_HAVE_SHM
+            if (sharedRing.isOpen())
+                cout << " | Shm: " << sharedRing.getPublished() << " frames";
+#endif
+            cout << endl;
+            encodeTimeMs = 0.0;
+            uploadTimeMs = 0.0;
+            uploadCount = 0;
+            latencyMs = 0.0;
+            latencyCount = 0;
+            dirtyFraction = 0.0;
+            dirtyCount = 0;
+            measurePSNR = true;
+        }
+
+        // --- Recording / shared memory: hand finished readbacks on, then read this frame ---
+        if (recordRequested && !recorder.isRecording()) {
+            recorder.start(recordFile, fps > 0.0f ? fps : 30.0, true);
+            cout << "Recording to " << recordFile << endl;
+        } else if (!recordRequested && recorder.isRecording()) {
+            recorder.stop();    // writes what is queued
+            cout << "Recording stopped: " << recorder.getStatistics().written << " frames written" << endl;
+        }
+        bool readbackNeeded = recorder.isRecording();
+#ifdef VC_HAVE_SHM
+        readbackNeeded = readbackNeeded || sharedRing.isOpen();
+#endif
+        if (readbackNeeded && readback == nullptr) {
+            readback = new AsyncReadback(3);
+        } else if (!readbackNeeded && readback != nullptr) {
+            delete readback;    // readbacks still in flight are discarded
+            readback = nullptr;
+        }
+        if (readback != nullptr) {
+            const unsigned char* pixels;
+            int readWidth, readHeight;
+            while (readback->map(pixels, readWidth, readHeight)) {
+                if (recorder.isRecording())
+                    recorder.push(cv::Mat(readHeight, readWidth, CV_8UC4, (void*)pixels));
+#ifdef VC_HAVE_SHM
+                // Copied once into the ring straight from the mapped buffer, consumers read it in place
+                if (sharedRing.isOpen() &&
+                    !sharedRing.publish(pixels, readWidth, readHeight, CV_8UC4, readWidth * 4,
+                                        std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(),
+                                        SHAREDFRAME_BOTTOM_UP) &&
+                    !sharedRingRejected) {
+                    cerr << "Shared memory: " << readWidth << "x" << readHeight
+                         << " frames exceed the ring capacity and are not published" << endl;
+                    sharedRingRejected = true;
+                }
+#endif
+                readback->unmap();
+            }
+            if (recorder.hasFailed())
+                recordRequested = false;
+            int framebufferWidth, framebufferHeight;
+            glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+            readback->request(framebufferWidth, framebufferHeight);
+        }
+
+        // Frame cost = CPU time for processing, submission and readback + GPU time for upload, draw and readback
+        if (frameTimed) {
+            gpuTimer->end();
+            BackendSample sample;
+            sample.workload = workload;
+            sample.backend = currentMode == ProcessingMode::CPU ? BackendSelector::CPU : BackendSelector::GPU;
+            sample.cpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - processStart).count();
+            pendingSamples.push_back(sample);
+        }
+        int timerTag;
+        double gpuMs;
+        while (gpuTimer->poll(timerTag, gpuMs) && !pendingSamples.empty()) {
+            const BackendSample& sample = pendingSamples.front();
+            backendSelector.report(sample.workload, sample.backend, sample.cpuMs + gpuMs);
+            pendingSamples.pop_front();
         }
 
         // Swap buffers and poll events
         glfwSwapBuffers(window);
+        lastPresentTime = std::chrono::steady_clock::now();
         glfwPollEvents();
     }
 
     // --- Cleanup -----------------------------------------------------------
     cout << "Closing application..." << endl;
-    cap.release();
+    delete readback;
+    recorder.stop();
+    rawWriter.close();
+    backendSelector.save(backendProfile);
+    delete gpuTimer;
+    if (captureThread != nullptr) {
+        delete captureThread; // stops the thread and releases the source
+    } else {
+        source->release();
+        delete source;
+    }
     delete myScene;
     delete renderingCamera;
     delete passthroughShader;
     delete sinCityShader;
     delete pixelationShader;
+    delete blurDisplayShader;
+    delete gradeShader;
+    delete sinCityLutShader;
+    delete gpuBlur;
+    delete gpuUndistort;
+    delete temporalShader;
+    delete frameHistory;
+    delete yuvShader;
+    delete yuvTexture;
     delete videoTexture;
+    delete tileShader;
+    delete backgroundScene;
+    delete backgroundShader;
+    delete backgroundTexture;
+    delete textureStreamer;
+
+    glDeleteVertexArrays(1, &VertexArrayID);
+    glfwTerminate();
+    return 0;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Video wall: N sources, one capture thread each, one instanced draw        */
+/* ------------------------------------------------------------------------- */
+int runVideoWall(const std::string& cameraList) {
+    // Entries are camera indices or video files / stream URLs
+    std::vector<CaptureThread*> captures;
+    int tileWidth = 0;
+    int tileHeight = 0;
+    std::stringstream entries(cameraList);
+    std::string entry;
+    while (std::getline(entries, entry, ',')) {
+        if ((int)captures.size() == VIDEOWALL_MAX_TILES) {
+            cerr << "Video wall is limited to " << VIDEOWALL_MAX_TILES << " sources, ignoring the rest" << endl;
+            break;
+        }
+        OpenCVFrameSource* source;
+        if (!entry.empty() && entry.find_first_not_of("0123456789") == std::string::npos) {
+            source = new OpenCVFrameSource(atoi(entry.c_str()));
+            source->getCapture().set(cv::CAP_PROP_FPS, 30);
+            source->getCapture().set(cv::CAP_PROP_FRAME_WIDTH, 1280);
+            source->getCapture().set(cv::CAP_PROP_FRAME_HEIGHT, 720);
+        } else {
+            source = new OpenCVFrameSource(entry);
+        }
+        if (!source->isOpened()) {
+            cerr << "Could not open camera " << entry << ", skipping" << endl;
+            delete source;
+            continue;
+        }
+        // The first source sets the tile size, the others are resized on their own capture thread
+        if (captures.empty()) {
+            tileWidth = source->getWidth();
+            tileHeight = source->getHeight();
+        }
+        cout << "Opened camera " << entry << " (" << source->getWidth() << "x" << source->getHeight() << ")" << endl;
+        captures.push_back(new CaptureThread(source, tileWidth, tileHeight));
+    }
+    if (captures.empty() || tileWidth <= 0 || tileHeight <= 0) {
+        cerr << "Error: no camera of the video wall could be opened. Exiting." << endl;
+        for (CaptureThread* capture : captures)
+            delete capture;
+        return -1;
+    }
+
+    if (!initWindow("Real-time Video Processing - Video Wall")) return -1;
+    int version = gladLoadGL(glfwGetProcAddress);
+    if (version == 0) {
+        fprintf(stderr, "Failed to initialize OpenGL context (GLAD)\n");
+        for (CaptureThread* capture : captures)
+            delete capture;
+        return -1;
+    }
+    glfwSetInputMode(window, GLFW_STICKY_KEYS, GL_TRUE);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+    glClearColor(0.1f, 0.1f, 0.2f, 0.0f);
+    glEnable(GL_DEPTH_TEST);
+
+    GLuint VertexArrayID;
+    glGenVertexArrays(1, &VertexArrayID);
+    glBindVertexArray(VertexArrayID);
+
+    Camera* renderingCamera = new Camera();
+    renderingCamera->setPosition(glm::vec3(0, 0, -2.5));
+    VideoWall* wall = new VideoWall(tileWidth, tileHeight, (int)captures.size());
+    wall->setShader(new VideoWallShader("videoWall.vert", "videoWall.frag"));
+
+    // Filters run in the wall shader, CPU mode and BC1 streaming do not apply here
+    cout << "Video wall with " << captures.size() << " tiles of " << tileWidth << "x" << tileHeight << endl;
+    printControls();
+
+    cv::Mat frame;
+    double uploadTimeMs = 0.0;
+    int uploadCount = 0;
+    lastFPSTime = std::chrono::steady_clock::now();
+
+    while (!glfwWindowShouldClose(window)) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+            glfwSetWindowShouldClose(window, true);
+
+        // Upload whatever arrived since the last frame, cameras that have nothing new keep their layer
+        auto uploadStart = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < captures.size(); i++) {
+            if (captures[i]->fetch(frame)) {
+                wall->updateTile((int)i, frame.data);
+                uploadCount++;
+            }
+        }
+        uploadTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+
+        int filterMode = currentFilter == FilterType::SINCITY ? VideoWallShader::SINCITY :
+                         currentFilter == FilterType::PIXELATION ? VideoWallShader::PIXELATION :
+                         VideoWallShader::PASSTHROUGH;
+        for (int i = 0; i < wall->getTileCount(); i++)
+            wall->setTileFilter(i, filterMode, (float)pixelSize);
+        wall->setTranslate(glm::vec3(translateX, translateY, 0.0f));
+        wall->setRotate(rotateZ);
+        wall->setScale(scaleFactor);
+
+        wall->render(renderingCamera);
+
+        frameCount++;
+        auto currentTime = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastFPSTime).count();
+        if (elapsed >= 1000) {
+            fps = frameCount / (elapsed / 1000.0f);
+            cout << "FPS: " << fps << " | Tiles: " << captures.size()
+                 << " | Camera frames/s: " << uploadCount / (elapsed / 1000.0f);
+            if (uploadCount > 0)
+                cout << " | Upload: " << uploadTimeMs / uploadCount << " ms/frame";
+            cout << endl;
+            frameCount = 0;
+            uploadTimeMs = 0.0;
+            uploadCount = 0;
+            lastFPSTime = currentTime;
+        }
 
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+
+    cout << "Closing application..." << endl;
+    for (CaptureThread* capture : captures)
+        delete capture;
+    delete wall;
+    delete renderingCamera;
     glDeleteVertexArrays(1, &VertexArrayID);
     glfwTerminate();
     return 0;
 }
 
+/* ------------------------------------------------------------------------- */
+/* Helper: identify the layout of a frame captured without RGB conversion    */
+/* ------------------------------------------------------------------------- */
+RawFormat classifyRawFrame(const cv::Mat& raw, int width, int height, cv::Mat& planes) {
+    planes = raw;
+    if (raw.empty()) return RawFormat::UNKNOWN;
+    if (raw.type() == CV_8UC3) return RawFormat::BGR;   // backend converted anyway
+    // Sources that know the layout (V4L2, replay) deliver shaped planes, possibly with padded rows
+    if (raw.type() == CV_8UC2 && raw.cols == width && raw.rows == height) return RawFormat::YUYV;
+    if (raw.type() == CV_8UC1 && raw.cols == width && raw.rows == height * 3 / 2) return RawFormat::NV12;
+    if (raw.depth() != CV_8U || !raw.isContinuous()) return RawFormat::UNKNOWN;
+    // OpenCV's V4L backend hands out every unconverted format as one 1xN byte buffer,
+    // so packed and planar YUV are told apart from a bitstream by their exact size
+    size_t bytes = raw.total() * raw.elemSize();
+    if (bytes == (size_t)width * height * 2) {
+        planes = raw.reshape(2, height);
+        return RawFormat::YUYV;
+    }
+    if (bytes == (size_t)width * height * 3 / 2) {
+        planes = raw.reshape(1, height * 3 / 2);
+        return RawFormat::NV12;
+    }
+    if (raw.rows == 1) return RawFormat::MJPEG; // compressed bitstream
+    return RawFormat::UNKNOWN;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Helper: convert a raw frame to BGR for the CPU path                       */
+/* ------------------------------------------------------------------------- */
+bool rawToBGR(const cv::Mat& raw, RawFormat format, cv::Mat& bgr) {
+    switch (format) {
+        case RawFormat::BGR:   bgr = raw; return true;
+        case RawFormat::YUYV:  cv::cvtColor(raw, bgr, cv::COLOR_YUV2BGR_YUYV); return true;
+        case RawFormat::NV12:  cv::cvtColor(raw, bgr, cv::COLOR_YUV2BGR_NV12); return true;
+        case RawFormat::MJPEG: bgr = cv::imdecode(raw, cv::IMREAD_COLOR); return !bgr.empty();
+        default:               return false;
+    }
+}
+
 /* ------------------------------------------------------------------------- */
 /* Helper: initWindow (GLFW)                                                 */
 /* ------------------------------------------------------------------------- */
@@ -350,6 +1361,7 @@ bool initWindow(std::string windowName){
 /* ------------------------------------------------------------------------- */
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
     if (action != GLFW_PRESS) return;
+    paramsChanged = true;
     
     switch (key) {
         case GLFW_KEY_1:
@@ -364,14 +1376,70 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
             currentFilter = FilterType::PIXELATION;
             cout << "\n>>> Filter: Pixelation" << endl;
             break;
+        case GLFW_KEY_4:
+            currentFilter = FilterType::BLUR;
+            cout << "\n>>> Filter: Gaussian blur" << endl;
+            break;
+        case GLFW_KEY_5:
+            if (!gradeAvailable) {
+                cout << "\n>>> Colour grade needs a table (--lut grade.cube)" << endl;
+                break;
+            }
+            currentFilter = FilterType::LUT;
+            cout << "\n>>> Filter: Colour grade (3D LUT)" << endl;
+            break;
+        case GLFW_KEY_6:
+            currentFilter = FilterType::TEMPORAL;
+            cout << "\n>>> Filter: Temporal" << endl;
+            break;
+        case GLFW_KEY_T:
+            temporalMode = temporalMode == TemporalFilter::DENOISE ? TemporalFilter::MOTION :
+                           temporalMode == TemporalFilter::MOTION ? TemporalFilter::TRAILS : TemporalFilter::DENOISE;
+            cout << "\n>>> Temporal mode: " << (temporalMode == TemporalFilter::DENOISE ? "Denoise" :
+                                               temporalMode == TemporalFilter::MOTION ? "Motion" : "Trails") << endl;
+            break;
+        case GLFW_KEY_L:
+            sinCityLUT = !sinCityLUT;
+            cout << "\n>>> Sin City through baked 3D LUT: " << (sinCityLUT ? "ON" : "OFF") << endl;
+            break;
         case GLFW_KEY_G:
             currentMode = ProcessingMode::GPU;
+            autoBackend = false;
             cout << "\n>>> Mode: GPU Processing" << endl;
             break;
         case GLFW_KEY_C:
             currentMode = ProcessingMode::CPU;
+            autoBackend = false;
             cout << "\n>>> Mode: CPU Processing" << endl;
             break;
+        case GLFW_KEY_A:
+            autoBackend = true;
+            cout << "\n>>> Mode: Auto (measured CPU/GPU selection)" << endl;
+            break;
+        case GLFW_KEY_B:
+            bc1Streaming = !bc1Streaming;
+            cout << "\n>>> BC1 streaming: " << (bc1Streaming ? "ON" : "OFF") << endl;
+            break;
+        case GLFW_KEY_I:
+            incrementalCPU = !incrementalCPU;
+            cout << "\n>>> Incremental CPU processing: " << (incrementalCPU ? "ON" : "OFF") << endl;
+            break;
+        case GLFW_KEY_U:
+            if (!undistortAvailable) {
+                cout << "\n>>> Lens correction needs a calibration (--calib camera.yml)" << endl;
+                break;
+            }
+            undistortEnabled = !undistortEnabled;
+            cout << "\n>>> Lens correction: " << (undistortEnabled ? "ON" : "OFF") << endl;
+            break;
+        case GLFW_KEY_V:
+            recordRequested = !recordRequested;
+            cout << "\n>>> Recording: " << (recordRequested ? "ON" : "OFF") << endl;
+            break;
+        case GLFW_KEY_X:
+            rawRecordRequested = !rawRecordRequested;
+            cout << "\n>>> Raw input recording: " << (rawRecordRequested ? "ON" : "OFF") << endl;
+            break;
         case GLFW_KEY_R:
             // Reset transformations
             translateX = 0.0f;
@@ -380,6 +1448,36 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
             scaleFactor = 1.0f;
             cout << "\n>>> Transformations reset" << endl;
             break;
+        case GLFW_KEY_EQUAL:
+        case GLFW_KEY_KP_ADD:
+            if (currentFilter == FilterType::BLUR) {
+                blurSigma = std::min(blurSigma * 1.25f, 128.0f);
+                cout << "\n>>> Blur sigma: " << blurSigma << endl;
+                break;
+            }
+            if (currentFilter == FilterType::TEMPORAL) {
+                historyLength = std::min(historyLength + 1, 16);
+                cout << "\n>>> History length: " << historyLength << endl;
+                break;
+            }
+            if (pixelSize < 64) pixelSize++;
+            cout << "\n>>> Pixel size: " << pixelSize << endl;
+            break;
+        case GLFW_KEY_MINUS:
+        case GLFW_KEY_KP_SUBTRACT:
+            if (currentFilter == FilterType::BLUR) {
+                blurSigma = std::max(blurSigma / 1.25f, 0.5f);
+                cout << "\n>>> Blur sigma: " << blurSigma << endl;
+                break;
+            }
+            if (currentFilter == FilterType::TEMPORAL) {
+                historyLength = std::max(historyLength - 1, 2);
+                cout << "\n>>> History length: " << historyLength << endl;
+                break;
+            }
+            if (pixelSize > 2) pixelSize--;
+            cout << "\n>>> Pixel size: " << pixelSize << endl;
+            break;
         case GLFW_KEY_H:
             printControls();
             break;
@@ -420,6 +1518,12 @@ void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
         scaleFactor += static_cast<float>(yoffset) * scaleSpeed;
         if (scaleFactor < 0.1f) scaleFactor = 0.1f; // Prevent negative or too small scale
     }
+    paramsChanged = true;
+}
+
+void windowRefreshCallback(GLFWwindow* window) {
+    // Exposed or resized, the back buffer has to be redrawn
+    paramsChanged = true;
 }
 
 /* ------------------------------------------------------------------------- */
@@ -433,10 +1537,21 @@ void printControls() {
     cout << "  1       - No filter (passthrough)" << endl;
     cout << "  2       - Sin City filter" << endl;
     cout << "  3       - Pixelation filter" << endl;
-    cout << "  +/-     - Increase/decrease pixel size (when pixelation active)" << endl;
+    cout << "  4       - Gaussian blur" << endl;
+    cout << "  5       - Colour grade from a .cube 3D LUT (with --lut)" << endl;
+    cout << "  6       - Temporal filter over the last frames" << endl;
+    cout << "  T       - Cycle temporal mode (denoise, motion, trails)" << endl;
+    cout << "  L       - Toggle Sin City through a baked 3D LUT" << endl;
+    cout << "  +/-     - Increase/decrease pixel size (pixelation), blur sigma (blur) or history length (temporal)" << endl;
     cout << "\nPROCESSING MODE:" << endl;
     cout << "  G       - GPU processing (shaders + OpenGL transforms)" << endl;
     cout << "  C       - CPU processing (OpenCV filters + transforms)" << endl;
+    cout << "  A       - Auto: pick CPU or GPU per filter from measured frame times" << endl;
+    cout << "  B       - Toggle BC1 compressed frame upload" << endl;
+    cout << "  I       - Toggle incremental CPU processing (changed tiles only)" << endl;
+    cout << "  U       - Toggle lens correction (with --calib)" << endl;
+    cout << "  V       - Start/stop recording the window (--record file)" << endl;
+    cout << "  X       - Start/stop recording the raw camera input (--raw-record base)" << endl;
     cout << "\nTRANSFORMATIONS:" << endl;
     cout << "  Scroll        - Scale (zoom in/out)" << endl;
     cout << "  Left + Scroll - Translate (move around)" << endl;
@@ -0,0 +1,59 @@
+#version 330 core
+in vec2 UV;
+out vec4 FragColor;
+
+uniform sampler2D lumaSampler;   // NV12: Y plane (R8), YUYV: packed Y/U/Y/V (RG8)
+uniform sampler2D chromaSampler; // NV12: interleaved UV plane (RG8), unused for YUYV
+uniform int yuvLayout;           // 0 = NV12, 1 = YUYV
+uniform int filterMode;          // 0 = passthrough, 1 = Sin City, 2 = pixelation
+uniform float pixelSize;
+
+// BT.601 limited range YUV to RGB
+vec3 yuvToRgb(float y, float u, float v) {
+    y = 1.164 * (y - 0.0625);
+    u -= 0.5;
+    v -= 0.5;
+    return clamp(vec3(y + 1.596 * v,
+                      y - 0.391 * u - 0.813 * v,
+                      y + 2.018 * u), 0.0, 1.0);
+}
+
+vec3 sampleRgb(vec2 uv) {
+    if (yuvLayout == 1) {
+        // Each texel holds Y in R, and U (even x) or V (odd x) in G
+        ivec2 size = textureSize(lumaSampler, 0);
+        ivec2 p = clamp(ivec2(uv * vec2(size)), ivec2(0), size - 1);
+        float y = texelFetch(lumaSampler, p, 0).r;
+        float u = texelFetch(lumaSampler, ivec2(p.x & ~1, p.y), 0).g;
+        float v = texelFetch(lumaSampler, ivec2(min(p.x | 1, size.x - 1), p.y), 0).g;
+        return yuvToRgb(y, u, v);
+    }
+    vec2 uvChroma = texture(chromaSampler, uv).rg;
+    return yuvToRgb(texture(lumaSampler, uv).r, uvChroma.r, uvChroma.g);
+}
+
+vec4 sinCity(vec3 color) {
+    float gray = dot(color, vec3(0.299, 0.587, 0.114));
+    float redStrength = color.r - max(color.g, color.b);
+    bool isRed = redStrength > 0.2 && color.r > 0.3;
+
+    gray = clamp((gray - 0.5) * 1.5 + 0.5, 0.0, 1.0);
+    gray = step(0.5, gray);
+
+    if (isRed)
+        return vec4(color.r * 1.2, color.g * 0.3, color.b * 0.3, 1.0);
+    return vec4(gray, gray, gray, 1.0);
+}
+
+void main() {
+    // Raw frames are not flipped on the CPU, the first row is the top of the image
+    vec2 uv = vec2(UV.x, 1.0 - UV.y);
+
+    if (filterMode == 2) {
+        vec2 pixelBlock = vec2(pixelSize) / vec2(textureSize(lumaSampler, 0));
+        uv = floor(uv / pixelBlock) * pixelBlock + pixelBlock * 0.5;
+    }
+
+    vec3 color = sampleRgb(uv);
+    FragColor = filterMode == 1 ? sinCity(color) : vec4(color, 1.0);
+}